@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Forward declaration
+class Node;
+
+/**
+ * @brief Dynamic bounding volume hierarchy over node world bounds
+ *
+ * Leaves hold a node's bounds enlarged by a margin, so small moves only
+ * update the exact bounds stored in the leaf. A node that leaves its enlarged
+ * box is removed and reinserted, choosing the sibling by the surface area
+ * heuristic, and the tree is rebalanced with rotations on the way up. This
+ * keeps the tree height logarithmic, so point and ray queries visit
+ * O(log N) boxes for a typical scene.
+ */
+class BoundingVolumeHierarchy
+{
+public:
+    explicit BoundingVolumeHierarchy(float margin = 8.0f);
+    ~BoundingVolumeHierarchy();
+
+    // Insert a node or refit it to its new bounds
+    void Update(Node *node, const float boundsMin[3], const float boundsMax[3]);
+    void Remove(Node *node);
+    void Clear();
+
+    // Append every node whose bounds contain the point in the XY plane
+    void QueryPoint(float x, float y, std::vector<Node *> &outNodes) const;
+
+    // Closest node hit by the ray within maxDistance, or nullptr. The direction doesn't need to be normalized.
+    Node *RayCast(const float origin[3], const float direction[3], float maxDistance, float *outDistance = nullptr) const;
+
+    // Bounds enclosing every node, false if the tree is empty
+    bool GetBounds(float outMin[3], float outMax[3]) const;
+
+    bool Contains(const Node *node) const;
+    size_t GetSize() const;
+    int GetHeight() const;
+
+private:
+    struct Box
+    {
+        float min[3];
+        float max[3];
+    };
+
+    struct TreeNode
+    {
+        Box box;        // Enlarged bounds for leaves, union of the children otherwise
+        Box exact;      // Leaves only, the node's actual bounds
+        Node *node = nullptr;
+        int parent = -1;
+        int child1 = -1;
+        int child2 = -1;
+        int height = 0; // Leaves are 0, free slots -1
+        bool IsLeaf() const { return child1 < 0; }
+    };
+
+    static Box Union(const Box &a, const Box &b);
+    static float SurfaceArea(const Box &box);
+    static bool ContainsBox(const Box &outer, const Box &inner);
+    static bool RayHitsBox(const Box &box, const float origin[3], const float inverseDirection[3], float maxDistance, float &outDistance);
+
+    int AllocateNode();
+    void FreeNode(int index);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int index);
+    void RefitAncestors(int index);
+
+    float margin;
+    int root = -1;
+    std::vector<TreeNode> nodes;
+    int freeList = -1;
+    std::unordered_map<const Node *, int> leafLookup;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "NodeDocumentation.h"
+
+/**
+ * @brief Inverted index over the method documentation, for search as you type
+ *
+ * Every searchable field of every method (its node type, name, description,
+ * parameters and return value) is lowercased once into a single text
+ * buffer and indexed two ways:
+ *
+ * - words, split at punctuation and camelCase humps and also kept in
+ *   sorted order, so one and two letter terms are answered as word prefixes
+ * - trigrams, mapped to the fields containing them, so longer terms are
+ *   answered as substrings by verifying only the fields listed under the
+ *   term's rarest trigram
+ *
+ * A query is split into whitespace separated terms that must all match.
+ * Each matching field adds its weight to the method's score, doubled when
+ * the match starts a word (prefix matches, camelCase humps included, always
+ * do), and hits come back best first.
+ *
+ * Once few methods still match, the next term checks those methods' own
+ * fields instead of walking a posting list longer than them. Search as you
+ * type mostly extends the previous query, and every method matching the
+ * longer query also matched the shorter one, so Refine starts from the
+ * previous hits as the only methods still matching. Queries reuse the
+ * index's scratch and the caller's hit vector, so neither allocates once
+ * they have grown.
+ *
+ * Hits point into the compiled-in documentation tables.
+ */
+class DocumentationIndex
+{
+public:
+    struct Hit
+    {
+        const NodeDoc *node;
+        const MethodDoc *method;
+        float score;
+        uint32_t entry; // The method's position in the index, for Refine
+    };
+
+    void Build();
+    void Clear();
+
+    // Replaces outHits with the methods matching every term of the query, best first
+    void Search(std::string_view query, std::vector<Hit> &outHits);
+
+    // True if every method matching query also matched previousQuery, so its hits can be refined
+    static bool CanRefine(std::string_view previousQuery, std::string_view query);
+
+    // Replaces hits, the result of searching an earlier query CanRefine accepts, with the result of searching query
+    void Refine(std::string_view query, std::vector<Hit> &hits);
+
+    size_t GetMethodCount() const;
+    size_t GetMemoryUsage() const;
+
+private:
+    enum class FieldKind : uint8_t
+    {
+        NodeType,
+        MethodName,
+        ParamName,
+        Description,
+        ParamDescription,
+        ReturnType,
+        ReturnDescription,
+        Count
+    };
+
+    struct MethodEntry
+    {
+        const NodeDoc *node;
+        const MethodDoc *doc;
+        uint32_t firstField; // Its fields run up to the next method's first
+    };
+
+    // A lowercased field in text
+    struct FieldEntry
+    {
+        uint32_t method;
+        uint32_t offset;
+        uint32_t length;
+        uint32_t firstWord; // Its words run up to the next field's first
+        FieldKind kind;
+    };
+
+    struct WordEntry
+    {
+        uint32_t offset; // Into text
+        uint32_t length;
+        uint32_t field;
+    };
+
+    struct TrigramEntry
+    {
+        uint32_t trigram;
+        uint32_t field;
+    };
+
+    void AddField(uint32_t method, FieldKind kind, std::string_view value);
+    std::string_view GetFieldText(const FieldEntry &field) const;
+    std::string_view GetWordText(const WordEntry &word) const;
+    void RunQuery(std::string_view query, bool refine, std::vector<Hit> &outHits);
+    size_t MatchTerm(std::string_view term, uint32_t termIndex, size_t liveMethods);
+    size_t MatchLiveMethods(std::string_view term, uint32_t termIndex);
+    bool IsWordStart(const FieldEntry &field, size_t position) const;
+    bool ScoreField(uint32_t fieldIndex, size_t position, size_t termLength, uint32_t termIndex, bool wordStart);
+
+    std::vector<MethodEntry> methods;
+    std::vector<FieldEntry> fields;
+    std::vector<WordEntry> words;       // In field order
+    std::vector<uint32_t> sortedWords;  // Into words, sorted by word text
+    std::vector<TrigramEntry> trigrams; // Sorted by trigram, then field
+    std::string text;
+
+    // Per-query scratch, sized once per build
+    std::string lowerQuery;
+    std::vector<float> methodScores;
+    std::vector<uint32_t> methodTerms; // Leading query terms each method has matched
+    std::vector<uint32_t> fieldMarks;  // Fields already scored for the current term
+    uint32_t currentMark = 0;
+    std::vector<uint32_t> matchedMethods; // Every method that matched the first term
+    std::vector<uint32_t> candidates; // Methods of the hits being refined
+};
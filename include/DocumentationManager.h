@@ -1,10 +1,8 @@
 #pragma once
 
-#include <string>
 #include <vector>
-#include <map>
-#include <functional>
-#include "Node.h"
+#include "DocumentationIndex.h"
+#include "NodeDocumentation.h"
 
 /**
  * @brief Manages documentation for all node types
@@ -18,9 +16,6 @@ public:
     DocumentationManager();
     ~DocumentationManager();
 
-    // Initialize the documentation manager
-    void Init();
-
     // Show/hide the documentation popup
     void ShowDocumentation();
     void HideDocumentation();
@@ -35,38 +30,27 @@ public:
     // Check if documentation is visible
     bool IsVisible() const;
 
-    // Node documentation registration
-    static void RegisterNodeDocumentation(const std::string &nodeType, const std::vector<MethodDoc> &methods);
-    static void RegisterNodeDescription(const std::string &nodeType, const std::string &description);
-
-    // Get documentation
-    static std::map<std::string, std::vector<MethodDoc>> &GetNodeDocumentation();
-    static std::map<std::string, std::string> &GetNodeDescriptions();
-
 private:
     // Documentation state
     bool isVisible = false;
 
-    // Search functionality
-    std::string searchQuery;
-    std::vector<std::pair<std::string, MethodDoc>> searchResults;
+    // Search functionality. The query is edited in place and results point into the compiled-in
+    // documentation, so typing neither copies documentation nor allocates.
+    char searchQuery[256] = "";
+    char searchedQuery[256] = ""; // The query searchResults answer
+    std::vector<DocumentationIndex::Hit> searchResults;
+    DocumentationIndex searchIndex;
+    bool searchIndexBuilt = false;
     void UpdateSearchResults();
 
     // Rendering helpers
     void RenderNodeList();
-    void RenderMethodList(const std::string &nodeType);
-    void RenderMethodDetails(const std::string &nodeType, const std::string &methodName);
+    void RenderMethodList(const NodeDoc &node);
+    void RenderMethodDetails(const MethodDoc &method);
     void RenderSearchBar();
     void RenderSearchResults();
 
     // Current selection
-    std::string selectedNodeType;
-    std::string selectedMethod;
-
-    // Node documentation cache - now static so nodes can register themselves
-    static std::map<std::string, std::vector<MethodDoc>> nodeDocumentation;
-    static std::map<std::string, std::string> nodeDescriptions;
-
-    // Load documentation for all node types
-    void LoadDocumentation();
+    const NodeDoc *selectedNode = nullptr;
+    const MethodDoc *selectedMethod = nullptr;
 };
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include <atomic>
 #include <condition_variable>
 #include "EngineUI.h"
+#include "FontTexture.h"
+#include "FramePacer.h"
+#include "IdPickingPass.h"
 
 class Engine
 {
@@ -17,6 +20,19 @@ public:
     bool Init();
     void Run();
 
+    // Idle mode - when enabled the editor only redraws on input, scene changes,
+    // explicit redraw requests or the keep-alive timer
+    void SetIdleMode(bool enabled);
+    bool IsIdleMode() const;
+    void SetIdleKeepAlive(double seconds);
+
+    // Ask for another frame, safe to call from any thread
+    void RequestRedraw();
+
+    // Frame pacing - set before Init so the swap chain can pick a matching present mode
+    void SetFramePacing(FramePacer::Mode mode, double targetFrameRate);
+    const FramePacer &GetFramePacer() const;
+
     // Keyboard callback
     static void KeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
 
@@ -30,6 +46,11 @@ private:
     void StartThreads();
     void StopThreads();
 
+    // Idle mode
+    void InstallWakeCallbacks();
+    bool WaitForRedraw();
+    static void WakeFromWindow(GLFWwindow *window);
+
     // Vulkan setup methods
     void CreateSurface();
     void PickPhysicalDevice();
@@ -55,6 +76,17 @@ private:
     std::atomic<bool> frameReady{false};
     std::atomic<bool> frameRendered{false};
 
+    // Idle mode state
+    static constexpr int FramesAfterInput = 3; // Frames drawn after an event so ImGui can settle
+    std::atomic<bool> idleMode{true};
+    std::atomic<bool> redrawRequested{true};
+    std::atomic<int> framesToDraw{FramesAfterInput};
+    double idleKeepAlive = 0.5; // Longest time between redraws while idle, in seconds
+    double lastFrameTime = 0.0;
+
+    // Frame pacing, only touched by the main thread
+    FramePacer framePacer;
+
     // Threads
     std::thread mainThread;
     std::thread renderThread;
@@ -88,4 +120,10 @@ private:
     VkDescriptorPool imguiDescriptorPool;
     VkSemaphore imageAvailableSemaphore;
     VkSemaphore renderFinishedSemaphore;
+
+    // Offscreen node id pass for GPU picking
+    IdPickingPass idPickingPass;
+
+    // ImGui font atlas, owned here instead of by the backend so its upload doesn't stall startup
+    FontTexture fontTexture;
 };
\ No newline at end of file
@@ -3,13 +3,29 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <array>
 #include <map>
 #include <functional>
+#include <unordered_map>
 #include "imgui.h"
 #include "DocumentationManager.h"
+#include "RenderQueue.h"
+#include "SpatialGrid2D.h"
+#include "BoundingVolumeHierarchy.h"
+#include "Frustum.h"
+#include "TiledLightCuller.h"
+#include "SubtreeRenderCache.h"
+#include "IdPickGeometry.h"
+#include "SelectionSet.h"
+#include "UndoJournal.h"
+#include "Prefab.h"
+#include "WorldPartition.h"
+#include "NodeTypeRegistry.h"
+#include "NodeChangeBus.h"
 
-// Forward declaration
+// Forward declarations
 class Node;
+class PrefabInstance;
 
 class EngineUI
 {
@@ -23,6 +39,23 @@ public:
     // Render the UI
     void Render();
 
+    // Whether the last frame left work that needs another frame to show (scene edits, drags, active widgets)
+    bool NeedsRedraw() const;
+
+    // GPU picking - viewport clicks are resolved from the renderer's ID pass instead of the picking tree
+    bool IsGpuPickingEnabled() const;
+    const IdPickGeometry &GetIdPickGeometry() const;
+    bool TakeGpuPickRequest(ImVec2 &outScreenPos);
+    void ApplyGpuPickResult(uint32_t instanceId);
+
+    // Scene persistence - .json paths use the text format (TextSceneFile), anything else the binary one (SceneFile)
+    bool SaveScene(const std::string &path);
+    bool LoadScene(const std::string &path);
+
+    // Edit history
+    void Undo();
+    void Redo();
+
     // Documentation
     void HandleDocumentationKeyPress(int key, int scancode, int action, int mods);
 
@@ -40,16 +73,12 @@ private:
     ImFont *titleFont = nullptr;
     ImFont *iconFont = nullptr;
 
-    // Icon mapping
-    std::map<NodeType, const char *> nodeIcons;
-    void SetupIcons();
-    const char *GetNodeIcon(NodeType type);
+    // Node counters for unique naming, indexed by NodeType
+    std::array<int, static_cast<size_t>(NodeType::Count)> nodeCounters = {};
+    StringAtom GenerateUniqueName(NodeType type);
 
-    // Node counters for unique naming
-    std::map<NodeType, int> nodeCounters;
-    std::string GenerateUniqueName(NodeType type);
-
-    // No node type registry needed - nodes will be auto-discovered
+    // Set at the end of Render for the idle loop
+    bool needsRedraw = true;
 
     // UI state
     float leftPanelWidth = 250.0f;
@@ -94,22 +123,130 @@ private:
 
     // Scene hierarchy
     std::shared_ptr<Node> rootNode;
-    std::shared_ptr<Node> selectedNode;
+    std::string scenePath = "scene.scn"; // Used by Open Scene and Save Scene
+    std::string textScenePath = "scene.json";
+    std::shared_ptr<Node> selectedNode; // Primary selection, shown in the inspector and anchoring single-node gizmos
+
+    // Selected nodes by instance id
+    SelectionSet selection;
+    bool IsSelected(const Node *node) const;
+    void SelectNode(Node *node, bool additive);
+    void ClearSelection();
+    void SyncPrimarySelection();
+
+    // Selected nodes without a selected ancestor, the ones group transforms move
+    std::vector<Node *> selectionRoots;
+    uint32_t selectionRootsVersion = ~0u;
+    uint32_t selectionRootsHierarchyVersion = ~0u;
+    const std::vector<Node *> &GetSelectionRoots();
+
+    // Click and rectangle selection in the viewports
+    bool selectionPressPending = false;
+    ImVec2 selectionPressPos = ImVec2(0, 0);
+    std::vector<Node *> marqueeNodes;
+    void HandleViewportSelection(bool gizmoActive, bool allowMarquee, ImVec2 startPos, ImVec2 viewportSize);
+    void SelectNodesInRect(ImVec2 screenMin, ImVec2 screenMax, bool additive, ImVec2 viewportSize, ImVec2 startPos);
+
+    // Undo history - an inspector edit or gizmo drag stays one recording until the widget or mouse is released
+    UndoJournal journal;
+    UndoJournal::Recording inspectorRecording;
+    UndoJournal::Recording gizmoRecording;
+    bool IsEditingInCurrentWindow() const;
+    bool IsActivatingInCurrentWindow() const;
+
     void InitializeSceneHierarchy();
-    void RenderSceneNode(std::shared_ptr<Node> node);
+    void RenderSceneNode(Node *node, int depth);
+
+    // Expanded hierarchy flattened into rows, rebuilt only when the tree or an expansion changes
+    struct HierarchyRow
+    {
+        Node *node;
+        int depth;
+    };
+    std::vector<HierarchyRow> hierarchyRows;
+    uint32_t hierarchyRowsVersion = 0;
+    bool hierarchyRowsDirty = true;
+    void RebuildHierarchyRows();
     void RenderNodeContextMenu(std::shared_ptr<Node> node);
     void AddChildNode(std::shared_ptr<Node> parent, NodeType type);
-    std::shared_ptr<Node> CreateNodeOfType(NodeType type, const std::string &name);
+
+    // Prefabs created from the hierarchy, offered in the Add Child Node menu
+    std::vector<std::shared_ptr<const Prefab>> prefabs;
+    void AddPrefabInstance(std::shared_ptr<Node> parent, const std::shared_ptr<const Prefab> &prefab);
+
+    // World split into cell files, streamed in around the active camera while open
+    WorldPartition worldPartition;
+    WorldPartition::Settings worldSettings;
+    std::string worldDirectory = "world";
+    void ToggleWorldStreaming();
+    void UpdateWorldStreaming();
+
+    // Spatial index over node world bounds, kept in sync through NodeChangeBus
+    SpatialGrid2D sceneGrid;
+    std::vector<Node *> visibleNodes;
+    uint32_t changeSubscription = 0;
+    void UpdateSceneIndex(const std::vector<NodeChangeEvent> &events);
+
+    // Bounding volume hierarchy for picking, fed with the same bounds as the culling data
+    BoundingVolumeHierarchy pickingTree;
+
+    // Packed 3D bounds for frustum culling, sceneBoundsNodes[i] owns box i
+    BoundsArray3D sceneBounds3D;
+    std::vector<Node *> sceneBoundsNodes;
+    std::unordered_map<const Node *, uint32_t> sceneBoundsLookup;
+    std::vector<uint32_t> visibleBoundsIndices;
+    std::vector<uint32_t> cameraBoundsIndices;
+    void UpdateSceneBounds3D(Node *node, const float boundsMin[3], const float boundsMax[3]);
+    void RemoveSceneBounds3D(Node *node);
+
+    // Draw ordering for sprites in the 2D viewport
+    RenderQueue opaqueQueue{RenderQueue::SortMode::Opaque};
+    RenderQueue transparentQueue{RenderQueue::SortMode::Transparent};
+
+    // Placements of the prefab nodes submitted this frame, indexed by RenderItem::origin
+    struct PrefabNodeDraw
+    {
+        Node *owner; // Instance the node selects and picks as
+        Node::Transform world;
+    };
+    std::vector<PrefabNodeDraw> prefabNodeDraws;
+    std::vector<Node::Transform> prefabNodeTransforms;
+
+    // Screen-space tiled lighting for Light2D nodes in the 2D viewport
+    TiledLightCuller lightCuller;
+    void RenderLighting2D(ImVec2 startPos, ImVec2 viewportSize);
+
+    // Retained drawing of subtrees marked "cache as bitmap"
+    SubtreeRenderCache subtreeCache;
+    std::vector<Node *> liveNodes;
+    std::vector<Node *> visibleCacheRoots;
+    std::vector<Node *> cachedSubtreeNodes;
+    void DrawNodes2D(const std::vector<Node *> &nodes, ImVec2 viewportSize, ImVec2 startPos);
+    void RenderCachedSubtree2D(Node *cacheRoot, ImVec2 viewportSize, ImVec2 startPos);
+    void SubmitPrefabInstance2D(PrefabInstance *instance, ImVec2 viewportSize, ImVec2 startPos, float nodeSize);
+
+    // Last editor viewport rectangle, used to map mouse positions
+    ImVec2 editorViewportPos = ImVec2(0, 0);
+    ImVec2 editorViewportSize = ImVec2(0, 0);
 
     // Editor functionality
     void RenderGizmoControls();
-    void RenderNodeInEditor(std::shared_ptr<Node> node, bool is3D,
-                            float parentX = 0.0f, float parentY = 0.0f,
-                            float parentRotation = 0.0f,
-                            float parentScaleX = 1.0f, float parentScaleY = 1.0f);
-    void HandleNodeSelection(ImVec2 mousePos);
-    void RenderGizmos(ImVec2 startPos, ImVec2 viewportSize);
-    void FindNodeAtPosition(std::shared_ptr<Node> node, ImVec2 pos, std::shared_ptr<Node> &result, Node::Transform parentTransform = Node::Transform());
+    void RenderNodeInEditor(Node *node, ImVec2 screenPos, float nodeSize, Node *owner = nullptr);
+    void BuildEditorFrustum3D(ImVec2 viewportSize, Frustum &outFrustum);
+    ImVec2 WorldToScreen3D(float worldX, float worldY, ImVec2 viewportSize, ImVec2 viewportPos);
+    void HandleNodeSelection(ImVec2 mousePos, bool additive);
+    bool RenderGizmos(ImVec2 startPos, ImVec2 viewportSize);
+    Node *PickNodeAt(ImVec2 screenPos);
+
+    // Editor geometry tagged with node ids, only captured on frames with a click
+    bool gpuPicking = false;
+    bool idCaptureActive = false;
+    bool gpuPickRequested = false;
+    bool gpuPickAdditive = false;
+    ImVec2 gpuPickPos = ImVec2(0, 0);
+    IdPickGeometry idPickGeometry;
+    IdPickGeometry gpuPickGeometry; // Captured with the request and kept until the ID pass renders it
+    void CaptureIdGeometry(ImDrawList *drawList, int vertexStart, int indexStart, unsigned int vertexBase, const Node *node);
 
     // Helper function to calculate a node's world position
     void CalculateNodeWorldTransform(std::shared_ptr<Node> node, float &outWorldX, float &outWorldY);
@@ -145,6 +282,7 @@ private:
     void Handle3DCameraControls(ImVec2 viewportSize, ImVec2 viewportPos);
     ImVec2 WorldToScreen2D(float worldX, float worldY, ImVec2 viewportSize, ImVec2 viewportPos);
     ImVec2 ScreenToWorld2D(float screenX, float screenY, ImVec2 viewportSize, ImVec2 viewportPos);
+    ImVec2 ScreenToWorld3D(float screenX, float screenY, ImVec2 viewportSize, ImVec2 viewportPos);
 
     // Theme colors
     void SetupTheme();
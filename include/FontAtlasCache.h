@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+struct ImFontAtlas;
+
+/**
+ * @brief On-disk cache of the baked ImGui font atlas
+ *
+ * Rasterizing the editor fonts is a large part of startup. Once the fonts
+ * have been added to the atlas, Build() looks for a cache file whose key
+ * matches them: a hash of the font data, sizes, glyph ranges and every
+ * config option that changes the rasterized result, plus the ImGui version.
+ * On a match the texture and glyph metrics are restored from the file in a
+ * single read and nothing is rasterized. Otherwise the atlas is built as
+ * usual and written to the cache for the next launch.
+ */
+class FontAtlasCache
+{
+public:
+    // Build the atlas, from the cache file when it is still valid. Returns false if the atlas couldn't be built.
+    static bool Build(ImFontAtlas *atlas, const std::string &cachePath);
+
+    // Key of the atlas' current fonts, changes whenever the baked result would
+    static uint64_t ComputeKey(ImFontAtlas *atlas);
+
+private:
+    static bool Load(ImFontAtlas *atlas, const std::string &cachePath, uint64_t key);
+    static bool Save(const ImFontAtlas *atlas, const std::string &cachePath, uint64_t key);
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+struct ImFontAtlas;
+
+/**
+ * @brief GPU copy of the ImGui font atlas, uploaded without stalling startup
+ *
+ * The atlas is uploaded as a single-channel image, a quarter of the RGBA
+ * texture the ImGui backend would create, and the view swizzles it to the
+ * white-with-alpha texels the ImGui shaders expect. The copy is submitted
+ * with a fence instead of waiting for the queue to drain: its barrier
+ * orders it before every frame submitted to the same queue afterwards, so
+ * nothing on the CPU waits for it and the staging buffer is freed once
+ * Poll() sees the fence signaled.
+ */
+class FontTexture
+{
+public:
+    FontTexture();
+    ~FontTexture();
+
+    // Record and submit the upload of a built atlas, and point the atlas at the texture. Call before frames are submitted.
+    void Upload(VkPhysicalDevice physicalDevice, VkDevice device, VkQueue queue, VkCommandPool commandPool, ImFontAtlas *atlas);
+
+    // Release the staging buffer once the upload has finished. Same thread as the command pool's other users.
+    void Poll();
+
+    // Called while the ImGui backend is still alive, the descriptor set belongs to it
+    void Cleanup();
+
+private:
+    uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+    void ReleaseStaging();
+
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+    VkImageView imageView = VK_NULL_HANDLE;
+    VkSampler sampler = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+    // Upload in flight
+    VkBuffer stagingBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    VkCommandBuffer uploadCommands = VK_NULL_HANDLE;
+    VkFence uploadFence = VK_NULL_HANDLE;
+};
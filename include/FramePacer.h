@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Frame limiter that keeps frame times steady
+ *
+ * Each frame is released at a fixed deadline. The pacer sleeps until shortly
+ * before the deadline and spins for the rest, with the spin margin adapted to
+ * how late the OS actually wakes the thread. When frames keep missing their
+ * deadline the pacer drops to an even fraction of the target rate rather than
+ * alternating between fast and slow frames, and returns once there is headroom
+ * again.
+ */
+class FramePacer
+{
+public:
+    enum class Mode
+    {
+        Editor,   // Capped at the target rate, pairs with the engine's idle mode
+        Game,     // Paced to the target rate, halving it while deadlines are missed
+        Benchmark // Uncapped, only measures
+    };
+
+    // Frame time statistics over every frame paced since the pacer was created, in milliseconds
+    struct Stats
+    {
+        double averageFrameTime = 0.0;
+        double frameTimeDeviation = 0.0;
+        double worstFrameTime = 0.0;
+        uint64_t frameCount = 0;
+        uint64_t missedDeadlines = 0;
+    };
+
+    FramePacer();
+    ~FramePacer();
+
+    // Parse "editor", "game" or "benchmark", returns false for anything else
+    static bool ParseMode(const std::string &name, Mode &outMode);
+    static const char *GetModeName(Mode mode);
+
+    void SetMode(Mode mode);
+    Mode GetMode() const;
+    void SetTargetFrameRate(double framesPerSecond);
+    double GetTargetFrameRate() const;
+
+    // Block until the next frame should start
+    void WaitForNextFrame();
+
+    // Restart the deadline from now, e.g. after the loop slept on purpose
+    void Reset();
+
+    const Stats &GetStats() const;
+
+    // Current pacing interval, a multiple of the target frame time while deadlines are missed
+    double GetEffectiveFrameRate() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void SleepUntil(Clock::time_point deadline);
+    void RecordFrame(double frameTime);
+    void AdaptInterval(bool missed);
+
+    Mode mode = Mode::Editor;
+    double targetFrameTime = 1.0 / 60.0;
+    int intervalMultiplier = 1;
+
+    Clock::time_point deadline;
+    Clock::time_point lastFrameStart;
+    bool hasLastFrame = false;
+
+    // How early to stop sleeping and start spinning, follows how late sleeps wake up. In seconds.
+    double spinMargin = 0.002;
+    double averageOversleep = 0.001;
+
+    // Consecutive frames that missed or comfortably made their deadline
+    int missStreak = 0;
+    int headroomStreak = 0;
+
+    // Running totals behind the statistics
+    double frameTimeSum = 0.0;
+    double frameTimeSquareSum = 0.0;
+    Stats stats;
+};
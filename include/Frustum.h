@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Plane in the form dot(normal, p) + distance = 0, normal pointing inside
+ */
+struct Plane
+{
+    float normal[3] = {0.0f, 0.0f, 1.0f};
+    float distance = 0.0f;
+};
+
+/**
+ * @brief Axis-aligned boxes stored as contiguous centre/extent arrays
+ *
+ * The structure-of-arrays layout lets the culling kernel load 4 or 8 boxes
+ * per instruction. Boxes are addressed by index; removal swaps the last box
+ * into the freed slot.
+ */
+struct BoundsArray3D
+{
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+
+    void Clear();
+    void Reserve(size_t count);
+    size_t Add(const float boundsMin[3], const float boundsMax[3]);
+    void Set(size_t index, const float boundsMin[3], const float boundsMax[3]);
+    void SwapRemove(size_t index);
+    size_t GetSize() const;
+};
+
+/**
+ * @brief View frustum made of six inward-facing planes
+ *
+ * Planes are derived directly from a perspective camera (position, Euler
+ * rotation, vertical field of view and clip distances). CullAABBs runs the
+ * box test over contiguous bounds with AVX or SSE when the build enables them
+ * and falls back to a scalar loop otherwise.
+ */
+class Frustum
+{
+public:
+    enum PlaneIndex
+    {
+        Near,
+        Far,
+        Left,
+        Right,
+        Top,
+        Bottom,
+        PlaneCount
+    };
+
+    Frustum();
+
+    // Build the planes from a perspective camera looking down its local -Z axis
+    void SetFromPerspective(const float position[3], const float rotationDegrees[3],
+                            float fovDegrees, float aspectRatio, float nearClip, float farClip);
+
+    // Build the planes of an orthographic view down the Z axis, unbounded in depth. axisX and axisY are the unit world
+    // XY directions of the view's horizontal and vertical axes, center is the view centre measured along them.
+    void SetFromOrthographic(const float axisX[2], const float axisY[2], const float center[2], float halfWidth, float halfHeight);
+
+    // Single box test
+    bool TestAABB(const float center[3], const float extent[3]) const;
+
+    // Batched box test, appends the indices of boxes that intersect the frustum
+    void CullAABBs(const BoundsArray3D &bounds, std::vector<uint32_t> &outVisible) const;
+
+    const Plane &GetPlane(int index) const;
+
+private:
+    Plane planes[PlaneCount];
+
+    void CullAABBsScalar(const BoundsArray3D &bounds, size_t begin, std::vector<uint32_t> &outVisible) const;
+};
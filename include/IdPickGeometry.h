@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "imgui.h"
+
+/**
+ * @brief Geometry for the ID pass
+ *
+ * ImGui vertices whose colour holds the instance id of the node that drew
+ * them, in the same screen space as the editor's draw lists.
+ */
+struct IdPickGeometry
+{
+    std::vector<ImDrawVert> vertices;
+    std::vector<uint32_t> indices;
+    ImVec4 clipRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+
+    void Clear()
+    {
+        vertices.clear();
+        indices.clear();
+    }
+};
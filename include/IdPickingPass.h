@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+#include "IdPickGeometry.h"
+
+/**
+ * @brief GPU picking through an offscreen node id image
+ *
+ * On frames with a pick request the editor geometry is rasterized into an
+ * R32_UINT image where each pixel holds the id of the node drawn on top.
+ * A small block around the cursor is copied to a host-visible buffer in the
+ * same command buffer, and the result is read once the submission's fence
+ * has signaled, so the frame never waits on the GPU. The cost only depends
+ * on the size of the image and the block read back, not on the scene.
+ */
+class IdPickingPass
+{
+public:
+    // Side of the square block read back around the cursor
+    static constexpr int ReadbackSize = 5;
+
+    IdPickingPass();
+    ~IdPickingPass();
+
+    void Init(VkPhysicalDevice physicalDevice, VkDevice device, VkExtent2D extent);
+    void Resize(VkExtent2D extent);
+    void Cleanup();
+
+    // Ask for the id under a framebuffer pixel. A newer request replaces one that hasn't been recorded yet.
+    void RequestPick(int x, int y);
+    bool HasPendingPick() const;
+
+    // Record the pass and the readback if a pick is waiting. Outside any render pass.
+    void Record(VkCommandBuffer commandBuffer, const IdPickGeometry &geometry, ImVec2 displayPos, ImVec2 displaySize, ImVec2 framebufferScale);
+
+    // Fence to signal with the submission that carries the recorded pass, VK_NULL_HANDLE if nothing was recorded
+    VkFence TakeSubmitFence();
+
+    // Returns true once a readback has completed, outId is 0 when nothing was under the cursor
+    bool PollResult(uint32_t &outId);
+
+private:
+    void CreateRenderPass();
+    void CreatePipeline();
+    void CreateTarget();
+    void DestroyTarget();
+    void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &outBuffer, VkDeviceMemory &outMemory, void **outMapped);
+    void DestroyBuffer(VkBuffer &buffer, VkDeviceMemory &memory);
+    void EnsureGeometryCapacity(size_t vertexBytes, size_t indexBytes);
+    uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+    VkShaderModule CreateShaderModule(const uint32_t *code, size_t codeSize);
+
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    VkExtent2D extent = {0, 0};
+
+    // Id image and the pass that renders into it
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+    VkImageView imageView = VK_NULL_HANDLE;
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+
+    // Host-visible geometry, only rewritten when no pass is in flight
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
+    void *vertexMapped = nullptr;
+    VkDeviceSize vertexCapacity = 0;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory indexMemory = VK_NULL_HANDLE;
+    void *indexMapped = nullptr;
+    VkDeviceSize indexCapacity = 0;
+
+    // Readback of the block around the cursor
+    VkBuffer readbackBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory readbackMemory = VK_NULL_HANDLE;
+    void *readbackMapped = nullptr;
+    VkFence readbackFence = VK_NULL_HANDLE;
+
+    // Request waiting to be recorded, and the one whose readback is in flight
+    bool pickPending = false;
+    int pickX = 0, pickY = 0;
+    bool readbackInFlight = false;
+    bool fenceTaken = false;
+    int readbackX = 0, readbackY = 0;
+    int readbackWidth = 0, readbackHeight = 0;
+    int readbackCenterX = 0, readbackCenterY = 0;
+};
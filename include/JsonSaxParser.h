@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Receives the events of a JSON document as it is parsed
+ *
+ * Strings and keys point into the parser's input when they contain no
+ * escapes, or into a scratch buffer otherwise, and are only valid for the
+ * duration of the call. Returning false from any event stops the parse.
+ */
+class JsonSaxHandler
+{
+public:
+    virtual ~JsonSaxHandler() = default;
+
+    virtual bool StartObject() = 0;
+    virtual bool EndObject() = 0;
+    virtual bool StartArray() = 0;
+    virtual bool EndArray() = 0;
+    virtual bool Key(const char *key, size_t length) = 0;
+    virtual bool String(const char *value, size_t length) = 0;
+    virtual bool Number(double value) = 0;
+    virtual bool Bool(bool value) = 0;
+    virtual bool Null() = 0;
+};
+
+/**
+ * @brief Streaming JSON parser that reports values to a handler instead of building a tree
+ *
+ * The input is walked once, left to right, with an explicit container stack
+ * rather than recursion, so nesting depth is only bounded by memory. No
+ * allocation happens per value: unescaped strings are passed straight from
+ * the input and numbers are converted in place.
+ */
+class JsonSaxParser
+{
+public:
+    JsonSaxParser();
+    ~JsonSaxParser();
+
+    // Parse a complete document, returns false on malformed input or when the handler stops
+    bool Parse(const char *data, size_t size, JsonSaxHandler &handler);
+
+    // Description of a syntax error, empty when the handler stopped the parse
+    const std::string &GetError() const;
+
+    // 1-based line where parsing stopped, valid while the input is
+    size_t GetErrorLine() const;
+
+private:
+    void SkipWhitespace();
+    bool ParseString(const char *&outValue, size_t &outLength);
+    bool ParseNumber(double &outValue);
+    bool ParseLiteral(const char *literal, size_t length);
+    bool Fail(const char *message);
+
+    const char *begin = nullptr;
+    const char *cursor = nullptr;
+    const char *end = nullptr;
+
+    // Open containers, '{' or '['
+    std::vector<char> containers;
+
+    // Decoded strings that contained escapes
+    std::string scratch;
+
+    std::string error;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The file's pages are mapped into the address space and only read from disk
+ * when first touched, so opening a large file costs nothing up front and
+ * data can be used in place without copying it into buffers.
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool Open(const std::string &path);
+    void Close();
+
+    bool IsOpen() const;
+    const uint8_t *GetData() const;
+    size_t GetSize() const;
+
+private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+};
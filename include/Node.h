@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
 #include <functional>
+#include "StringAtom.h"
+#include "NodeFields.h"
 
-// Node types for the scene hierarchy
+// Node types for the scene hierarchy, each one is registered with NodeTypeRegistry
 enum class NodeType
 {
     Root,
@@ -17,40 +21,66 @@ enum class NodeType
     Light,
     Label,
     Button,
-    Panel
+    Panel,
+    Count
 };
 
-// Forward declaration
-class Node;
+// Editable node properties, addressed by id so edits can be recorded and replayed
+enum class NodeProperty : uint16_t
+{
+    Name,
+    CacheAsBitmap,
+    Position,
+    Rotation,
+    Scale,
+    Color,
+    Texture,
+    Text,
+    Font,
+    FontSize,
+    Layer,
+    ZIndex,
+    YSort,
+    Energy,
+    Radius,
+    Zoom,
+    Active,
+    Fov,
+    NearClip,
+    FarClip,
+    Count
+};
 
-/**
- * @brief Documentation structure for node methods
- */
-struct MethodDoc
+// Kinds of change a node records until NodeChangeBus delivers them, combined as a bitmask
+enum NodeChange : uint8_t
 {
-    std::string name;                                        // Method name
-    std::string description;                                 // Method description
-    std::string returnType;                                  // Return type
-    std::string returnDesc;                                  // Return value description
-    std::vector<std::pair<std::string, std::string>> params; // Parameter name and description pairs
-    std::vector<std::string> examples;                       // Usage examples
+    NodeChangeTransform = 1 << 0, // World transform, the flush adds an event for every descendant that moved along
+    NodeChangeVisual = 1 << 1,    // Anything that changes how the node draws, including its bounds
+    NodeChangeStructure = 1 << 2, // Children added or removed, or the node itself attached or detached
+    NodeChangeName = 1 << 3,
+    NodeChangeDestroyed = 1 << 4
 };
 
+// Forward declarations
+class Node;
+class NodeChangeBus;
+class RenderQueue;
+
 /**
  * @brief Base Node class that all node types will inherit from
  */
-class Node
+class Node : public std::enable_shared_from_this<Node>
 {
 public:
-    Node(const std::string &nodeName, NodeType nodeType);
+    Node(const StringAtom &nodeName, NodeType nodeType);
     virtual ~Node();
 
-    // Node properties
-    std::string name;
-    bool selected = false;
+    // Node properties - renames go through SetName so they are reported
+    StringAtom name;
     bool expanded = false;
     std::vector<std::shared_ptr<Node>> children;
-    NodeType type; // Store the node type
+    Node *parent = nullptr; // Owning parent, null for scene roots and detached nodes
+    NodeType type;          // Store the node type
 
     // Node transform
     struct Transform
@@ -61,26 +91,208 @@ public:
     };
     Transform transform;
 
+    // Cached world transform, valid once NodeChangeBus has flushed the frame's changes
+    Transform worldTransform;
+
+    // Names
+    const StringAtom &GetName() const;
+
+    /**
+     * Renames the node and reports the change to NodeChangeBus subscribers.
+     * @param newName New name of the node
+     * @example node->SetName("Player");
+     */
+    void SetName(const StringAtom &newName);
+
+    // Change tracking - the NodeChange flags recorded since the last NodeChangeBus flush
+    /**
+     * Records NodeChange flags on the node. Changes are merged per node and delivered to NodeChangeBus
+     * subscribers once per frame, so derived data only revisits what changed.
+     * @param changes NodeChange flags, combined with |
+     * @example node->MarkChanged(NodeChangeVisual);
+     */
+    void MarkChanged(uint8_t changes);
+    uint8_t GetPendingChanges() const;
+
+    // Drawing changed, records a visual change and redraws any cache holding the node
+    /**
+     * Records a visual change and invalidates the cached drawing holding the node. Node setters that change
+     * drawing or bounds call this automatically.
+     * @example sprite->MarkVisualDirty();
+     */
+    void MarkVisualDirty();
+
+    // Transform change tracking
+    /**
+     * Flags the node's world transform for recomputation. Call after editing transform fields directly; the
+     * node and its subtree are refreshed once per frame.
+     * @example
+     * node->transform.position[0] += 10.0f;
+     * node->MarkTransformDirty();
+     */
+    void MarkTransformDirty();
+    bool IsTransformDirty() const;
+    void UpdateWorldTransform();
+    static void ComposeTransforms(const Transform &parentWorld, const Transform &local, Transform &outWorld);
+    /**
+     * Converts a world space XY offset into the parent's space, where transform.position lives. Uses the parent's
+     * cached world transform, so it must be current.
+     * @param worldX Offset along world X
+     * @param worldY Offset along world Y
+     * @param outLocalX Receives the offset along the parent's X axis
+     * @param outLocalY Receives the offset along the parent's Y axis
+     * @example
+     * node->WorldOffsetToLocal(dragX, dragY, localX, localY);
+     * node->transform.position[0] += localX;
+     */
+    void WorldOffsetToLocal(float worldX, float worldY, float &outLocalX, float &outLocalY) const;
+
+    // Render caching - a cached subtree is drawn once and replayed until something inside it changes
+    /**
+     * Caches the drawing of this node and its subtree. The cached drawing is reused, moved along with the
+     * node, until a descendant's transform or properties change.
+     * @param enabled Whether the subtree should be cached
+     * @example backgroundNode->SetCacheAsBitmap(true);
+     */
+    void SetCacheAsBitmap(bool enabled);
+    bool IsCacheAsBitmap() const;
+
+    /**
+     * Marks the cached drawing of every cached subtree containing this node as stale. Node setters call this
+     * automatically.
+     * @example node->InvalidateRenderCache();
+     */
+    void InvalidateRenderCache();
+    uint32_t GetRenderCacheVersion() const;
+    Node *GetRenderCacheRoot();
+    static bool HasRenderCaches();
+
+    // Bumped whenever a node is added, removed or destroyed anywhere, so views of the tree know to rebuild
+    static uint32_t GetHierarchyVersion();
+
+    // Instance id - unique for the process lifetime, 0 is never used so it can mean "no node"
+    /**
+     * Gets the node's unique instance id. Ids are never reused and 0 means no node.
+     * @return The instance id
+     * @example
+     * uint32_t id = node->GetInstanceId();
+     * Node *same = Node::FindByInstanceId(id);
+     */
+    uint32_t GetInstanceId() const;
+    static Node *FindByInstanceId(uint32_t id);
+
+    // Property access by id - values are raw bytes, strings are stored without a terminator.
+    // GetProperty appends the value and returns false if the node has no such property.
+    virtual bool GetProperty(NodeProperty property, std::vector<uint8_t> &outValue) const;
+    virtual bool SetProperty(NodeProperty property, const uint8_t *value, size_t size);
+
+    // Whole-node copy and comparison, typed field by field over the classes both nodes share
+    virtual void CopyProperties(const Node &source);
+    virtual void DiffProperties(const Node &other, std::vector<NodeProperty> &outChanged) const;
+
+    // Every property of the node with its value type, base class fields first, for generic code like serializers
+    virtual const std::vector<PropertyInfo> &GetPropertyInfos() const;
+
+    // Bounds
+    virtual void GetLocalBounds(float outMin[2], float outMax[2]) const;
+
+    /**
+     * Gets the axis-aligned bounds of the node in world space, derived from its cached world transform.
+     * @param outMin Receives the minimum corner [x, y]
+     * @param outMax Receives the maximum corner [x, y]
+     * @example
+     * float boundsMin[2], boundsMax[2];
+     * node->GetWorldBounds(boundsMin, boundsMax);
+     */
+    void GetWorldBounds(float outMin[2], float outMax[2]) const;
+
+    /**
+     * Gets the axis-aligned bounds of the node in world space including depth.
+     * @param outMin Receives the minimum corner [x, y, z]
+     * @param outMax Receives the maximum corner [x, y, z]
+     * @example
+     * float boundsMin[3], boundsMax[3];
+     * node->GetWorldBounds3D(boundsMin, boundsMax);
+     */
+    void GetWorldBounds3D(float outMin[3], float outMax[3]) const;
+    bool IsInTree(const Node *root) const;
+
     // Node methods
+    /**
+     * Updates the node state based on the elapsed time.
+     * @param deltaTime Time elapsed since the last frame in seconds
+     * @example node->Update(deltaTime);
+     */
     virtual void Update(float deltaTime);
+
+    /**
+     * Renders the node to the screen.
+     * @example node->Render();
+     */
     virtual void Render();
 
+    // Draw submission - nodes that draw push themselves into the frame's queues. world is where the node
+    // is drawn, its own world transform except for a prefab's shared nodes drawn for an instance.
+    virtual void SubmitDraw(const Transform &world, RenderQueue &opaqueQueue, RenderQueue &transparentQueue);
+    void SubmitDrawCalls(RenderQueue &opaqueQueue, RenderQueue &transparentQueue);
+
     // Inspector rendering
     virtual void RenderInspectorProperties();
-    static std::vector<NodeType> GetAvailableNodeTypes();
+    static const std::vector<NodeType> &GetAvailableNodeTypes();
 
     // Child management
+    /**
+     * Adds a child node to this node.
+     * @param child Shared pointer to the child node to add
+     * @example
+     * auto childNode = std::make_shared<Node2D>("Child");
+     * parentNode->AddChild(childNode);
+     */
     void AddChild(std::shared_ptr<Node> child);
-    void RemoveChild(std::shared_ptr<Node> child);
 
-    // Documentation methods
-    static void InitializeDocumentation();
+    /**
+     * Removes a child node from this node.
+     * @param child Shared pointer to the child node to remove
+     * @example parentNode->RemoveChild(childNode);
+     */
+    void RemoveChild(std::shared_ptr<Node> child);
 
-    // Type information
-    virtual std::string GetTypeName() const;
+    // Type information - the name is interned once per class, so this never allocates
+    /**
+     * Returns the type name of the node. Type names are interned, so this doesn't allocate.
+     * @return The type name as a string
+     * @example StringAtom typeName = node->GetTypeName();
+     */
+    virtual const StringAtom &GetTypeName() const;
 
 protected:
-    // Documentation registration
-    static void RegisterMethod(const std::string &nodeType, const MethodDoc &methodDoc);
-    static void RegisterNodeDescription(const std::string &nodeType, const std::string &description);
+    uint32_t instanceId = 0;
+
+    // Render caching
+    bool cacheAsBitmap = false;
+    uint32_t renderCacheVersion = 0;
+
+    // Transform change tracking, cleared when NodeChangeBus refreshes the subtree
+    bool transformDirty = false;
+
+private:
+    friend class NodeChangeBus;
+
+    // Changes waiting for the bus, and this node's event in its batch (1-based, 0 when there is none)
+    uint8_t pendingChanges = 0;
+    uint32_t changeSlot = 0;
+};
+
+// Reflected fields, see NodeReflection
+template <>
+struct NodeFields<Node>
+{
+    using Base = void;
+    static constexpr const char *Section = "Transform";
+    static constexpr auto List = std::make_tuple(
+        Accessor<Node>(NodeProperty::Name, "Name", Widget(FieldWidget::Hidden), &Node::GetName, &Node::SetName),
+        Field(NodeProperty::Position, "Position", Widget(FieldWidget::Float3), &Node::transform, &Node::Transform::position, &Node::MarkTransformDirty),
+        Field(NodeProperty::Rotation, "Rotation", Widget(FieldWidget::Float3), &Node::transform, &Node::Transform::rotation, &Node::MarkTransformDirty),
+        Field(NodeProperty::Scale, "Scale", Widget(FieldWidget::Float3), &Node::transform, &Node::Transform::scale, &Node::MarkTransformDirty),
+        Accessor<Node>(NodeProperty::CacheAsBitmap, "Cache As Bitmap", Widget(FieldWidget::Checkbox), &Node::IsCacheAsBitmap, &Node::SetCacheAsBitmap));
 };
\ No newline at end of file
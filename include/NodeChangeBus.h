@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Node.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief One node's changes since the last flush, all kinds merged into one mask
+ */
+struct NodeChangeEvent
+{
+    Node *node;          // Null if the node was destroyed before the flush
+    Node *address;       // Where the node lived, to drop a destroyed node from containers keyed by pointer. Never dereferenced.
+    uint32_t instanceId;
+    uint8_t changes;     // NodeChange flags
+};
+
+/**
+ * @brief Frame-batched stream of node changes
+ *
+ * Nodes record what changed on them as it happens (Node::MarkChanged). The
+ * first change to a node in a frame appends one event, later ones only set
+ * bits in it, so a batch never holds more than one event per changed node
+ * no matter how often it was edited. Flush first recomputes the world
+ * transforms of every moved subtree, adding a transform event for each
+ * descendant that moved along, then hands the batch to every subscriber
+ * whose mask matches anything in it. Subscribers update their derived data
+ * from the events alone instead of rescanning the scene.
+ *
+ * Changes made while a batch is being delivered go into the next one.
+ * Listeners must not destroy nodes, subscribe or unsubscribe while they
+ * are called, as the batch holds plain pointers. Like the rest of the node
+ * code this is main thread only.
+ */
+class NodeChangeBus
+{
+public:
+    using Listener = std::function<void(const std::vector<NodeChangeEvent> &events)>;
+
+    // Returns an id for Unsubscribe, never 0. Listeners are called in subscription order.
+    static uint32_t Subscribe(uint8_t changeMask, Listener listener);
+    static void Unsubscribe(uint32_t subscription);
+
+    // Deliver the changes recorded since the last flush, called once per frame
+    static void Flush();
+    static bool HasPendingChanges();
+
+private:
+    friend class Node;
+
+    static void Record(Node *node, uint8_t changes);
+    static void RecordDestroyed(Node *node);
+    static void AddChange(std::vector<NodeChangeEvent> &events, Node *node, uint8_t changes);
+    static void RefreshWorldTransforms(std::vector<NodeChangeEvent> &events);
+    static void RefreshSubtree(Node *node, std::vector<NodeChangeEvent> &events);
+};
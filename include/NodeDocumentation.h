@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Read-only view of a documentation table, usable in range-for
+ */
+template <typename T>
+struct DocSpan
+{
+    const T *data;
+    uint32_t count;
+
+    constexpr const T *begin() const { return data; }
+    constexpr const T *end() const { return data + count; }
+    constexpr size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    constexpr const T &operator[](size_t index) const { return data[index]; }
+};
+
+struct ParamDoc
+{
+    const char *name;
+    const char *description;
+};
+
+/**
+ * @brief Documentation structure for node methods
+ */
+struct MethodDoc
+{
+    const char *name;         // Method name
+    const char *description;  // Method description
+    const char *returnType;   // Return type
+    const char *returnDesc;   // Return value description
+    DocSpan<ParamDoc> params; // Parameters in declaration order
+    const char *example;      // Usage example, may span lines
+};
+
+struct NodeDoc
+{
+    const char *nodeType;
+    const char *description;
+    DocSpan<MethodDoc> methods; // In declaration order
+};
+
+/**
+ * @brief The documentation of every node class, compiled in
+ *
+ * The tables are generated at build time by tools/generate_node_docs.py
+ * from the doc comments on the node classes and their methods, see the
+ * script for the format. Nothing is registered or copied at runtime, the
+ * documentation browser reads the tables in place.
+ */
+class NodeDocumentation
+{
+public:
+    // Every documented node class, sorted by name
+    static DocSpan<NodeDoc> GetNodes();
+
+    // Null if the type has no documentation
+    static const NodeDoc *Find(std::string_view nodeType);
+};
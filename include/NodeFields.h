@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+// Defined with the node classes
+enum class NodeProperty : uint16_t;
+
+// How a field is edited in the inspector
+enum class FieldWidget : uint8_t
+{
+    Hidden,
+    Label,    // Read-only text
+    Text,     // Single line text input
+    Int,
+    Float,    // Input with step buttons
+    Slider,
+    Float3,
+    Color3,
+    Color4,
+    Checkbox
+};
+
+struct FieldUi
+{
+    FieldWidget widget = FieldWidget::Hidden;
+    float min = 0.0f;      // Slider range
+    float max = 0.0f;
+    float step = 0.0f;     // Float input steps
+    float fastStep = 0.0f;
+    const char *format = "%.3f";
+};
+
+constexpr FieldUi Widget(FieldWidget widget)
+{
+    return {widget, 0.0f, 0.0f, 0.0f, 0.0f, "%.3f"};
+}
+
+constexpr FieldUi FloatInput(float step, float fastStep, const char *format)
+{
+    return {FieldWidget::Float, 0.0f, 0.0f, step, fastStep, format};
+}
+
+constexpr FieldUi Slider(float min, float max, const char *format = "%.3f")
+{
+    return {FieldWidget::Slider, min, max, 0.0f, 0.0f, format};
+}
+
+// Fields that must not be carried over when one node's properties are copied onto another
+constexpr uint8_t FieldNoCopy = 1;
+
+// The hook validates edits made in the inspector only. Undo, loads and copies write values that were valid
+// together, one field at a time, and a hook checking one against another would reject the intermediate states.
+constexpr uint8_t FieldHookOnEdit = 2;
+
+// Value type of a property, for code that moves values around without knowing the node's class
+enum class PropertyKind : uint8_t
+{
+    String,
+    Atom,
+    Bool,
+    Int,
+    Float,
+    Float3,
+    Float4
+};
+
+// Runtime description of one field, see Node::GetPropertyInfos
+struct PropertyInfo
+{
+    NodeProperty property;
+    PropertyKind kind;
+    uint8_t flags;
+};
+
+/**
+ * @brief Field stored directly in a member, with an optional hook run after it is written
+ *
+ * The hook may be a member of a base class, HookOwner, like Node::MarkTransformDirty.
+ */
+template <typename Class, typename T, typename HookOwner = Class>
+struct MemberField
+{
+    using ValueType = T;
+
+    NodeProperty property;
+    const char *label;
+    FieldUi ui;
+    uint8_t flags;
+    T Class::*member;
+    void (HookOwner::*changed)();
+
+    const T &Get(const Class &object) const { return object.*member; }
+    T &GetMutable(Class &object) const { return object.*member; }
+    bool HasHook() const { return changed != nullptr; }
+    void RunHook(Class &object) const { (object.*changed)(); }
+};
+
+/**
+ * @brief Field stored in a member of a member, like one part of Node::transform
+ */
+template <typename Class, typename Outer, typename T, typename HookOwner = Class>
+struct NestedField
+{
+    using ValueType = T;
+
+    NodeProperty property;
+    const char *label;
+    FieldUi ui;
+    uint8_t flags;
+    Outer Class::*outer;
+    T Outer::*member;
+    void (HookOwner::*changed)();
+
+    const T &Get(const Class &object) const { return (object.*outer).*member; }
+    T &GetMutable(Class &object) const { return (object.*outer).*member; }
+    bool HasHook() const { return changed != nullptr; }
+    void RunHook(Class &object) const { (object.*changed)(); }
+};
+
+/**
+ * @brief Field read and written through the class's getter and setter, which keep its invariants
+ */
+template <typename Class, typename T, typename Getter, typename Setter>
+struct AccessorField
+{
+    using ValueType = T;
+
+    NodeProperty property;
+    const char *label;
+    FieldUi ui;
+    uint8_t flags;
+    Getter getter;
+    Setter setter;
+
+    decltype(auto) Get(const Class &object) const { return (object.*getter)(); }
+    void Set(Class &object, const T &value) const { (object.*setter)(value); }
+};
+
+template <typename Class, typename T>
+constexpr MemberField<Class, T> Field(NodeProperty property, const char *label, FieldUi ui, T Class::*member)
+{
+    return {property, label, ui, 0, member, nullptr};
+}
+
+template <typename Class, typename T, typename HookOwner>
+constexpr MemberField<Class, T, HookOwner> Field(NodeProperty property, const char *label, FieldUi ui, T Class::*member,
+                                                 void (HookOwner::*changed)(), uint8_t flags = 0)
+{
+    static_assert(std::is_base_of<HookOwner, Class>::value, "Field hooks must be members of the class or a base");
+    return {property, label, ui, flags, member, changed};
+}
+
+template <typename Class, typename Outer, typename T, typename HookOwner>
+constexpr NestedField<Class, Outer, T, HookOwner> Field(NodeProperty property, const char *label, FieldUi ui, Outer Class::*outer, T Outer::*member,
+                                                        void (HookOwner::*changed)(), uint8_t flags = 0)
+{
+    static_assert(std::is_base_of<HookOwner, Class>::value, "Field hooks must be members of the class or a base");
+    return {property, label, ui, flags, outer, member, changed};
+}
+
+template <typename Class, typename Getter, typename Setter>
+constexpr auto Accessor(NodeProperty property, const char *label, FieldUi ui, Getter getter, Setter setter, uint8_t flags = 0)
+{
+    using T = std::decay_t<decltype((std::declval<const Class &>().*getter)())>;
+    return AccessorField<Class, T, Getter, Setter>{property, label, ui, flags, getter, setter};
+}
+
+/**
+ * @brief Field list of a node class, specialized next to each class
+ *
+ *     template <>
+ *     struct NodeFields<Camera2D>
+ *     {
+ *         using Base = Node2D;
+ *         static constexpr const char *Section = "Camera2D Properties";
+ *         static constexpr auto List = std::make_tuple(
+ *             Accessor<Camera2D>(NodeProperty::Zoom, "Zoom", Slider(0.1f, 10.0f), &Camera2D::GetZoom, &Camera2D::SetZoom));
+ *     };
+ *
+ * Base is void for Node itself. The class declares the specialization a
+ * friend so fields can point at private members. NodeReflection walks the
+ * lists from the base class down.
+ */
+template <typename Class>
+struct NodeFields;
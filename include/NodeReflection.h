@@ -0,0 +1,401 @@
+#pragma once
+
+#include "NodeFields.h"
+#include "Node.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <imgui.h>
+
+/**
+ * @brief Generic property code driven by each class's NodeFields list
+ *
+ * Everything here is expanded at compile time over the field tuples, so a
+ * node class never touches its fields one by one: deriving through
+ * ReflectedNode implements Node's property interface for it. Working on a
+ * known class - copying or comparing many Sprites, say - the loops are
+ * plain typed member accesses with no virtual call per field.
+ *
+ * Values are encoded like Node::GetProperty: trivially copyable values as
+ * their bytes, strings and atoms as their text.
+ */
+class NodeReflection
+{
+public:
+    template <typename Class>
+    static bool GetProperty(const Class &object, NodeProperty property, std::vector<uint8_t> &outValue)
+    {
+        bool found = false;
+        ForEachField<Class>([&](const auto &field)
+                            {
+            if (!found && field.property == property)
+            {
+                AppendValue(outValue, field.Get(object));
+                found = true;
+            } });
+        return found;
+    }
+
+    template <typename Class>
+    static bool SetProperty(Class &object, NodeProperty property, const uint8_t *value, size_t size)
+    {
+        bool found = false;
+        bool valid = false;
+        ForEachField<Class>([&](const auto &field)
+                            {
+            if (found || field.property != property)
+                return;
+            found = true;
+            typename std::decay_t<decltype(field)>::ValueType newValue;
+            if (ReadValue(value, size, newValue))
+            {
+                SetField(object, field, newValue);
+                valid = true;
+            } });
+        return valid;
+    }
+
+    // Copy every field from another object of the same class, except those marked FieldNoCopy
+    template <typename Class>
+    static void Copy(Class &object, const Class &source)
+    {
+        ForEachField<Class>([&](const auto &field)
+                            {
+            if (!(field.flags & FieldNoCopy))
+                SetField(object, field, field.Get(source)); });
+    }
+
+    // Append the properties whose values differ between two objects of the same class
+    template <typename Class>
+    static void Diff(const Class &object, const Class &other, std::vector<NodeProperty> &outChanged)
+    {
+        ForEachField<Class>([&](const auto &field)
+                            {
+            if (!ValuesEqual(field.Get(object), field.Get(other)))
+                outChanged.push_back(field.property); });
+    }
+
+    // Copy and Diff with a node of any class, only the fields of the most derived class both share are used
+    template <typename Class>
+    static void CopyFrom(Class &object, const Node &source)
+    {
+        using Base = typename NodeFields<Class>::Base;
+        if (const Class *typed = dynamic_cast<const Class *>(&source))
+            Copy(object, *typed);
+        else if constexpr (!std::is_void<Base>::value)
+            CopyFrom<Base>(object, source);
+    }
+
+    template <typename Class>
+    static void DiffFrom(const Class &object, const Node &other, std::vector<NodeProperty> &outChanged)
+    {
+        using Base = typename NodeFields<Class>::Base;
+        if (const Class *typed = dynamic_cast<const Class *>(&other))
+            Diff(object, *typed, outChanged);
+        else if constexpr (!std::is_void<Base>::value)
+            DiffFrom<Base>(object, other, outChanged);
+    }
+
+    template <typename Class>
+    static bool Equals(const Class &object, const Class &other)
+    {
+        bool equal = true;
+        ForEachField<Class>([&](const auto &field)
+                            { equal = equal && ValuesEqual(field.Get(object), field.Get(other)); });
+        return equal;
+    }
+
+    // Fields of the class and its bases in visiting order, built once per class
+    template <typename Class>
+    static const std::vector<PropertyInfo> &GetPropertyInfos()
+    {
+        static const std::vector<PropertyInfo> infos = []
+        {
+            std::vector<PropertyInfo> list;
+            ForEachField<Class>([&](const auto &field)
+                                {
+                using T = typename std::decay_t<decltype(field)>::ValueType;
+                list.push_back({field.property, KindOf<T>(), field.flags}); });
+            return list;
+        }();
+        return infos;
+    }
+
+    // Inspector widgets for the class and its bases, each class under its own section heading
+    template <typename Class>
+    static void RenderInspector(Class &object)
+    {
+        using Base = typename NodeFields<Class>::Base;
+        if constexpr (!std::is_void<Base>::value)
+        {
+            RenderInspector<Base>(object);
+        }
+
+        const char *section = NodeFields<Class>::Section;
+        if (section)
+        {
+            if (!std::is_void<Base>::value)
+                ImGui::Separator();
+            ImGui::Text("%s", section);
+        }
+
+        std::apply([&](const auto &...field)
+                   { (RenderField(object, field), ...); },
+                   NodeFields<Class>::List);
+    }
+
+    // Visit every field of the class, base class fields first
+    template <typename Class, typename Visitor>
+    static void ForEachField(Visitor &&visitor)
+    {
+        using Base = typename NodeFields<Class>::Base;
+        if constexpr (!std::is_void<Base>::value)
+        {
+            ForEachField<Base>(visitor);
+        }
+        std::apply([&](const auto &...field)
+                   { (visitor(field), ...); },
+                   NodeFields<Class>::List);
+    }
+
+private:
+    template <typename T>
+    static constexpr PropertyKind KindOf()
+    {
+        if constexpr (std::is_same<T, std::string>::value)
+            return PropertyKind::String;
+        else if constexpr (std::is_same<T, StringAtom>::value)
+            return PropertyKind::Atom;
+        else if constexpr (std::is_same<T, bool>::value)
+            return PropertyKind::Bool;
+        else if constexpr (std::is_same<T, int>::value)
+            return PropertyKind::Int;
+        else if constexpr (std::is_same<T, float>::value)
+            return PropertyKind::Float;
+        else if constexpr (std::is_same<T, float[3]>::value)
+            return PropertyKind::Float3;
+        else
+        {
+            static_assert(std::is_same<T, float[4]>::value, "No property kind for this field type");
+            return PropertyKind::Float4;
+        }
+    }
+
+    // Value encoding
+    template <typename T>
+    static void AppendValue(std::vector<uint8_t> &outValue, const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Field values must be trivially copyable, strings or atoms");
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+        outValue.insert(outValue.end(), bytes, bytes + sizeof(T));
+    }
+    static void AppendValue(std::vector<uint8_t> &outValue, const std::string &value)
+    {
+        outValue.insert(outValue.end(), value.begin(), value.end());
+    }
+    static void AppendValue(std::vector<uint8_t> &outValue, const StringAtom &value)
+    {
+        std::string_view text = value.GetView();
+        outValue.insert(outValue.end(), text.begin(), text.end());
+    }
+
+    template <typename T>
+    static bool ReadValue(const uint8_t *value, size_t size, T &outValue)
+    {
+        if (size != sizeof(T))
+            return false;
+        std::memcpy(&outValue, value, sizeof(T));
+        return true;
+    }
+    static bool ReadValue(const uint8_t *value, size_t size, std::string &outValue)
+    {
+        outValue.assign(reinterpret_cast<const char *>(value), size);
+        return true;
+    }
+    static bool ReadValue(const uint8_t *value, size_t size, StringAtom &outValue)
+    {
+        outValue = std::string_view(reinterpret_cast<const char *>(value), size);
+        return true;
+    }
+
+    template <typename T>
+    static bool ValuesEqual(const T &a, const T &b)
+    {
+        if constexpr (std::is_array<T>::value)
+            return std::equal(std::begin(a), std::end(a), std::begin(b));
+        else
+            return a == b;
+    }
+
+    template <typename T>
+    static void AssignValue(T &target, const T &value)
+    {
+        if constexpr (std::is_array<T>::value)
+            std::copy(std::begin(value), std::end(value), std::begin(target));
+        else
+            target = value;
+    }
+
+    // Writing goes through the setter, or into the member followed by its hook
+    template <typename Class, typename Field>
+    static void SetField(Class &object, const Field &field, const typename Field::ValueType &value)
+    {
+        if constexpr (HasSetter<Field>(0))
+        {
+            field.Set(object, value);
+        }
+        else
+        {
+            AssignValue(field.GetMutable(object), value);
+            if (field.HasHook() && !(field.flags & FieldHookOnEdit))
+                field.RunHook(object);
+        }
+    }
+
+    template <typename Field>
+    static constexpr bool HasSetter(decltype(&Field::Set)) { return true; }
+    template <typename Field>
+    static constexpr bool HasSetter(...) { return false; }
+
+    template <typename Class, typename Field>
+    static void RenderField(Class &object, const Field &field)
+    {
+        using T = typename Field::ValueType;
+        const FieldUi &ui = field.ui;
+        if (ui.widget == FieldWidget::Hidden)
+            return;
+
+        ImGui::PushID(static_cast<int>(field.property));
+
+        // Checkboxes carry their own label, everything else is labelled on the left
+        if (ui.widget != FieldWidget::Checkbox)
+        {
+            ImGui::Text("%s", field.label);
+            ImGui::SameLine(100);
+        }
+
+        T value;
+        AssignValue(value, field.Get(object));
+        bool edited = false;
+        if constexpr (std::is_same<T, std::string>::value)
+        {
+            if (ui.widget == FieldWidget::Text)
+            {
+                char buffer[256];
+                std::snprintf(buffer, sizeof(buffer), "%s", value.c_str());
+                if (ImGui::InputText("##Value", buffer, sizeof(buffer)))
+                {
+                    value = buffer;
+                    edited = true;
+                }
+            }
+            else
+            {
+                ImGui::Text("%s", value.empty() ? "None" : value.c_str());
+            }
+        }
+        else if constexpr (std::is_same<T, int>::value)
+        {
+            edited = ImGui::InputInt("##Value", &value);
+        }
+        else if constexpr (std::is_same<T, bool>::value)
+        {
+            edited = ImGui::Checkbox(field.label, &value);
+        }
+        else if constexpr (std::is_same<T, float>::value)
+        {
+            if (ui.widget == FieldWidget::Slider)
+                edited = ImGui::SliderFloat("##Value", &value, ui.min, ui.max, ui.format);
+            else
+                edited = ImGui::InputFloat("##Value", &value, ui.step, ui.fastStep, ui.format);
+        }
+        else if constexpr (std::is_same<T, float[3]>::value)
+        {
+            if (ui.widget == FieldWidget::Color3)
+            {
+                edited = ImGui::ColorEdit3("##Value", value);
+            }
+            else
+            {
+                ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+                edited = ImGui::InputFloat3("##Value", value);
+                ImGui::PopItemWidth();
+            }
+        }
+        else if constexpr (std::is_same<T, float[4]>::value)
+        {
+            edited = ImGui::ColorEdit4("##Value", value);
+        }
+        else
+        {
+            static_assert(std::is_same<T, StringAtom>::value, "No inspector widget for this field type");
+            ImGui::Text("%s", value.c_str());
+        }
+
+        if (edited)
+        {
+            SetField(object, field, value);
+            if constexpr (!HasSetter<Field>(0))
+            {
+                if (field.HasHook() && (field.flags & FieldHookOnEdit))
+                    field.RunHook(object);
+            }
+        }
+        ImGui::PopID();
+    }
+};
+
+/**
+ * @brief Base that implements Node's property interface from a class's NodeFields
+ *
+ * A node class derives through it instead of from its base directly:
+ *
+ *     class Sprite : public ReflectedNode<Sprite, Node2D>
+ *
+ * Base must be the class's NodeFields Base. Constructors are inherited, so
+ * the class initializes ReflectedNode with its base's arguments.
+ */
+template <typename Derived, typename Base>
+class ReflectedNode : public Base
+{
+public:
+    using Base::Base;
+
+    bool GetProperty(NodeProperty property, std::vector<uint8_t> &outValue) const override
+    {
+        static_assert(std::is_same<Base, typename NodeFields<Derived>::Base>::value, "ReflectedNode's Base must match NodeFields<Derived>::Base");
+        return NodeReflection::GetProperty(Self(), property, outValue);
+    }
+
+    bool SetProperty(NodeProperty property, const uint8_t *value, size_t size) override
+    {
+        return NodeReflection::SetProperty(Self(), property, value, size);
+    }
+
+    void CopyProperties(const Node &source) override
+    {
+        NodeReflection::CopyFrom(Self(), source);
+    }
+
+    void DiffProperties(const Node &other, std::vector<NodeProperty> &outChanged) const override
+    {
+        NodeReflection::DiffFrom(Self(), other, outChanged);
+    }
+
+    void RenderInspectorProperties() override
+    {
+        NodeReflection::RenderInspector(Self());
+    }
+
+    const std::vector<PropertyInfo> &GetPropertyInfos() const override
+    {
+        return NodeReflection::GetPropertyInfos<Derived>();
+    }
+
+private:
+    Derived &Self() { return static_cast<Derived &>(*this); }
+    const Derived &Self() const { return static_cast<const Derived &>(*this); }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Node.h"
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Everything the editor needs to know about a node type
+ */
+struct NodeTypeInfo
+{
+    const char *name;     // Shown in menus and written to text scenes
+    const char *baseName; // Prefix of generated node names
+    const char *icon;     // Font Awesome glyph, UTF-8
+    bool creatable;       // Offered in the Add Node menus
+    std::shared_ptr<Node> (*create)(const StringAtom &name, NodeType type, bool is3D);
+};
+
+/**
+ * @brief Registration of a node type, specialized once per NodeType
+ *
+ * Each node class registers the type it implements next to its declaration:
+ *
+ *     template <>
+ *     struct NodeTypeRegistration<NodeType::Sprite>
+ *     {
+ *         static constexpr NodeTypeInfo Info = {"Sprite", "Sprite", "\xef\x83\x87", true,
+ *                                               &CreateRegisteredNode<Sprite>};
+ *     };
+ *
+ * NodeTypeRegistry gathers the specializations into a constexpr table
+ * indexed by NodeType, so a type without one fails to compile.
+ */
+template <NodeType Type>
+struct NodeTypeRegistration;
+
+// Default factory - T3D is created instead of T while the editor is in 3D mode
+template <typename T, typename T3D = T>
+std::shared_ptr<Node> CreateRegisteredNode(const StringAtom &name, NodeType type, bool is3D)
+{
+    if (!std::is_same<T, T3D>::value && is3D)
+        return CreateRegisteredNode<T3D>(name, type, false);
+
+    if constexpr (std::is_constructible<T, StringAtom, NodeType>::value)
+        return std::make_shared<T>(name, type);
+    else
+        return std::make_shared<T>(name);
+}
+
+/**
+ * @brief Lookup of node types, each one a single array access
+ */
+class NodeTypeRegistry
+{
+public:
+    // Unknown types get a placeholder entry that creates plain nodes
+    static const NodeTypeInfo &Get(NodeType type);
+
+    // Types offered in the Add Node menus, in enum order
+    static const std::vector<NodeType> &GetCreatableTypes();
+
+    static std::shared_ptr<Node> Create(NodeType type, const StringAtom &name, bool is3D);
+
+    // Find a type by its registered name, false if there is none
+    static bool FindByName(const char *name, size_t length, NodeType &outType);
+};
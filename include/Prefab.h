@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Node.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Immutable template subtree shared by every instance placed from it
+ *
+ * Creating a prefab copies a subtree once; the copy is detached from the
+ * scene, its root is moved to the origin and its nodes must not be modified
+ * afterwards. Instances (see PrefabInstance) hold a reference to the prefab
+ * instead of their own nodes, so placing one costs a single node no matter
+ * how large the template is. The template's nodes keep their world
+ * transforms relative to the template root, ready to be composed with an
+ * instance's transform when it is drawn.
+ */
+class Prefab
+{
+public:
+    // Copy the subtree under source into a new template
+    static std::shared_ptr<const Prefab> Create(const Node *source);
+
+    // Make a detached tree the template itself, for loaders that build the tree anyway
+    static std::shared_ptr<const Prefab> Adopt(std::shared_ptr<Node> root);
+
+    // Copy a node and its children, classes and properties included
+    static std::shared_ptr<Node> CloneTree(const Node *source);
+
+    // Copy a single node without its children
+    static std::shared_ptr<Node> CloneNode(const Node *source);
+
+    // Prefabs instanced under root, inside other prefabs too, each listed after the prefabs its template instances
+    static void CollectPrefabs(const Node *root, std::vector<const Prefab *> &outPrefabs);
+
+    const StringAtom &GetName() const;
+    const std::shared_ptr<Node> &GetRoot() const;
+
+    // Template nodes depth-first, the root first
+    const std::vector<Node *> &GetNodes() const;
+
+    // Index of each template node's parent in GetNodes(), NoParent for the root
+    const std::vector<uint32_t> &GetParents() const;
+    static constexpr uint32_t NoParent = 0xFFFFFFFFu;
+
+    // Bounds of the whole template relative to its root
+    void GetLocalBounds(float outMin[2], float outMax[2]) const;
+
+private:
+    Prefab() = default;
+
+    std::shared_ptr<Node> root;
+    std::vector<Node *> nodes;
+    std::vector<uint32_t> parents;
+    float boundsMin[2] = {0.0f, 0.0f};
+    float boundsMax[2] = {0.0f, 0.0f};
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Forward declaration
+class Node;
+
+/**
+ * @brief A single draw submitted to a render queue
+ */
+struct RenderItem
+{
+    uint64_t sortKey; // Packed sort key, see RenderQueue::MakeKey
+    Node *node;       // Node that issued the draw
+    uint32_t origin;  // Where the node is drawn, see RenderQueue::SetOrigin
+};
+
+/**
+ * @brief Collects the draws of a frame and orders them by a packed 64-bit key
+ *
+ * Every draw is reduced to a single 64-bit key so ordering is one radix sort
+ * instead of a multi-field comparison sort. The key layout depends on the
+ * queue's sort mode:
+ *
+ *   Opaque (state-sorted):      layer:8 | zIndex:16 | pipeline:8 | texture:16 | depth:16
+ *   Transparent (depth-sorted): layer:8 | zIndex:16 | depth:20   | pipeline:4 | texture:16
+ *
+ * Opaque queues group draws by pipeline and texture to minimise state changes,
+ * transparent queues keep strict depth (y-sort) order within a z-index.
+ * Texture ids keep all 16 bits in both layouts. Pipelines drawn in transparent
+ * queues must be below TransparentPipelineCount, a larger id would alias
+ * another pipeline.
+ */
+class RenderQueue
+{
+public:
+    enum class SortMode
+    {
+        Opaque,
+        Transparent
+    };
+
+    // Unpacked draw state used to build a sort key
+    struct DrawState
+    {
+        uint8_t layer = 0;     // Canvas layer, drawn in ascending order
+        int16_t zIndex = 0;    // Z-index within the layer
+        float depth = 0.0f;    // Y-sort / depth value, drawn in ascending order
+        uint8_t pipeline = 0;  // Pipeline (shader and blend state) identifier
+        uint16_t texture = 0;  // Texture identifier
+    };
+
+    // Pipeline ids that fit the transparent key
+    static constexpr uint8_t TransparentPipelineCount = 16;
+
+    // Draws of nodes placed somewhere other than their own world transform, like a prefab's shared
+    // nodes drawn once per instance, carry an index into the caller's table of placements
+    static constexpr uint32_t NoOrigin = 0xFFFFFFFFu;
+
+    RenderQueue(SortMode mode = SortMode::Opaque);
+    ~RenderQueue();
+
+    // Queue management
+    void Clear();
+    void Reserve(size_t count);
+    void Submit(const DrawState &state, Node *node);
+    void Submit(uint64_t sortKey, Node *node);
+
+    // Tag the following submissions, until the next call or Clear
+    void SetOrigin(uint32_t origin);
+
+    // Order the submitted draws by their sort keys
+    void Sort();
+
+    const std::vector<RenderItem> &GetItems() const;
+    size_t GetSize() const;
+    SortMode GetSortMode() const;
+    void SetSortMode(SortMode mode);
+
+    // Key packing
+    uint64_t MakeKey(const DrawState &state) const;
+    static uint64_t MakeOpaqueKey(const DrawState &state);
+    static uint64_t MakeTransparentKey(const DrawState &state);
+
+private:
+    SortMode sortMode;
+    uint32_t currentOrigin = NoOrigin;
+    std::vector<RenderItem> items;
+    std::vector<RenderItem> scratch; // Reused ping-pong buffer for the radix sort
+};
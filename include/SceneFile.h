@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Node.h"
+#include "Prefab.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Binary scene format loaded straight from a memory mapping
+ *
+ * A scene file is a header followed by three sections: a table of fixed-size
+ * node records in depth-first order, the property lists the records point
+ * to, and a string table. Sections and records are aligned so the mapped
+ * bytes are used in place as arrays of structs, and loading is a single walk
+ * over the node table constructing each node from its record, with nothing
+ * to parse. Parents always come before their children, so a record only
+ * stores its parent's index.
+ *
+ * A record holds what every node has, its name, transform and flags. Every
+ * other property of the node's class is written from its reflected fields
+ * as a property id and the value's bytes, encoded like Node::GetProperty and
+ * kept in the string table, so adding a field to a class needs no change
+ * here. Values are stored in the host's byte order.
+ *
+ * Each prefab the scene instances is written once, as a tree of its own
+ * after the scene's records, and listed in a prefab table. An instance's
+ * record refers to its prefab by table index and lists its overrides
+ * instead of holding the template's nodes. A prefab only instances prefabs
+ * listed before it, so they are built in table order ahead of the scene.
+ */
+class SceneFile
+{
+public:
+    static constexpr uint32_t Version = 3;
+    static constexpr uint32_t NoParent = 0xFFFFFFFFu;
+
+    // Concrete node class, the node type alone doesn't tell a 2D camera from a 3D one
+    enum class NodeClass : uint16_t
+    {
+        Node,
+        Node2D,
+        Sprite,
+        Light2D,
+        Label,
+        Camera2D,
+        Camera3D,
+        PrefabInstance,
+        Count
+    };
+
+    // Record flags
+    static constexpr uint32_t FlagExpanded = 1u << 0;
+    static constexpr uint32_t FlagCacheAsBitmap = 1u << 1;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t nodeCount; // Records of the scene's own tree
+        uint64_t nodeTableOffset;
+        uint64_t payloadOffset;
+        uint64_t payloadSize;
+        uint64_t stringTableOffset;
+        uint64_t stringTableSize;
+        uint64_t prefabTableOffset;
+        uint32_t prefabCount;
+        uint32_t prefabNodeCount; // Template records, stored after the scene's
+        uint64_t reserved;
+    };
+
+    // Slice of the string table, strings are also zero terminated
+    struct StringRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct NodeRecord
+    {
+        uint32_t parent; // Index of the parent record, NoParent for the root
+        uint32_t childCount;
+        uint16_t type;      // NodeType
+        uint16_t nodeClass; // NodeClass
+        uint32_t flags;
+        StringRef name;
+        uint32_t payloadOffset; // Property list, relative to the payload section
+        uint32_t payloadSize;
+        float position[3];
+        float rotation[3];
+        float scale[3];
+        uint32_t prefab;         // Prefab table index of a PrefabInstance
+        uint32_t overrideOffset; // Override list of a PrefabInstance, relative to the payload section
+        uint32_t overrideCount;
+    };
+
+    // One entry of a node's property list
+    struct PropertyRecord
+    {
+        uint32_t property; // NodeProperty
+        StringRef value;   // Value bytes
+    };
+
+    // One entry of a prefab instance's override list
+    struct OverrideRecord
+    {
+        uint32_t nodeIndex; // Template node, depth-first like Prefab::GetNodes()
+        uint32_t property;  // NodeProperty
+        StringRef value;    // Value bytes
+    };
+
+    // A prefab's template tree in the node table, root first
+    struct PrefabRecord
+    {
+        uint32_t firstNode;
+        uint32_t nodeCount;
+    };
+
+    // Write the tree under root, returns false if the file couldn't be written
+    static bool Save(const Node *root, const std::string &path);
+
+    // Map a scene file and build its tree, returns null if the file is missing or malformed
+    static std::shared_ptr<Node> Load(const std::string &path);
+
+    /**
+     * @brief Builds the tree of a scene image a batch of nodes at a time
+     *
+     * Open only checks the image and creates no nodes, so it may run on a
+     * worker thread. Build then constructs nodes in file order on the thread
+     * that owns the scene. A node whose parent was built by an earlier call
+     * is attached with AddChild, so once the root is in a live tree each
+     * batch shows up there as it is built. The first call also builds every
+     * prefab whole, they never enter the live tree. The image must outlive
+     * the loader.
+     */
+    class Loader
+    {
+    public:
+        bool Open(const uint8_t *data, uint64_t size, const std::string &path);
+
+        // Build up to maxNodes more nodes, returns false if a record doesn't describe a valid node
+        bool Build(uint32_t maxNodes);
+
+        bool IsComplete() const;
+        const std::shared_ptr<Node> &GetRoot() const;
+        uint32_t GetNodeCount() const;
+
+    private:
+        bool BuildPrefabs();
+
+        std::string path;
+        const NodeRecord *records = nullptr;
+        const PrefabRecord *prefabRecords = nullptr;
+        uint32_t prefabCount = 0;
+        std::vector<std::shared_ptr<const Prefab>> prefabs;
+        uint32_t nodeCount = 0;
+        uint32_t builtCount = 0;
+        const uint8_t *payloads = nullptr;
+        uint64_t payloadSize = 0;
+        const char *strings = nullptr;
+        uint64_t stringTableSize = 0;
+        std::vector<Node *> nodes;
+        std::shared_ptr<Node> root;
+    };
+
+    // Node classes a scene can hold, shared with the text scene format. Prefab instances are
+    // constructed with their prefab, CreateNode makes only the other classes.
+    static NodeClass GetNodeClass(const Node *node);
+    static const char *GetNodeClassName(NodeClass nodeClass);
+    static bool FindNodeClass(const char *name, size_t length, NodeClass &outClass);
+    static std::shared_ptr<Node> CreateNode(NodeClass nodeClass, const StringAtom &name, NodeType type);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A positioned glyph of laid-out text
+ *
+ * Positions are in text space (origin at the top-left of the first line,
+ * y pointing down) and texture coordinates address the font's SDF atlas.
+ */
+struct GlyphQuad
+{
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+};
+
+/**
+ * @brief Signed-distance-field glyph atlas for a font
+ *
+ * Glyphs are rasterized once as distance fields at a fixed base size and
+ * packed into a single 8-bit atlas. Distance fields scale cleanly, so one
+ * atlas serves every font size and all labels using the font share it
+ * through Get().
+ */
+class SdfFontAtlas
+{
+public:
+    // Base rasterization size and distance field spread, in atlas pixels
+    static constexpr float BasePixelHeight = 32.0f;
+    static constexpr int Padding = 4;
+
+    ~SdfFontAtlas();
+
+    // Shared atlas for a font file, generated on first use. Returns nullptr if the font can't be loaded.
+    static std::shared_ptr<SdfFontAtlas> Get(const std::string &fontPath);
+
+    // A font that failed to load isn't read again until this is called for it
+    static void ForgetFailure(const std::string &fontPath);
+
+    // Lay out a string at the given font size
+    void LayoutText(const std::string &text, float fontSize, std::vector<GlyphQuad> &outQuads,
+                    float outMin[2], float outMax[2]) const;
+
+    // Atlas image
+    const std::vector<uint8_t> &GetPixels() const;
+    int GetWidth() const;
+    int GetHeight() const;
+
+    // Identifier used to batch draws that sample this atlas
+    uint16_t GetAtlasId() const;
+    const std::string &GetFontPath() const;
+    float GetLineHeight(float fontSize) const;
+
+private:
+    SdfFontAtlas();
+    bool Load(const std::string &fontPath);
+
+    struct Glyph
+    {
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+        float offsetX = 0.0f, offsetY = 0.0f; // Quad offset from the pen position
+        float width = 0.0f, height = 0.0f;    // Quad size
+        float advance = 0.0f;
+    };
+
+    // Printable ASCII
+    static constexpr int FirstCodepoint = 32;
+    static constexpr int LastCodepoint = 126;
+
+    std::string fontPath;
+    uint16_t atlasId = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+    Glyph glyphs[LastCodepoint - FirstCodepoint + 1];
+    float ascent = 0.0f;
+    float lineHeight = 0.0f;
+
+    // Kerning, indexed by [left - FirstCodepoint][right - FirstCodepoint]
+    std::vector<float> kerning;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Set of selected nodes, stored by instance id
+ *
+ * Membership is a bitset indexed by instance id, so testing a node is a
+ * single bit lookup, and the ids are also kept in a dense list for
+ * iteration. Ids are never reused, and the set listens for destroyed nodes
+ * on the NodeChangeBus and drops their ids at the next flush, so it never
+ * holds ids that no longer resolve. The most recently added id is the
+ * primary selection shown in the inspector and used as the gizmo anchor.
+ */
+class SelectionSet
+{
+public:
+    SelectionSet();
+    ~SelectionSet();
+
+    // Owns a bus subscription bound to this instance
+    SelectionSet(const SelectionSet &) = delete;
+    SelectionSet &operator=(const SelectionSet &) = delete;
+
+    // Returns false if the id was already selected
+    bool Add(uint32_t id);
+    bool Remove(uint32_t id);
+    void Toggle(uint32_t id);
+    void Clear();
+
+    bool Contains(uint32_t id) const;
+    bool IsEmpty() const;
+    size_t GetSize() const;
+    const std::vector<uint32_t> &GetIds() const;
+
+    // Last id added, 0 when the selection is empty
+    uint32_t GetPrimary() const;
+
+    // Bumped on every change, lets views cache what they derive from the selection
+    uint32_t GetVersion() const;
+
+private:
+    std::vector<uint64_t> bits;
+    std::vector<uint32_t> ids;
+    uint32_t primary = 0;
+    uint32_t version = 0;
+    uint32_t changeSubscription = 0;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+// Forward declaration
+class Node;
+
+/**
+ * @brief Loose uniform grid over node world bounds
+ *
+ * Each node is stored once, in the cell that contains the centre of its
+ * bounds. Cells are "loose": a node may overhang its cell by up to half a
+ * cell, so queries are expanded by that amount instead of inserting nodes
+ * into every cell they touch. Nodes larger than a cell are kept in a
+ * separate oversized list. Moving a node within its cell only rewrites its
+ * bounds, so per-frame updates cost time proportional to the nodes that moved.
+ */
+class SpatialGrid2D
+{
+public:
+    explicit SpatialGrid2D(float cellSize = 256.0f);
+    ~SpatialGrid2D();
+
+    // Insert a node or move it to its new bounds
+    void Update(Node *node, const float boundsMin[2], const float boundsMax[2]);
+    void Remove(Node *node);
+    void Clear();
+
+    // Append every node whose bounds overlap the given rectangle
+    void Query(const float boundsMin[2], const float boundsMax[2], std::vector<Node *> &outNodes) const;
+
+    bool Contains(const Node *node) const;
+    size_t GetSize() const;
+    float GetCellSize() const;
+
+private:
+    struct Entry
+    {
+        Node *node = nullptr;
+        float boundsMin[2] = {0.0f, 0.0f};
+        float boundsMax[2] = {0.0f, 0.0f};
+        uint64_t cellKey = 0; // Unused while oversized, every packed value is a real cell
+        uint32_t slotInCell = 0;
+        bool oversized = false; // Too large for the loose cells, kept in the oversized list
+    };
+
+    // Returns false for nodes too large for the loose cells
+    bool ComputeCellKey(const float boundsMin[2], const float boundsMax[2], uint64_t &outCellKey) const;
+    static uint64_t PackCell(int32_t cellX, int32_t cellY);
+    std::vector<uint32_t> &GetCellEntries(const Entry &entry);
+    void Link(uint32_t entryIndex, bool oversized, uint64_t cellKey);
+    void Unlink(uint32_t entryIndex);
+    void QueryCell(const std::vector<uint32_t> &cellEntries, const float boundsMin[2], const float boundsMax[2],
+                   std::vector<Node *> &outNodes) const;
+
+    float cellSize;
+    float inverseCellSize;
+
+    // Entry storage with a free list so slots are reused
+    std::vector<Entry> entries;
+    std::vector<uint32_t> freeEntries;
+    std::unordered_map<const Node *, uint32_t> entryLookup;
+
+    // Cell contents, keyed by packed cell coordinates
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+    std::vector<uint32_t> oversizedEntries;
+};
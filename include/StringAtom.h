@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Interned string, stored as a 32-bit index into a global table
+ *
+ * Every distinct string is stored once, so an atom is four bytes, copies
+ * without allocating, and compares and hashes by id. Creating an atom from
+ * text looks the text up in the table and only allocates the first time
+ * that text is seen; Find looks it up without adding it. The empty string
+ * is always atom 0.
+ *
+ * Atoms are reference counted. When the last atom for a string goes away
+ * the string leaves the table and its id and storage are reused, so the
+ * unique names of nodes that come and go, like streamed world cells, don't
+ * accumulate over a long session. Copying an atom only bumps a counter.
+ *
+ * Like the node registries, the table is only used from the main thread.
+ */
+class StringAtom
+{
+public:
+    StringAtom() = default;
+    StringAtom(const char *text);
+    StringAtom(const std::string &text);
+    StringAtom(std::string_view text);
+
+    StringAtom(const StringAtom &other) : id(other.id) { Retain(id); }
+    StringAtom(StringAtom &&other) noexcept : id(other.id) { other.id = 0; }
+    ~StringAtom() { Release(id); }
+
+    StringAtom &operator=(const StringAtom &other)
+    {
+        Retain(other.id);
+        Release(id);
+        id = other.id;
+        return *this;
+    }
+
+    StringAtom &operator=(StringAtom &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Release(id);
+            id = other.id;
+            other.id = 0;
+        }
+        return *this;
+    }
+
+    // The atom for text if it has been interned, the empty atom otherwise
+    static StringAtom Find(std::string_view text);
+
+    uint32_t GetId() const { return id; }
+    bool IsEmpty() const { return id == 0; }
+
+    // Interned text, null-terminated and valid while the atom, or another for the same text, exists
+    const char *c_str() const;
+    std::string_view GetView() const;
+    size_t GetLength() const;
+
+    bool operator==(const StringAtom &other) const { return id == other.id; }
+    bool operator!=(const StringAtom &other) const { return id != other.id; }
+
+    // Alphabetical order, for sorted listings - ids only reflect interning order
+    struct TextLess
+    {
+        bool operator()(const StringAtom &a, const StringAtom &b) const { return a.id != b.id && a.GetView() < b.GetView(); }
+    };
+
+    // Table statistics, the count is of strings currently interned
+    static size_t GetAtomCount();
+    static size_t GetMemoryUsage();
+
+private:
+    // The empty atom isn't counted
+    static void Retain(uint32_t id)
+    {
+        if (id != 0)
+            AddReference(id);
+    }
+    static void Release(uint32_t id)
+    {
+        if (id != 0)
+            RemoveReference(id);
+    }
+    static void AddReference(uint32_t id);
+    static void RemoveReference(uint32_t id);
+
+    uint32_t id = 0;
+};
+
+namespace std
+{
+    template <>
+    struct hash<StringAtom>
+    {
+        size_t operator()(const StringAtom &atom) const { return atom.GetId(); }
+    };
+}
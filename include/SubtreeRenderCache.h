@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "imgui.h"
+
+// Forward declaration
+class Node;
+
+/**
+ * @brief Retained drawing of "cache as bitmap" subtrees
+ *
+ * A cached subtree is drawn once while its output is recorded, then replayed
+ * as a single block of geometry on later frames. The recording is stored
+ * relative to the subtree root, so moving the root or panning the view only
+ * offsets it; a new node version, zoom, rotation or scale requires a fresh
+ * recording. Recordings are evicted least recently used first to stay
+ * within the memory budget.
+ */
+class SubtreeRenderCache
+{
+public:
+    // Everything a recording depends on besides the root's position
+    struct CacheKey
+    {
+        uint32_t version = 0;
+        float zoom = 1.0f;
+        float rotation = 0.0f;
+        float scale[2] = {1.0f, 1.0f};
+    };
+
+    explicit SubtreeRenderCache(size_t budgetBytes = 16 * 1024 * 1024);
+    ~SubtreeRenderCache();
+
+    // Replay a valid recording at the root's current screen position, returns false if it must be re-recorded
+    bool Draw(ImDrawList *drawList, const Node *root, const CacheKey &key, ImVec2 origin);
+
+    // Record everything drawn between the two calls as the root's cached drawing.
+    // Recordings of subtrees that were partly clipped can't be moved, only replayed in place.
+    void BeginRecord(ImDrawList *drawList);
+    void EndRecord(ImDrawList *drawList, const Node *root, const CacheKey &key, ImVec2 origin, bool movable);
+
+    void Remove(const Node *root);
+    void Clear();
+
+    // Advance the frame counter used for eviction
+    void NextFrame();
+
+    void SetBudget(size_t budgetBytes);
+    size_t GetBudget() const;
+    size_t GetMemoryUsage() const;
+    size_t GetEntryCount() const;
+
+private:
+    struct Entry
+    {
+        CacheKey key;
+        ImVec2 origin;
+        bool movable = true;
+        std::vector<ImDrawVert> vertices;
+        std::vector<ImDrawIdx> indices;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static size_t GetEntryBytes(const Entry &entry);
+    static bool KeysMatch(const CacheKey &a, const CacheKey &b);
+    void EvictToBudget(const Node *keep);
+
+    std::unordered_map<const Node *, Entry> entries;
+    size_t budgetBytes;
+    size_t memoryUsage = 0;
+    uint64_t frame = 0;
+
+    // Draw list state at BeginRecord
+    int recordVertexStart = 0;
+    int recordIndexStart = 0;
+    int recordCommandCount = 0;
+    unsigned int recordVertexBase = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Node.h"
+#include <memory>
+#include <string>
+
+/**
+ * @brief Human-readable JSON scene format meant to live in source control
+ *
+ * Each node is an object with one property per line and its children nested
+ * in a "children" array, so edits show up as small line diffs. The "class"
+ * key must come first in a node object: the node is constructed as soon as
+ * it is read and every following property is applied to it directly while
+ * the file streams through a SAX parser, without building a document tree.
+ * Unknown keys are skipped so older builds can open newer files. Node
+ * properties are written and read through the class's reflected fields, so
+ * a new field shows up in text scenes without a change here.
+ *
+ * Prefabs the scene instances are written once each in a "prefabs" array
+ * ahead of the root. An instance names its prefab by index right after its
+ * class and lists its changes in an "overrides" array, one object per
+ * changed template node, instead of repeating the template's nodes.
+ *
+ * Cooked builds should load the binary form instead, see SceneFile.
+ */
+class TextSceneFile
+{
+public:
+    static constexpr int Version = 1;
+
+    // Write the tree under root, returns false if the file couldn't be written
+    static bool Save(const Node *root, const std::string &path);
+
+    // Parse a text scene and build its tree, returns null if the file is missing or malformed
+    static std::shared_ptr<Node> Load(const std::string &path);
+
+    // Parse a text scene from memory, path is only used in error messages
+    static std::shared_ptr<Node> Parse(const char *data, size_t size, const std::string &path);
+
+    // Load a text scene and write it back as a binary scene file
+    static bool ConvertToBinary(const std::string &textPath, const std::string &binaryPath);
+
+    // Text scenes are told apart from binary ones by their .json extension
+    static bool IsTextScenePath(const std::string &path);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Screen-space tiled light assignment for 2D point lights
+ *
+ * The viewport is split into square tiles and each light is binned into the
+ * tiles its radius overlaps. Per-tile light lists are stored compactly
+ * (offsets plus one shared index array), so shading a tile only evaluates
+ * the lights that can reach it and the cost depends on the lights per tile
+ * rather than the total number of lights.
+ */
+class TiledLightCuller
+{
+public:
+    struct Light
+    {
+        float position[2] = {0.0f, 0.0f}; // Screen-space centre in pixels
+        float radius = 0.0f;              // Screen-space radius in pixels
+        float color[3] = {1.0f, 1.0f, 1.0f};
+        float energy = 1.0f;
+    };
+
+    explicit TiledLightCuller(float tileSize = 32.0f);
+    ~TiledLightCuller();
+
+    // Start a new frame for a viewport of the given size
+    void Begin(float viewportWidth, float viewportHeight);
+    void AddLight(const Light &light);
+
+    // Bin the submitted lights into tiles
+    void Cull();
+
+    // Per-tile results, valid after Cull
+    int GetTileCountX() const;
+    int GetTileCountY() const;
+    float GetTileSize() const;
+    size_t GetLightCount() const;
+    const uint32_t *GetTileLights(int tileX, int tileY, uint32_t &outCount) const;
+
+    // Accumulated light color at a screen-space point inside the given tile
+    void EvaluateTile(int tileX, int tileY, float x, float y, float outColor[3]) const;
+
+private:
+    // Tile rectangle covered by a light, empty when off screen
+    bool GetTileRange(const Light &light, int &minX, int &minY, int &maxX, int &maxY) const;
+    bool OverlapsTile(const Light &light, int tileX, int tileY) const;
+
+    float tileSize;
+    float viewportWidth = 0.0f;
+    float viewportHeight = 0.0f;
+    int tileCountX = 0;
+    int tileCountY = 0;
+
+    std::vector<Light> lights;
+
+    // Lights of tile i are tileLightIndices[tileOffsets[i] .. tileOffsets[i + 1])
+    std::vector<uint32_t> tileOffsets;
+    std::vector<uint32_t> tileLightIndices;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Node.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Bounded undo/redo history of node property edits
+ *
+ * An edit is captured with a Recording: the properties it may touch are
+ * snapshotted when it begins, and on commit only the ones whose value
+ * actually changed are kept, as an old/new byte pair per property. Nodes
+ * are referenced by instance id, so an entry never keeps a node alive and
+ * entries touching deleted nodes simply skip them.
+ *
+ * A recording stays open for as long as the edit lasts, so a whole gizmo
+ * drag or a held slider collapses into a single entry no matter how many
+ * frames it spans. Entries live in a fixed ring of slots and the oldest
+ * are evicted once either the slot count or the memory budget is exceeded.
+ */
+class UndoJournal
+{
+public:
+    /**
+     * @brief Before-values of the properties an edit in progress may change
+     */
+    class Recording
+    {
+    public:
+        void Begin(const std::string &label);
+        void Track(const Node *node, NodeProperty property);
+        void TrackAll(const Node *node);
+        void Cancel();
+        bool IsActive() const;
+
+    private:
+        friend class UndoJournal;
+
+        struct Snapshot
+        {
+            uint32_t nodeId;
+            NodeProperty property;
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        std::string label;
+        std::vector<Snapshot> snapshots;
+        std::vector<uint8_t> values;
+        bool active = false;
+    };
+
+    explicit UndoJournal(size_t capacity = 256, size_t memoryBudget = 16 * 1024 * 1024);
+    ~UndoJournal();
+
+    // Close a recording, returns false (and pushes nothing) if no tracked property changed
+    bool Commit(Recording &recording);
+
+    bool Undo();
+    bool Redo();
+    bool CanUndo() const;
+    bool CanRedo() const;
+    const std::string &GetUndoLabel() const;
+    const std::string &GetRedoLabel() const;
+
+    void Clear();
+    size_t GetMemoryUsage() const;
+
+private:
+    struct Delta
+    {
+        uint32_t nodeId;
+        NodeProperty property;
+        uint32_t offset; // Old value, immediately followed by the new one
+        uint32_t oldSize;
+        uint32_t newSize;
+    };
+
+    struct Entry
+    {
+        std::string label;
+        std::vector<Delta> deltas;
+        std::vector<uint8_t> data;
+
+        size_t GetMemoryUsage() const;
+    };
+
+    // Entries in history order, 0 is the oldest
+    Entry &GetEntry(size_t index);
+    const Entry &GetEntry(size_t index) const;
+    void Push(Entry &&entry);
+    void EvictOldest();
+    void Apply(const Entry &entry, bool undo);
+
+    std::vector<Entry> slots;
+    size_t head = 0;   // Slot of the oldest entry
+    size_t count = 0;  // Entries stored
+    size_t cursor = 0; // Entries that can be undone, the rest can be redone
+    size_t memoryUsage = 0;
+    size_t memoryBudget;
+
+    // Current values read back while committing
+    std::vector<uint8_t> scratch;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "SceneFile.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Forward declaration
+class Node;
+
+/**
+ * @brief Streams a world split into square cells in and out around a focus point
+ *
+ * Each cell is a binary scene file holding the top-level nodes whose origin
+ * falls inside it. Cells within the load radius of the focus are read and
+ * checked on a worker thread, then built on the calling thread a batch of
+ * nodes at a time within a per-frame time budget, attaching to the live
+ * tree as they go. Cells are only dropped once they are past the larger
+ * unload radius, so moving back and forth over a cell border doesn't reload
+ * it, and dropped cells are destroyed in slices as well. When the estimated
+ * memory of the loaded cells would exceed the budget, the farthest cells that
+ * are no longer needed are dropped first and far cells aren't loaded at all.
+ */
+class WorldPartition
+{
+public:
+    struct Settings
+    {
+        float cellSize = 2048.0f;
+        float loadRadius = 3072.0f;
+        float unloadRadius = 4096.0f;          // Must be larger than loadRadius
+        size_t memoryBudget = 512 * 1024 * 1024; // Estimated bytes of loaded cells
+        double frameBudgetMs = 2.0;            // Time spent building and destroying nodes per Update
+    };
+
+    WorldPartition();
+    ~WorldPartition();
+
+    // Write each top-level child of root into the cell file containing its position
+    static bool Export(const Node *root, const std::string &directory, float cellSize);
+
+    // Find the cell files in a directory, streaming starts with the next Update
+    bool Open(const std::string &directory, const Settings &settings);
+
+    // Detach every cell from the tree and forget the world
+    void Close();
+    bool IsOpen() const;
+
+    // Stream cells around a point, loaded cells are attached under worldRoot
+    void Update(Node *worldRoot, float focusX, float focusY);
+
+    // True while cells are being read, built or destroyed
+    bool IsStreaming() const;
+
+    size_t GetCellCount() const;
+    size_t GetLoadedCellCount() const;
+    size_t GetMemoryUsage() const;
+
+private:
+    enum class CellState
+    {
+        Unloaded,
+        Reading,  // Queued for or being read by the worker
+        Read,     // Image checked, waiting to be built
+        Building, // Root attached, nodes still being built
+        Loaded,
+        Failed
+    };
+
+    struct Cell
+    {
+        int32_t x = 0;
+        int32_t y = 0;
+        std::string path;
+        size_t memory = 0; // Estimated size once built
+        CellState state = CellState::Unloaded;
+        std::vector<uint8_t> image;
+        SceneFile::Loader loader;
+        std::shared_ptr<Node> root;
+    };
+
+    static uint64_t PackCell(int32_t x, int32_t y);
+    float GetDistance(const Cell &cell, float focusX, float focusY) const;
+    void Unload(Node *worldRoot, Cell &cell);
+    void ReadCells();
+
+    Settings settings;
+    std::string directory;
+    std::unordered_map<uint64_t, std::unique_ptr<Cell>> cells;
+    size_t memoryUsage = 0;
+    size_t loadedCellCount = 0;
+    bool streaming = false;
+
+    // Detached cells, destroyed a top-level node at a time
+    std::vector<std::shared_ptr<Node>> retiredRoots;
+
+    // Reused per Update
+    std::vector<Cell *> wantedCells;
+    std::vector<Cell *> buildingCells;
+
+    // Worker thread, the state of a Reading cell belongs to it
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable readRequested;
+    std::condition_variable readFinished;
+    std::deque<Cell *> readQueue;
+    Cell *currentRead = nullptr;
+    bool stopping = false;
+};
@@ -1,31 +1,42 @@
 #include "Camera.h"
 #include <imgui.h>
-#include "DocumentationManager.h"
+#include "NodeReflection.h"
 
-Camera::Camera(const std::string &nodeName) : Node(nodeName, NodeType::Camera)
+Camera *Camera::activeCamera = nullptr;
+
+Camera::Camera(const StringAtom &nodeName) : ReflectedNode(nodeName, NodeType::Camera)
 {
-    // Initialize documentation if not already done
-    static bool documentationInitialized = false;
-    if (!documentationInitialized)
-    {
-        documentationInitialized = true;
-        InitializeDocumentation();
-    }
 }
 
-Camera::Camera(const std::string &nodeName, NodeType nodeType) : Node(nodeName, nodeType)
+Camera::Camera(const StringAtom &nodeName, NodeType nodeType) : ReflectedNode(nodeName, nodeType)
 {
-    // Documentation is initialized in the other constructor
 }
 
 Camera::~Camera()
 {
-    // Nothing specific to clean up
+    if (activeCamera == this)
+    {
+        activeCamera = nullptr;
+    }
 }
 
 void Camera::SetActive(bool active)
 {
     isActive = active;
+
+    // Activating a camera deactivates the previous one
+    if (active)
+    {
+        if (activeCamera && activeCamera != this)
+        {
+            activeCamera->isActive = false;
+        }
+        activeCamera = this;
+    }
+    else if (activeCamera == this)
+    {
+        activeCamera = nullptr;
+    }
 }
 
 bool Camera::IsActive() const
@@ -33,6 +44,11 @@ bool Camera::IsActive() const
     return isActive;
 }
 
+Camera *Camera::GetActiveCamera()
+{
+    return activeCamera;
+}
+
 void Camera::Update(float deltaTime)
 {
     // Camera specific update logic
@@ -49,47 +65,8 @@ void Camera::Render()
     Node::Render();
 }
 
-std::string Camera::GetTypeName() const
+const StringAtom &Camera::GetTypeName() const
 {
-    return "Camera";
-}
-
-void Camera::RenderInspectorProperties()
-{
-    // Call base class implementation to render transform properties
-    Node::RenderInspectorProperties();
-
-    ImGui::Separator();
-
-    // Camera-specific properties
-    ImGui::Text("Camera Properties");
-
-    // Active state
-    bool active = isActive;
-    if (ImGui::Checkbox("Active", &active))
-    {
-        SetActive(active);
-    }
-}
-
-void Camera::InitializeDocumentation()
-{
-    // Register node description
-    RegisterNodeDescription("Camera", "Base class for all camera nodes. Provides common functionality for viewing scenes.");
-
-    // Register SetActive method
-    RegisterMethod("Camera", {"SetActive",
-                              "Sets whether this camera is active.",
-                              "void",
-                              "None",
-                              {{"active", "Whether the camera should be active"}},
-                              {"camera->SetActive(true);"}});
-
-    // Register IsActive method
-    RegisterMethod("Camera", {"IsActive",
-                              "Checks if this camera is active.",
-                              "bool",
-                              "True if the camera is active, false otherwise",
-                              {},
-                              {"bool isActive = camera->IsActive();"}});
+    static const StringAtom typeName("Camera");
+    return typeName;
 }
\ No newline at end of file
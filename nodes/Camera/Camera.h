@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Node.h"
+#include "NodeReflection.h"
 
 /**
  * @brief Base Camera node for viewing scenes
@@ -8,26 +9,53 @@
  * The Camera class is the base class for all camera nodes.
  * It provides common functionality for both 2D and 3D cameras.
  */
-class Camera : public Node
+class Camera : public ReflectedNode<Camera, Node>
 {
 public:
-    Camera(const std::string &nodeName);
-    Camera(const std::string &nodeName, NodeType nodeType);
+    Camera(const StringAtom &nodeName);
+    Camera(const StringAtom &nodeName, NodeType nodeType);
     virtual ~Camera();
 
     // Camera specific methods
+    /**
+     * Sets whether this camera is active.
+     * @param active Whether the camera should be active
+     * @example camera->SetActive(true);
+     */
     void SetActive(bool active);
+
+    /**
+     * Checks if this camera is active.
+     * @return True if the camera is active, false otherwise
+     * @example bool isActive = camera->IsActive();
+     */
     bool IsActive() const;
 
+    /**
+     * Gets the camera that is currently active, if any.
+     * @return The active camera, or nullptr when none is active
+     * @example Camera *camera = Camera::GetActiveCamera();
+     */
+    static Camera *GetActiveCamera();
+
     // Override base methods
     virtual void Update(float deltaTime) override;
     virtual void Render() override;
-    virtual std::string GetTypeName() const override;
-    virtual void RenderInspectorProperties() override;
-
-    // Static documentation methods
-    static void InitializeDocumentation();
+    virtual const StringAtom &GetTypeName() const override;
 
 protected:
     bool isActive = false;
+
+    // The camera currently driving the game view, at most one is active
+    static Camera *activeCamera;
+};
+
+// Reflected fields, see NodeReflection - only one camera can be active, so copies never take it over
+template <>
+struct NodeFields<Camera>
+{
+    using Base = Node;
+    static constexpr const char *Section = "Camera Properties";
+    static constexpr auto List = std::make_tuple(
+        Accessor<Camera>(NodeProperty::Active, "Active", Widget(FieldWidget::Checkbox), &Camera::IsActive, &Camera::SetActive, FieldNoCopy));
 };
\ No newline at end of file
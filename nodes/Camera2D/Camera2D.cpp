@@ -1,15 +1,21 @@
 #include "Camera2D.h"
 #include <imgui.h>
-#include "DocumentationManager.h"
+#include "NodeReflection.h"
+#include "SpatialGrid2D.h"
+#include <cmath>
 
-Camera2D::Camera2D(const std::string &nodeName) : Node2D(nodeName, NodeType::Camera)
+Camera2D *Camera2D::activeCamera = nullptr;
+
+Camera2D::Camera2D(const StringAtom &nodeName) : ReflectedNode(nodeName, NodeType::Camera)
 {
-    // Documentation is now initialized in DocumentationManager::LoadDocumentation
 }
 
 Camera2D::~Camera2D()
 {
-    // Nothing specific to clean up
+    if (activeCamera == this)
+    {
+        activeCamera = nullptr;
+    }
 }
 
 void Camera2D::SetZoom(float zoom)
@@ -25,6 +31,20 @@ float Camera2D::GetZoom() const
 void Camera2D::SetActive(bool active)
 {
     isActive = active;
+
+    if (active)
+    {
+        // Only one camera drives the view at a time
+        if (activeCamera && activeCamera != this)
+        {
+            activeCamera->isActive = false;
+        }
+        activeCamera = this;
+    }
+    else if (activeCamera == this)
+    {
+        activeCamera = nullptr;
+    }
 }
 
 bool Camera2D::IsActive() const
@@ -32,6 +52,38 @@ bool Camera2D::IsActive() const
     return isActive;
 }
 
+Camera2D *Camera2D::GetActiveCamera()
+{
+    return activeCamera;
+}
+
+void Camera2D::GetViewBounds(float viewportWidth, float viewportHeight, float outMin[2], float outMax[2]) const
+{
+    // Half size of the visible area in world units
+    float safeZoom = zoom > 0.0f ? zoom : 1.0f;
+    float halfWidth = viewportWidth * 0.5f / safeZoom;
+    float halfHeight = viewportHeight * 0.5f / safeZoom;
+
+    // Grow the rectangle to cover a rotated view
+    float radians = worldTransform.rotation[2] * 3.14159265f / 180.0f;
+    float cosR = fabsf(cosf(radians));
+    float sinR = fabsf(sinf(radians));
+    float extentX = halfWidth * cosR + halfHeight * sinR;
+    float extentY = halfWidth * sinR + halfHeight * cosR;
+
+    outMin[0] = worldTransform.position[0] - extentX;
+    outMin[1] = worldTransform.position[1] - extentY;
+    outMax[0] = worldTransform.position[0] + extentX;
+    outMax[1] = worldTransform.position[1] + extentY;
+}
+
+void Camera2D::GetVisibleNodes(const SpatialGrid2D &grid, float viewportWidth, float viewportHeight, std::vector<Node *> &outNodes) const
+{
+    float viewMin[2], viewMax[2];
+    GetViewBounds(viewportWidth, viewportHeight, viewMin, viewMax);
+    grid.Query(viewMin, viewMax, outNodes);
+}
+
 void Camera2D::Update(float deltaTime)
 {
     // Camera2D specific update logic
@@ -48,74 +100,8 @@ void Camera2D::Render()
     Node2D::Render();
 }
 
-std::string Camera2D::GetTypeName() const
-{
-    return "Camera2D";
-}
-
-void Camera2D::RenderInspectorProperties()
-{
-    // First render the transform properties from the base class
-    Node2D::RenderInspectorProperties();
-
-    ImGui::Separator();
-
-    // Camera2D-specific properties
-    ImGui::Text("Camera2D Properties");
-
-    // Zoom
-    ImGui::Text("Zoom");
-    ImGui::SameLine(100);
-    float zoomValue = zoom;
-    if (ImGui::SliderFloat("##Zoom", &zoomValue, 0.1f, 10.0f))
-    {
-        SetZoom(zoomValue);
-    }
-
-    // Active state
-    bool active = isActive;
-    if (ImGui::Checkbox("Active", &active))
-    {
-        SetActive(active);
-    }
-}
-
-void Camera2D::InitializeDocumentation()
+const StringAtom &Camera2D::GetTypeName() const
 {
-    // Register node description
-    RegisterNodeDescription("Camera2D", "A 2D camera node for viewing 2D scenes. Inherits from Node2D and provides functionality for 2D camera operations.");
-
-    // Register SetZoom method
-    RegisterMethod("Camera2D", {"SetZoom",
-                                "Sets the zoom level of the camera.",
-                                "void",
-                                "None",
-                                {{"zoom", "Zoom level (1.0 is normal, greater than 1.0 is zoomed in, less than 1.0 is zoomed out)"}},
-                                {"camera2D->SetZoom(2.0f); // Zoom in 2x"}});
-
-    // Register GetZoom method
-    RegisterMethod("Camera2D", {"GetZoom",
-                                "Gets the current zoom level of the camera.",
-                                "float",
-                                "The current zoom level",
-                                {},
-                                {"float zoom = camera2D->GetZoom();"}});
-
-    // Register SetActive method
-    RegisterMethod("Camera2D", {"SetActive",
-                                "Sets whether this camera is active.",
-                                "void",
-                                "None",
-                                {{"active", "Whether the camera should be active"}},
-                                {"camera2D->SetActive(true);"}});
-
-    // Register IsActive method
-    RegisterMethod("Camera2D", {"IsActive",
-                                "Checks if this camera is active.",
-                                "bool",
-                                "True if the camera is active, false otherwise",
-                                {},
-                                {"bool isActive = camera2D->IsActive();"}});
-
-    // These methods are already registered above, so we don't need to register them again
+    static const StringAtom typeName("Camera2D");
+    return typeName;
 }
\ No newline at end of file
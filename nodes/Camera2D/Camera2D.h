@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../Node2D/Node2D.h"
+#include "../Camera3D/Camera3D.h"
+#include <vector>
+
+// Forward declaration
+class SpatialGrid2D;
 
 /**
  * @brief 2D Camera for viewing 2D scenes
@@ -8,28 +13,102 @@
  * The Camera2D class is used for viewing 2D scenes.
  * It inherits from Node2D and provides functionality for 2D camera operations.
  */
-class Camera2D : public Node2D
+class Camera2D : public ReflectedNode<Camera2D, Node2D>
 {
 public:
-    Camera2D(const std::string &nodeName);
+    Camera2D(const StringAtom &nodeName);
     virtual ~Camera2D();
 
     // Camera2D specific methods
+    /**
+     * Sets the zoom level of the camera.
+     * @param zoom Zoom level (1.0 is normal, greater than 1.0 is zoomed in, less than 1.0 is zoomed out)
+     * @example camera2D->SetZoom(2.0f); // Zoom in 2x
+     */
     void SetZoom(float zoom);
+
+    /**
+     * Gets the current zoom level of the camera.
+     * @return The current zoom level
+     * @example float zoom = camera2D->GetZoom();
+     */
     float GetZoom() const;
+
+    /**
+     * Sets whether this camera is active.
+     * @param active Whether the camera should be active
+     * @example camera2D->SetActive(true);
+     */
     void SetActive(bool active);
+
+    /**
+     * Checks if this camera is active.
+     * @return True if the camera is active, false otherwise
+     * @example bool isActive = camera2D->IsActive();
+     */
     bool IsActive() const;
 
+    // Visibility
+    /**
+     * Gets the world-space rectangle seen by the camera for a viewport of the given size, accounting for zoom
+     * and rotation.
+     * @param viewportWidth Viewport width in pixels
+     * @param viewportHeight Viewport height in pixels
+     * @param outMin Receives the minimum corner [x, y]
+     * @param outMax Receives the maximum corner [x, y]
+     * @example
+     * float viewMin[2], viewMax[2];
+     * camera2D->GetViewBounds(1280.0f, 720.0f, viewMin, viewMax);
+     */
+    void GetViewBounds(float viewportWidth, float viewportHeight, float outMin[2], float outMax[2]) const;
+
+    /**
+     * Queries a spatial grid for the nodes whose bounds overlap the camera's view.
+     * @param grid Spatial grid indexing the scene
+     * @param viewportWidth Viewport width in pixels
+     * @param viewportHeight Viewport height in pixels
+     * @param outNodes Receives the visible nodes
+     * @example
+     * std::vector<Node*> visible;
+     * camera2D->GetVisibleNodes(sceneGrid, 1280.0f, 720.0f, visible);
+     */
+    void GetVisibleNodes(const SpatialGrid2D &grid, float viewportWidth, float viewportHeight, std::vector<Node *> &outNodes) const;
+
+    /**
+     * Gets the camera currently driving the 2D view. Activating a camera deactivates the previous one.
+     * @return The active camera, or nullptr if none is active
+     * @example Camera2D* camera = Camera2D::GetActiveCamera();
+     */
+    static Camera2D *GetActiveCamera();
+
     // Override base methods
     virtual void Update(float deltaTime) override;
     virtual void Render() override;
-    virtual std::string GetTypeName() const override;
-    virtual void RenderInspectorProperties() override;
-
-    // Static documentation methods
-    static void InitializeDocumentation();
+    virtual const StringAtom &GetTypeName() const override;
 
 private:
     float zoom = 1.0f;
     bool isActive = false;
+
+    // The camera currently driving the game view, at most one is active
+    static Camera2D *activeCamera;
+};
+
+// Reflected fields, see NodeReflection - only one camera can be active, so copies never take it over
+template <>
+struct NodeFields<Camera2D>
+{
+    using Base = Node2D;
+    static constexpr const char *Section = "Camera2D Properties";
+    static constexpr auto List = std::make_tuple(
+        Accessor<Camera2D>(NodeProperty::Zoom, "Zoom", Slider(0.1f, 10.0f), &Camera2D::GetZoom, &Camera2D::SetZoom),
+        Accessor<Camera2D>(NodeProperty::Active, "Active", Widget(FieldWidget::Checkbox), &Camera2D::IsActive, &Camera2D::SetActive, FieldNoCopy));
+};
+
+// Node type registration, fa-camera icon - cameras follow the editor mode they are created in
+template <>
+struct NodeTypeRegistration<NodeType::Camera>
+{
+    static constexpr NodeTypeInfo Info = {"Camera", "Camera2D", "\xef\x80\xbd", true,
+                                          &CreateRegisteredNode<Camera2D, Camera3D>};
 };
\ No newline at end of file
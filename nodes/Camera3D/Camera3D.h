@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Camera/Camera.h"
+#include "Frustum.h"
+#include <vector>
 
 /**
  * @brief 3D Camera for viewing 3D scenes
@@ -8,31 +10,101 @@
  * The Camera3D class is used for viewing 3D scenes.
  * It inherits from Camera and provides functionality for 3D camera operations.
  */
-class Camera3D : public Camera
+class Camera3D : public ReflectedNode<Camera3D, Camera>
 {
 public:
-    Camera3D(const std::string &nodeName);
+    Camera3D(const StringAtom &nodeName);
     virtual ~Camera3D();
 
     // Camera3D specific methods
+    /**
+     * Sets the field of view of the camera in degrees.
+     * @param fov Field of view in degrees
+     * @example camera3D->SetFOV(60.0f);
+     */
     void SetFOV(float fov);
+
+    /**
+     * Gets the field of view of the camera in degrees.
+     * @return The current field of view in degrees
+     * @example float fov = camera3D->GetFOV();
+     */
     float GetFOV() const;
+
+    /**
+     * Sets the near clipping plane distance.
+     * @param nearClip Distance to the near clipping plane
+     * @example camera3D->SetNearClip(0.1f);
+     */
     void SetNearClip(float nearClip);
+
+    /**
+     * Gets the near clipping plane distance.
+     * @return The current near clipping plane distance
+     * @example float nearClip = camera3D->GetNearClip();
+     */
     float GetNearClip() const;
+
+    /**
+     * Sets the far clipping plane distance.
+     * @param farClip Distance to the far clipping plane
+     * @example camera3D->SetFarClip(1000.0f);
+     */
     void SetFarClip(float farClip);
+
+    /**
+     * Gets the far clipping plane distance.
+     * @return The current far clipping plane distance
+     * @example float farClip = camera3D->GetFarClip();
+     */
     float GetFarClip() const;
 
+    // Visibility
+    /**
+     * Builds the view frustum from the camera's world transform, field of view and clipping planes.
+     * @param aspectRatio Viewport width divided by height
+     * @param outFrustum Receives the six frustum planes
+     * @example
+     * Frustum frustum;
+     * camera3D->BuildFrustum(16.0f / 9.0f, frustum);
+     */
+    void BuildFrustum(float aspectRatio, Frustum &outFrustum) const;
+
+    /**
+     * Tests packed bounding boxes against the camera's frustum and collects the indices of the visible ones.
+     * @param bounds Bounding boxes to test
+     * @param aspectRatio Viewport width divided by height
+     * @param outVisible Receives the indices of visible boxes
+     * @example
+     * std::vector<uint32_t> visible;
+     * camera3D->GetVisibleNodes(sceneBounds3D, 16.0f / 9.0f, visible);
+     */
+    void GetVisibleNodes(const BoundsArray3D &bounds, float aspectRatio, std::vector<uint32_t> &outVisible) const;
+
     // Override base methods
     virtual void Update(float deltaTime) override;
     virtual void Render() override;
-    virtual std::string GetTypeName() const override;
-    virtual void RenderInspectorProperties() override;
-
-    // Static documentation methods
-    static void InitializeDocumentation();
+    virtual const StringAtom &GetTypeName() const override;
 
 private:
+    friend struct NodeFields<Camera3D>;
+
     float fov = 70.0f;       // Field of view in degrees
     float nearClip = 0.1f;   // Near clipping plane
     float farClip = 1000.0f; // Far clipping plane
+
+    // Keeps the near plane in front of the camera and the far plane beyond it
+    void ClampClipPlanes();
+};
+
+// Reflected fields, see NodeReflection
+template <>
+struct NodeFields<Camera3D>
+{
+    using Base = Camera;
+    static constexpr const char *Section = "Camera3D Properties";
+    static constexpr auto List = std::make_tuple(
+        Field(NodeProperty::Fov, "FOV", Slider(10.0f, 120.0f, "%.1f°"), &Camera3D::fov),
+        Field(NodeProperty::NearClip, "Near Clip", FloatInput(0.01f, 0.1f, "%.3f"), &Camera3D::nearClip, &Camera3D::ClampClipPlanes, FieldHookOnEdit),
+        Field(NodeProperty::FarClip, "Far Clip", FloatInput(1.0f, 10.0f, "%.1f"), &Camera3D::farClip, &Camera3D::ClampClipPlanes, FieldHookOnEdit));
 };
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "Label.h"
+#include <imgui.h>
+#include "NodeReflection.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // Pipeline identifier for distance field text, labels are drawn in the transparent queue
+    constexpr uint8_t SdfTextPipeline = 1;
+    static_assert(SdfTextPipeline < RenderQueue::TransparentPipelineCount, "Text pipeline id doesn't fit the transparent sort key");
+}
+
+Label::Label(const StringAtom &nodeName) : ReflectedNode(nodeName, NodeType::Label)
+{
+}
+
+Label::~Label()
+{
+    // Nothing specific to clean up
+}
+
+void Label::SetText(const std::string &text)
+{
+    // Setting the same text every frame must not cost a relayout
+    if (this->text == text)
+        return;
+
+    this->text = text;
+    InvalidateLayout();
+}
+
+const std::string &Label::GetText() const
+{
+    return text;
+}
+
+void Label::SetFont(const std::string &fontPath)
+{
+    // Setting a font that failed to load tries the file again
+    SdfFontAtlas::ForgetFailure(fontPath);
+    if (this->fontPath == fontPath && (font || fontDirty))
+        return;
+
+    this->fontPath = fontPath;
+    fontDirty = true;
+    InvalidateLayout();
+}
+
+const std::string &Label::GetFontPath() const
+{
+    return fontPath;
+}
+
+void Label::SetFontSize(float fontSize)
+{
+    fontSize = std::max(fontSize, 1.0f);
+    if (this->fontSize == fontSize)
+        return;
+
+    this->fontSize = fontSize;
+    InvalidateLayout();
+}
+
+float Label::GetFontSize() const
+{
+    return fontSize;
+}
+
+void Label::SetColor(float r, float g, float b, float a)
+{
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+    color[3] = a;
+    MarkVisualDirty();
+}
+
+const float *Label::GetColor() const
+{
+    return color;
+}
+
+void Label::SetLayer(int layer)
+{
+    this->layer = std::clamp(layer, 0, 255);
+    MarkVisualDirty();
+}
+
+int Label::GetLayer() const
+{
+    return layer;
+}
+
+void Label::SetZIndex(int zIndex)
+{
+    this->zIndex = std::clamp(zIndex, -32768, 32767);
+    MarkVisualDirty();
+}
+
+int Label::GetZIndex() const
+{
+    return zIndex;
+}
+
+void Label::InvalidateLayout()
+{
+    layoutDirty = true;
+
+    // The layout defines the bounds, the scene index refreshes them on visual changes
+    MarkVisualDirty();
+}
+
+void Label::UpdateLayout() const
+{
+    if (fontDirty)
+    {
+        fontDirty = false;
+        font = SdfFontAtlas::Get(fontPath);
+    }
+
+    if (!layoutDirty)
+        return;
+
+    layoutDirty = false;
+    if (font)
+    {
+        font->LayoutText(text, fontSize, glyphQuads, layoutMin, layoutMax);
+    }
+    else
+    {
+        glyphQuads.clear();
+        layoutMin[0] = layoutMin[1] = 0.0f;
+        layoutMax[0] = layoutMax[1] = 0.0f;
+    }
+}
+
+const std::vector<GlyphQuad> &Label::GetGlyphQuads() const
+{
+    UpdateLayout();
+    return glyphQuads;
+}
+
+const std::shared_ptr<SdfFontAtlas> &Label::GetFontAtlas() const
+{
+    UpdateLayout();
+    return font;
+}
+
+void Label::GetLocalBounds(float outMin[2], float outMax[2]) const
+{
+    UpdateLayout();
+
+    // Labels without a usable font keep the default marker bounds
+    if (!font)
+    {
+        Node2D::GetLocalBounds(outMin, outMax);
+        return;
+    }
+
+    outMin[0] = layoutMin[0];
+    outMin[1] = layoutMin[1];
+    outMax[0] = layoutMax[0];
+    outMax[1] = layoutMax[1];
+}
+
+void Label::Update(float deltaTime)
+{
+    // Label specific update logic
+
+    // Call base class update
+    Node2D::Update(deltaTime);
+}
+
+void Label::Render()
+{
+    // Label specific rendering logic
+    // In a real implementation, this would emit the cached glyph quads with the atlas bound
+
+    // Call base class render
+    Node2D::Render();
+}
+
+void Label::SubmitDraw(const Transform &world, RenderQueue &opaqueQueue, RenderQueue &transparentQueue)
+{
+    const std::shared_ptr<SdfFontAtlas> &atlas = GetFontAtlas();
+    if (!atlas || text.empty())
+        return;
+
+    // Distance field edges are alpha blended. Labels sharing a font share the
+    // atlas texture and pipeline, so they batch together within a z-index.
+    RenderQueue::DrawState state;
+    state.layer = static_cast<uint8_t>(layer);
+    state.zIndex = static_cast<int16_t>(zIndex);
+    state.pipeline = SdfTextPipeline;
+    state.texture = atlas->GetAtlasId();
+    transparentQueue.Submit(state, this);
+}
+
+const StringAtom &Label::GetTypeName() const
+{
+    static const StringAtom typeName("Label");
+    return typeName;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "../Node2D/Node2D.h"
+#include "SdfFontAtlas.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 2D text node rendered from a signed-distance-field glyph atlas
+ *
+ * The Label class displays a string using a font atlas shared by every label
+ * with the same font. The glyph layout is cached and only rebuilt when the
+ * text, font or font size changes, so labels that are redrawn every frame
+ * cost nothing beyond emitting their quads.
+ */
+class Label : public ReflectedNode<Label, Node2D>
+{
+public:
+    Label(const StringAtom &nodeName);
+    virtual ~Label();
+
+    // Label specific methods
+    /**
+     * Sets the text displayed by the label. Setting the current text again does nothing.
+     * @param text Text to display, lines separated by '\n'
+     * @example label->SetText("Score: 100");
+     */
+    void SetText(const std::string &text);
+
+    /**
+     * Gets the text displayed by the label.
+     * @return The current text
+     * @example const std::string& text = label->GetText();
+     */
+    const std::string &GetText() const;
+
+    /**
+     * Sets the font file used by the label. The font's atlas is generated on first use and shared between
+     * labels. A font that failed to load is only read again once it is set again.
+     * @param fontPath Path to a TrueType font file
+     * @example label->SetFont("fonts/Nunito_Sans/NunitoSans-VariableFont_YTLC,opsz,wdth,wght.ttf");
+     */
+    void SetFont(const std::string &fontPath);
+
+    /**
+     * Gets the path of the font file used by the label.
+     * @return The current font path
+     * @example const std::string& fontPath = label->GetFontPath();
+     */
+    const std::string &GetFontPath() const;
+
+    /**
+     * Sets the text size in pixels. The distance field atlas scales without being regenerated.
+     * @param fontSize Text size in pixels
+     * @example label->SetFontSize(24.0f);
+     */
+    void SetFontSize(float fontSize);
+
+    /**
+     * Gets the text size in pixels.
+     * @return The current text size
+     * @example float fontSize = label->GetFontSize();
+     */
+    float GetFontSize() const;
+
+    /**
+     * Sets the color of the text.
+     * @param r Red component (0-1)
+     * @param g Green component (0-1)
+     * @param b Blue component (0-1)
+     * @param a Alpha component (0-1), defaults to 1.0
+     * @example label->SetColor(1.0f, 0.2f, 0.2f);
+     */
+    void SetColor(float r, float g, float b, float a = 1.0f);
+
+    /**
+     * Gets the color of the text.
+     * @return Pointer to an array of 4 floats representing RGBA
+     * @example const float* color = label->GetColor();
+     */
+    const float *GetColor() const;
+
+    // Draw ordering
+    /**
+     * Sets the canvas layer of the label. Higher layers are drawn on top.
+     * @param layer Canvas layer (0-255)
+     * @example label->SetLayer(10);
+     */
+    void SetLayer(int layer);
+
+    /**
+     * Gets the canvas layer of the label.
+     * @return The current canvas layer
+     * @example int layer = label->GetLayer();
+     */
+    int GetLayer() const;
+
+    /**
+     * Sets the draw order of the label within its layer.
+     * @param zIndex Z-index (-32768 to 32767)
+     * @example label->SetZIndex(5);
+     */
+    void SetZIndex(int zIndex);
+
+    /**
+     * Gets the draw order of the label within its layer.
+     * @return The current z-index
+     * @example int zIndex = label->GetZIndex();
+     */
+    int GetZIndex() const;
+
+    // Cached layout
+    /**
+     * Gets the cached glyph quads of the text, laying it out first if it changed.
+     * @return Glyph positions in label space with atlas texture coordinates
+     * @example
+     * for (const GlyphQuad& quad : label->GetGlyphQuads())
+     * {
+     *     // Emit quad
+     * }
+     */
+    const std::vector<GlyphQuad> &GetGlyphQuads() const;
+    const std::shared_ptr<SdfFontAtlas> &GetFontAtlas() const;
+    virtual void GetLocalBounds(float outMin[2], float outMax[2]) const override;
+
+    // Override base methods
+    virtual void Update(float deltaTime) override;
+    virtual void Render() override;
+    virtual void SubmitDraw(const Transform &world, RenderQueue &opaqueQueue, RenderQueue &transparentQueue) override;
+    virtual const StringAtom &GetTypeName() const override;
+
+private:
+    friend struct NodeFields<Label>;
+
+    std::string text = "Label";
+    std::string fontPath = "fonts/Nunito_Sans/NunitoSans-VariableFont_YTLC,opsz,wdth,wght.ttf";
+    float fontSize = 16.0f;
+    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA
+
+    // Draw ordering
+    int layer = 0;  // Canvas layer (0 to 255)
+    int zIndex = 0; // Z-index within the layer (-32768 to 32767)
+
+    // Layout cache, rebuilt lazily when invalidated
+    void InvalidateLayout();
+    void UpdateLayout() const;
+    mutable std::shared_ptr<SdfFontAtlas> font;
+    mutable std::vector<GlyphQuad> glyphQuads;
+    mutable float layoutMin[2] = {0.0f, 0.0f};
+    mutable float layoutMax[2] = {0.0f, 0.0f};
+    mutable bool fontDirty = true;
+    mutable bool layoutDirty = true;
+};
+
+// Reflected fields, see NodeReflection
+template <>
+struct NodeFields<Label>
+{
+    using Base = Node2D;
+    static constexpr const char *Section = "Label Properties";
+    static constexpr auto List = std::make_tuple(
+        Accessor<Label>(NodeProperty::Text, "Text", Widget(FieldWidget::Text), &Label::GetText, &Label::SetText),
+        Accessor<Label>(NodeProperty::Font, "Font", Widget(FieldWidget::Label), &Label::GetFontPath, &Label::SetFont),
+        Accessor<Label>(NodeProperty::FontSize, "Font Size", FloatInput(1.0f, 4.0f, "%.1f"), &Label::GetFontSize, &Label::SetFontSize),
+        Field(NodeProperty::Color, "Color", Widget(FieldWidget::Color4), &Label::color, &Label::MarkVisualDirty),
+        Accessor<Label>(NodeProperty::Layer, "Layer", Widget(FieldWidget::Int), &Label::GetLayer, &Label::SetLayer),
+        Accessor<Label>(NodeProperty::ZIndex, "Z Index", Widget(FieldWidget::Int), &Label::GetZIndex, &Label::SetZIndex));
+};
+
+// Node type registration, fa-font icon
+template <>
+struct NodeTypeRegistration<NodeType::Label>
+{
+    static constexpr NodeTypeInfo Info = {"Label", "Label", "\xef\x81\x9e", true,
+                                          &CreateRegisteredNode<Label>};
+};
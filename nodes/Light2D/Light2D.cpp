@@ -0,0 +1,79 @@
+#include "Light2D.h"
+#include <imgui.h>
+#include "NodeReflection.h"
+
+Light2D::Light2D(const StringAtom &nodeName) : ReflectedNode(nodeName, NodeType::Light)
+{
+}
+
+Light2D::~Light2D()
+{
+    // Nothing specific to clean up
+}
+
+void Light2D::SetColor(float r, float g, float b)
+{
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+    MarkVisualDirty();
+}
+
+const float *Light2D::GetColor() const
+{
+    return color;
+}
+
+void Light2D::SetEnergy(float energy)
+{
+    this->energy = energy > 0.0f ? energy : 0.0f;
+    MarkVisualDirty();
+}
+
+float Light2D::GetEnergy() const
+{
+    return energy;
+}
+
+void Light2D::SetRadius(float radius)
+{
+    this->radius = radius > 0.0f ? radius : 0.0f;
+
+    // The radius defines the bounds, the scene index refreshes them on visual changes
+    MarkVisualDirty();
+}
+
+float Light2D::GetRadius() const
+{
+    return radius;
+}
+
+void Light2D::GetLocalBounds(float outMin[2], float outMax[2]) const
+{
+    outMin[0] = -radius;
+    outMin[1] = -radius;
+    outMax[0] = radius;
+    outMax[1] = radius;
+}
+
+void Light2D::Update(float deltaTime)
+{
+    // Light2D specific update logic
+
+    // Call base class update
+    Node2D::Update(deltaTime);
+}
+
+void Light2D::Render()
+{
+    // Light2D specific rendering logic
+
+    // Call base class render
+    Node2D::Render();
+}
+
+const StringAtom &Light2D::GetTypeName() const
+{
+    static const StringAtom typeName("Light2D");
+    return typeName;
+}
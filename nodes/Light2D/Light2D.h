@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../Node2D/Node2D.h"
+
+/**
+ * @brief 2D point light
+ *
+ * The Light2D class emits light in a circle around its position with a
+ * smooth falloff to zero at its radius. Lights are gathered per frame and
+ * assigned to screen tiles, so only the lights touching a tile are shaded there.
+ */
+class Light2D : public ReflectedNode<Light2D, Node2D>
+{
+public:
+    Light2D(const StringAtom &nodeName);
+    virtual ~Light2D();
+
+    // Light2D specific methods
+    /**
+     * Sets the color of the light.
+     * @param r Red component (0-1)
+     * @param g Green component (0-1)
+     * @param b Blue component (0-1)
+     * @example light->SetColor(1.0f, 0.8f, 0.6f);
+     */
+    void SetColor(float r, float g, float b);
+
+    /**
+     * Gets the color of the light.
+     * @return Pointer to an array of 3 floats representing RGB
+     * @example const float* color = light->GetColor();
+     */
+    const float *GetColor() const;
+
+    /**
+     * Sets the intensity of the light at its centre.
+     * @param energy Light intensity, 0 or greater
+     * @example light->SetEnergy(1.5f);
+     */
+    void SetEnergy(float energy);
+
+    /**
+     * Gets the intensity of the light at its centre.
+     * @return The current light intensity
+     * @example float energy = light->GetEnergy();
+     */
+    float GetEnergy() const;
+
+    /**
+     * Sets the range of the light in world units. The light fades to zero at this distance.
+     * @param radius Range of the light in world units
+     * @example light->SetRadius(300.0f);
+     */
+    void SetRadius(float radius);
+
+    /**
+     * Gets the range of the light in world units.
+     * @return The current light range
+     * @example float radius = light->GetRadius();
+     */
+    float GetRadius() const;
+
+    // The light's bounds cover its whole radius of influence
+    virtual void GetLocalBounds(float outMin[2], float outMax[2]) const override;
+
+    // Override base methods
+    virtual void Update(float deltaTime) override;
+    virtual void Render() override;
+    virtual const StringAtom &GetTypeName() const override;
+
+private:
+    friend struct NodeFields<Light2D>;
+
+    float color[3] = {1.0f, 0.9f, 0.7f}; // RGB
+    float energy = 1.0f;                 // Intensity at the centre
+    float radius = 200.0f;               // Range in world units
+};
+
+// Reflected fields, see NodeReflection
+template <>
+struct NodeFields<Light2D>
+{
+    using Base = Node2D;
+    static constexpr const char *Section = "Light2D Properties";
+    static constexpr auto List = std::make_tuple(
+        Field(NodeProperty::Color, "Color", Widget(FieldWidget::Color3), &Light2D::color, &Light2D::MarkVisualDirty),
+        Accessor<Light2D>(NodeProperty::Energy, "Energy", Slider(0.0f, 4.0f, "%.2f"), &Light2D::GetEnergy, &Light2D::SetEnergy),
+        Accessor<Light2D>(NodeProperty::Radius, "Radius", FloatInput(1.0f, 10.0f, "%.1f"), &Light2D::GetRadius, &Light2D::SetRadius));
+};
+
+// Node type registration, fa-lightbulb icon
+template <>
+struct NodeTypeRegistration<NodeType::Light>
+{
+    static constexpr NodeTypeInfo Info = {"Light", "Light2D", "\xef\x83\x85", true,
+                                          &CreateRegisteredNode<Light2D>};
+};
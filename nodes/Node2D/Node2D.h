@@ -1,6 +1,7 @@
 #pragma once
 
-#include "Node.h"
+#include "NodeTypeRegistry.h"
+#include "NodeReflection.h"
 
 /**
  * @brief 2D Node with position, rotation, and scale
@@ -8,28 +9,83 @@
  * The Node2D class is the base class for all 2D nodes in the scene.
  * It provides functionality for 2D transformations.
  */
-class Node2D : public Node
+class Node2D : public ReflectedNode<Node2D, Node>
 {
 public:
-    Node2D(const std::string &nodeName);
-    Node2D(const std::string &nodeName, NodeType nodeType);
+    Node2D(const StringAtom &nodeName);
+    Node2D(const StringAtom &nodeName, NodeType nodeType);
     virtual ~Node2D();
 
     // Node2D specific methods
+    /**
+     * Sets the 2D position of the node.
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @example node2D->SetPosition(100.0f, 200.0f);
+     */
     void SetPosition(float x, float y);
+
+    /**
+     * Sets the rotation of the node in degrees.
+     * @param degrees Rotation angle in degrees
+     * @example node2D->SetRotation(45.0f);
+     */
     void SetRotation(float degrees);
+
+    /**
+     * Sets the scale of the node.
+     * @param x X scale factor
+     * @param y Y scale factor
+     * @example node2D->SetScale(2.0f, 2.0f);
+     */
     void SetScale(float x, float y);
 
+    /**
+     * Gets the position of the node.
+     * @return Pointer to an array of 3 floats representing the position [x, y, z]
+     * @example
+     * float* position = node2D->GetPosition();
+     * float x = position[0];
+     * float y = position[1];
+     */
     float *GetPosition();
+
+    /**
+     * Gets the rotation of the node in degrees.
+     * @return Rotation angle in degrees
+     * @example float rotation = node2D->GetRotation();
+     */
     float GetRotation() const;
+
+    /**
+     * Gets the scale of the node.
+     * @return Pointer to an array of 3 floats representing the scale [x, y, z]
+     * @example
+     * float* scale = node2D->GetScale();
+     * float scaleX = scale[0];
+     * float scaleY = scale[1];
+     */
     float *GetScale();
 
     // Override base methods
     virtual void Update(float deltaTime) override;
     virtual void Render() override;
-    virtual std::string GetTypeName() const override;
-    virtual void RenderInspectorProperties() override;
+    virtual const StringAtom &GetTypeName() const override;
+};
 
-    // Static documentation methods
-    static void InitializeDocumentation();
+// Reflected fields, see NodeReflection - a Node2D adds none to Node's
+template <>
+struct NodeFields<Node2D>
+{
+    using Base = Node;
+    static constexpr const char *Section = nullptr;
+    static constexpr auto List = std::make_tuple();
+};
+
+// Node type registration, fa-square-o icon
+template <>
+struct NodeTypeRegistration<NodeType::Node2D>
+{
+    static constexpr NodeTypeInfo Info = {"Node2D", "Node2D", "\xef\x81\x88", true,
+                                          &CreateRegisteredNode<Node2D>};
 };
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "PrefabInstance.h"
+#include <algorithm>
+#include <cstring>
+#include <imgui.h>
+
+PrefabInstance::PrefabInstance(const StringAtom &nodeName, std::shared_ptr<const Prefab> prefab)
+    : Node2D(nodeName, NodeType::Node2D), prefab(std::move(prefab))
+{
+}
+
+PrefabInstance::~PrefabInstance()
+{
+    // The template is released with the last instance that refers to it
+}
+
+const std::shared_ptr<const Prefab> &PrefabInstance::GetPrefab() const
+{
+    return prefab;
+}
+
+bool PrefabInstance::SetOverride(uint32_t nodeIndex, NodeProperty property, const uint8_t *value, size_t size)
+{
+    if (!prefab || nodeIndex >= prefab->GetNodes().size())
+        return false;
+
+    // The value goes through the patched copy's setter, which checks it like any other edit
+    Node *patched = PatchNode(nodeIndex);
+    const bool applied = patched && patched->SetProperty(property, value, size);
+    SyncOverrides(nodeIndex);
+    return applied;
+}
+
+void PrefabInstance::RevertToPrefab()
+{
+    if (overrides.empty() && patchedNodes.empty())
+        return;
+
+    overrides.clear();
+    overrideValues.clear();
+    patchedNodes.clear();
+    MarkVisualDirty();
+}
+
+const std::vector<PrefabOverride> &PrefabInstance::GetOverrides() const
+{
+    return overrides;
+}
+
+const uint8_t *PrefabInstance::GetOverrideValue(const PrefabOverride &entry) const
+{
+    return overrideValues.data() + entry.offset;
+}
+
+Node *PrefabInstance::GetResolvedNode(uint32_t nodeIndex) const
+{
+    if (!prefab || nodeIndex >= prefab->GetNodes().size())
+        return nullptr;
+
+    Node *patched = FindPatchedNode(nodeIndex);
+    return patched ? patched : prefab->GetNodes()[nodeIndex];
+}
+
+void PrefabInstance::GetNodeTransforms(std::vector<Node::Transform> &outWorld) const
+{
+    outWorld.clear();
+    if (!prefab)
+        return;
+
+    // Parents come first in the template's order, patched nodes are met in the same ascending order
+    const std::vector<Node *> &templateNodes = prefab->GetNodes();
+    const std::vector<uint32_t> &parents = prefab->GetParents();
+    outWorld.resize(templateNodes.size());
+    auto patch = patchedNodes.begin();
+    for (uint32_t i = 0; i < templateNodes.size(); i++)
+    {
+        const Node *node = templateNodes[i];
+        if (patch != patchedNodes.end() && patch->nodeIndex == i)
+        {
+            node = patch->node.get();
+            ++patch;
+        }
+
+        const Node::Transform &parentWorld = parents[i] == Prefab::NoParent ? worldTransform : outWorld[parents[i]];
+        Node::ComposeTransforms(parentWorld, node->transform, outWorld[i]);
+    }
+}
+
+void PrefabInstance::CopyProperties(const Node &source)
+{
+    Node2D::CopyProperties(source);
+
+    // Node indices only mean something within the same prefab
+    const PrefabInstance *instance = dynamic_cast<const PrefabInstance *>(&source);
+    if (!instance || instance == this || instance->prefab != prefab)
+        return;
+
+    RevertToPrefab();
+    for (const PrefabOverride &entry : instance->overrides)
+    {
+        SetOverride(entry.nodeIndex, entry.property, instance->GetOverrideValue(entry), entry.size);
+    }
+}
+
+Node *PrefabInstance::FindPatchedNode(uint32_t nodeIndex) const
+{
+    auto it = std::lower_bound(patchedNodes.begin(), patchedNodes.end(), nodeIndex,
+                               [](const PatchedNode &patch, uint32_t index) { return patch.nodeIndex < index; });
+    return it != patchedNodes.end() && it->nodeIndex == nodeIndex ? it->node.get() : nullptr;
+}
+
+Node *PrefabInstance::PatchNode(uint32_t nodeIndex)
+{
+    auto it = std::lower_bound(patchedNodes.begin(), patchedNodes.end(), nodeIndex,
+                               [](const PatchedNode &patch, uint32_t index) { return patch.nodeIndex < index; });
+    if (it != patchedNodes.end() && it->nodeIndex == nodeIndex)
+        return it->node.get();
+
+    // Only the node itself is copied, its children stay shared
+    std::shared_ptr<Node> copy = Prefab::CloneNode(prefab->GetNodes()[nodeIndex]);
+    if (!copy)
+        return nullptr;
+
+    return patchedNodes.insert(it, {nodeIndex, std::move(copy)})->node.get();
+}
+
+void PrefabInstance::DropPatchedNode(uint32_t nodeIndex)
+{
+    auto it = std::lower_bound(patchedNodes.begin(), patchedNodes.end(), nodeIndex,
+                               [](const PatchedNode &patch, uint32_t index) { return patch.nodeIndex < index; });
+    if (it != patchedNodes.end() && it->nodeIndex == nodeIndex)
+    {
+        patchedNodes.erase(it);
+    }
+}
+
+bool PrefabInstance::SyncOverrides(uint32_t nodeIndex)
+{
+    // Compared field by field, only the properties that differ from the template are kept
+    const Node *patched = FindPatchedNode(nodeIndex);
+    std::vector<NodeProperty> changed;
+    if (patched)
+    {
+        patched->DiffProperties(*prefab->GetNodes()[nodeIndex], changed);
+        std::sort(changed.begin(), changed.end());
+    }
+
+    // Drop the node's overrides that match the template again
+    bool modified = false;
+    auto nodeLess = [](const PrefabOverride &entry, uint32_t index) { return entry.nodeIndex < index; };
+    size_t first = std::lower_bound(overrides.begin(), overrides.end(), nodeIndex, nodeLess) - overrides.begin();
+    for (size_t i = first; i < overrides.size() && overrides[i].nodeIndex == nodeIndex;)
+    {
+        if (std::binary_search(changed.begin(), changed.end(), overrides[i].property))
+        {
+            i++;
+            continue;
+        }
+        RemoveOverride(i);
+        modified = true;
+    }
+
+    // Store the values that are new or differ from the stored ones
+    std::vector<uint8_t> value;
+    for (NodeProperty property : changed)
+    {
+        value.clear();
+        patched->GetProperty(property, value);
+
+        auto it = std::lower_bound(overrides.begin() + first, overrides.end(), property,
+                                   [nodeIndex](const PrefabOverride &entry, NodeProperty key)
+                                   { return entry.nodeIndex == nodeIndex && entry.property < key; });
+        if (it != overrides.end() && it->nodeIndex == nodeIndex && it->property == property)
+        {
+            if (it->size == value.size() && std::memcmp(overrideValues.data() + it->offset, value.data(), value.size()) == 0)
+                continue;
+
+            const size_t index = it - overrides.begin();
+            RemoveOverride(index);
+            it = overrides.begin() + index;
+        }
+
+        const PrefabOverride entry = {nodeIndex, property, static_cast<uint32_t>(overrideValues.size()), static_cast<uint32_t>(value.size())};
+        overrideValues.insert(overrideValues.end(), value.begin(), value.end());
+        overrides.insert(it, entry);
+        modified = true;
+    }
+
+    // A node without overrides shows the template's own, unless the inspector is editing it
+    if (changed.empty() && nodeIndex != inspectedNode)
+    {
+        DropPatchedNode(nodeIndex);
+    }
+    if (modified)
+    {
+        MarkVisualDirty();
+    }
+    return modified;
+}
+
+void PrefabInstance::RemoveOverride(size_t index)
+{
+    // Values after the removed one move down to close the gap
+    const PrefabOverride removed = overrides[index];
+    overrideValues.erase(overrideValues.begin() + removed.offset, overrideValues.begin() + removed.offset + removed.size);
+    overrides.erase(overrides.begin() + index);
+    for (PrefabOverride &entry : overrides)
+    {
+        if (entry.offset > removed.offset)
+            entry.offset -= removed.size;
+    }
+}
+
+void PrefabInstance::GetLocalBounds(float outMin[2], float outMax[2]) const
+{
+    if (prefab)
+    {
+        prefab->GetLocalBounds(outMin, outMax);
+        return;
+    }
+    Node2D::GetLocalBounds(outMin, outMax);
+}
+
+const StringAtom &PrefabInstance::GetTypeName() const
+{
+    static const StringAtom typeName("PrefabInstance");
+    return typeName;
+}
+
+void PrefabInstance::RenderInspectorProperties()
+{
+    // First render the transform properties from the base class
+    Node2D::RenderInspectorProperties();
+
+    ImGui::Separator();
+
+    // PrefabInstance-specific properties
+    ImGui::Text("Prefab Properties");
+
+    ImGui::Text("Prefab");
+    ImGui::SameLine(100);
+    ImGui::Text("%s (%d nodes)", prefab ? prefab->GetName().c_str() : "None", prefab ? static_cast<int>(prefab->GetNodes().size()) : 0);
+    if (!prefab)
+        return;
+
+    ImGui::Text("Overrides");
+    ImGui::SameLine(100);
+    ImGui::Text("%d", static_cast<int>(overrides.size()));
+    if (!overrides.empty() && ImGui::Button("Revert to Prefab"))
+    {
+        RevertToPrefab();
+    }
+
+    // Pick one of the prefab's nodes to change for this instance only
+    const std::vector<Node *> &templateNodes = prefab->GetNodes();
+    ImGui::Text("Node");
+    ImGui::SameLine(100);
+    if (ImGui::BeginCombo("##PrefabNode", templateNodes[inspectedNode]->name.c_str()))
+    {
+        for (uint32_t i = 0; i < templateNodes.size(); i++)
+        {
+            ImGui::PushID(static_cast<int>(i));
+            if (ImGui::Selectable(templateNodes[i]->name.c_str(), i == inspectedNode) && i != inspectedNode)
+            {
+                const uint32_t previous = inspectedNode;
+                inspectedNode = i;
+                SyncOverrides(previous);
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndCombo();
+    }
+
+    // The node's patched copy is edited in place, whatever ends up differing from the template becomes an override
+    Node *patched = PatchNode(inspectedNode);
+    if (!patched)
+        return;
+
+    ImGui::PushID("PrefabNode");
+    patched->RenderInspectorProperties();
+    ImGui::PopID();
+    SyncOverrides(inspectedNode);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../Node2D/Node2D.h"
+#include "Prefab.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief A property of one of the prefab's nodes that an instance changes
+ *
+ * The value is stored in the instance's value buffer at offset, encoded like
+ * Node::GetProperty.
+ */
+struct PrefabOverride
+{
+    uint32_t nodeIndex; // Index into Prefab::GetNodes()
+    NodeProperty property;
+    uint32_t offset;
+    uint32_t size;
+};
+
+/**
+ * @brief Placement of a prefab in the scene
+ *
+ * An instance is a single node that refers to the prefab's shared template:
+ * it is drawn, culled and picked as a whole from the template's nodes and
+ * bounds without owning any of them. Changes to the template's nodes are
+ * kept on the instance as sparse overrides, one value per changed node
+ * index and property, so changing one property of a large prefab costs that
+ * value rather than a copy of the template. A node with overrides gets a
+ * patched copy of itself, without children, that is drawn and inspected in
+ * place of the template node for this instance.
+ *
+ * Children added to an instance are ordinary scene nodes placed on top of
+ * the template.
+ */
+class PrefabInstance : public Node2D
+{
+public:
+    PrefabInstance(const StringAtom &nodeName, std::shared_ptr<const Prefab> prefab);
+    virtual ~PrefabInstance();
+
+    const std::shared_ptr<const Prefab> &GetPrefab() const;
+
+    // Change one template node for this instance, a value equal to the prefab's drops the override
+    /**
+     * Changes a property of one of the prefab's nodes for this instance only. Setting the prefab's own value
+     * removes the override again.
+     * @param nodeIndex Index of the node in the prefab, depth-first
+     * @param property Property to change
+     * @param value Encoded value
+     * @param size Size of the value in bytes
+     * @return False if the node or property doesn't exist
+     * @example instance->SetOverride(1, NodeProperty::Color, bytes, 16);
+     */
+    bool SetOverride(uint32_t nodeIndex, NodeProperty property, const uint8_t *value, size_t size);
+
+    // Drop every override, the instance shows the prefab unchanged again
+    /**
+     * Removes all of the instance's overrides, so it shows the prefab's nodes unchanged.
+     * @example instance->RevertToPrefab();
+     */
+    void RevertToPrefab();
+
+    // Overrides sorted by node index, then property
+    const std::vector<PrefabOverride> &GetOverrides() const;
+    const uint8_t *GetOverrideValue(const PrefabOverride &entry) const;
+
+    // The template node as this instance shows it, its patched copy if it has overrides
+    /**
+     * Gets one of the prefab's nodes with this instance's overrides applied. Nodes without overrides are the
+     * prefab's own, shared by every instance.
+     * @param nodeIndex Index of the node in the prefab, depth-first
+     * @return The node, or null if the index is out of range
+     * @example Node *node = instance->GetResolvedNode(0);
+     */
+    Node *GetResolvedNode(uint32_t nodeIndex) const;
+
+    // World transform of every template node placed at this instance, indexed like Prefab::GetNodes()
+    /**
+     * Computes where each of the prefab's nodes is placed by this instance, overrides included. Uses the
+     * instance's cached world transform, so it must be current.
+     * @param outWorld Receives one world transform per prefab node
+     * @example instance->GetNodeTransforms(transforms);
+     */
+    void GetNodeTransforms(std::vector<Node::Transform> &outWorld) const;
+
+    // Overrides carry over from an instance of the same prefab
+    virtual void CopyProperties(const Node &source) override;
+
+    // The instance covers the whole template
+    virtual void GetLocalBounds(float outMin[2], float outMax[2]) const override;
+
+    // Override base methods
+    virtual const StringAtom &GetTypeName() const override;
+    virtual void RenderInspectorProperties() override;
+
+private:
+    struct PatchedNode
+    {
+        uint32_t nodeIndex;
+        std::shared_ptr<Node> node;
+    };
+
+    Node *FindPatchedNode(uint32_t nodeIndex) const;
+    Node *PatchNode(uint32_t nodeIndex);
+    void DropPatchedNode(uint32_t nodeIndex);
+
+    // Rebuild one node's overrides from its patched copy, returns true if any changed
+    bool SyncOverrides(uint32_t nodeIndex);
+    void RemoveOverride(size_t index);
+
+    std::shared_ptr<const Prefab> prefab;
+    std::vector<PrefabOverride> overrides;   // Sorted by node index, then property
+    std::vector<uint8_t> overrideValues;
+    std::vector<PatchedNode> patchedNodes;   // Sorted by node index
+    uint32_t inspectedNode = 0;              // Template node shown in the inspector
+};
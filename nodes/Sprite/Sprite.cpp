@@ -1,21 +1,16 @@
 #include "Sprite.h"
 #include <imgui.h>
-#include "DocumentationManager.h"
+#include "NodeReflection.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <functional>
 
-Sprite::Sprite(const std::string &nodeName) : Node2D(nodeName, NodeType::Sprite)
+Sprite::Sprite(const StringAtom &nodeName) : ReflectedNode(nodeName, NodeType::Sprite)
 {
-    // Initialize documentation if not already done
-    static bool documentationInitialized = false;
-    if (!documentationInitialized)
-    {
-        documentationInitialized = true;
-        InitializeDocumentation();
-    }
 }
 
-Sprite::Sprite(const std::string &nodeName, NodeType nodeType) : Node2D(nodeName, nodeType)
+Sprite::Sprite(const StringAtom &nodeName, NodeType nodeType) : ReflectedNode(nodeName, nodeType)
 {
-    // Documentation is initialized in the other constructor
 }
 
 Sprite::~Sprite()
@@ -26,6 +21,11 @@ Sprite::~Sprite()
 void Sprite::SetTexture(const std::string &texturePath)
 {
     this->texturePath = texturePath;
+
+    // Fold the path hash into 16 bits - collisions only affect batching, not correctness
+    size_t hash = std::hash<std::string>{}(texturePath);
+    textureId = texturePath.empty() ? 0 : static_cast<uint16_t>((hash ^ (hash >> 16) ^ (hash >> 32) ^ (hash >> 48)) | 1u);
+    MarkVisualDirty();
 }
 
 void Sprite::SetColor(float r, float g, float b, float a)
@@ -34,6 +34,7 @@ void Sprite::SetColor(float r, float g, float b, float a)
     color[1] = g;
     color[2] = b;
     color[3] = a;
+    MarkVisualDirty();
 }
 
 const std::string &Sprite::GetTexturePath() const
@@ -46,6 +47,39 @@ const float *Sprite::GetColor() const
     return color;
 }
 
+void Sprite::SetLayer(int layer)
+{
+    this->layer = std::clamp(layer, 0, 255);
+    MarkVisualDirty();
+}
+
+int Sprite::GetLayer() const
+{
+    return layer;
+}
+
+void Sprite::SetZIndex(int zIndex)
+{
+    this->zIndex = std::clamp(zIndex, -32768, 32767);
+    MarkVisualDirty();
+}
+
+int Sprite::GetZIndex() const
+{
+    return zIndex;
+}
+
+void Sprite::SetYSortEnabled(bool enabled)
+{
+    ySort = enabled;
+    MarkVisualDirty();
+}
+
+bool Sprite::IsYSortEnabled() const
+{
+    return ySort;
+}
+
 void Sprite::Update(float deltaTime)
 {
     // Sprite specific update logic
@@ -63,77 +97,28 @@ void Sprite::Render()
     Node2D::Render();
 }
 
-void Sprite::RenderInspectorProperties()
+void Sprite::SubmitDraw(const Transform &world, RenderQueue &opaqueQueue, RenderQueue &transparentQueue)
 {
-    // First render the transform properties from the base class
-    Node2D::RenderInspectorProperties();
-
-    ImGui::Separator();
-
-    // Sprite-specific properties
-    ImGui::Text("Sprite Properties");
-
-    // Texture
-    ImGui::Text("Texture");
-    ImGui::SameLine(100);
-
-    // Display current texture path if any
-    std::string displayPath = texturePath.empty() ? "No texture selected" : texturePath;
-    ImGui::Text("%s", displayPath.c_str());
-    ImGui::SameLine();
-    if (ImGui::Button("Select##Texture"))
+    RenderQueue::DrawState state;
+    state.layer = static_cast<uint8_t>(layer);
+    state.zIndex = static_cast<int16_t>(zIndex);
+    state.depth = ySort ? world.position[1] : 0.0f;
+    state.pipeline = 0; // Default sprite pipeline
+    state.texture = textureId;
+
+    // Sprites with any transparency have to be blended in depth order
+    if (color[3] < 1.0f)
     {
-        // In a real implementation, this would open a file dialog
+        transparentQueue.Submit(state, this);
     }
+    else
+    {
+        opaqueQueue.Submit(state, this);
+    }
+}
 
-    // Color
-    ImGui::Text("Color");
-    ImGui::SameLine(100);
-    ImGui::ColorEdit4("##Color", color);
-}
-
-std::string Sprite::GetTypeName() const
-{
-    return "Sprite";
-}
-
-void Sprite::InitializeDocumentation()
-{
-    // Register node description
-    RegisterNodeDescription("Sprite", "A 2D sprite node for displaying images. Inherits from Node2D and adds texture and color properties.");
-
-    // Register SetTexture method
-    RegisterMethod("Sprite", {"SetTexture",
-                              "Sets the texture to be displayed by the sprite.",
-                              "void",
-                              "None",
-                              {{"texturePath", "Path to the texture file"}},
-                              {"sprite->SetTexture(\"assets/textures/player.png\");"}});
-
-    // Register SetColor method
-    RegisterMethod("Sprite", {"SetColor",
-                              "Sets the color tint of the sprite.",
-                              "void",
-                              "None",
-                              {{"r", "Red component (0.0 to 1.0)"},
-                               {"g", "Green component (0.0 to 1.0)"},
-                               {"b", "Blue component (0.0 to 1.0)"},
-                               {"a", "Alpha component (0.0 to 1.0, default: 1.0)"}},
-                              {"sprite->SetColor(1.0f, 0.5f, 0.5f, 0.8f); // Pink with 80% opacity"}});
-
-    // Register GetTexturePath method
-    RegisterMethod("Sprite", {"GetTexturePath",
-                              "Gets the path to the texture being displayed.",
-                              "const std::string&",
-                              "Reference to the texture path string",
-                              {},
-                              {"std::string texturePath = sprite->GetTexturePath();"}});
-
-    // Register GetColor method
-    RegisterMethod("Sprite", {"GetColor",
-                              "Gets the color tint of the sprite.",
-                              "const float*",
-                              "Pointer to an array of 4 floats representing the color [r, g, b, a]",
-                              {},
-                              {"const float* color = sprite->GetColor();\nfloat r = color[0];\nfloat g = color[1];\nfloat b = color[2];\nfloat a = color[3];"}});
+const StringAtom &Sprite::GetTypeName() const
+{
+    static const StringAtom typeName("Sprite");
+    return typeName;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "../Node2D/Node2D.h"
 #include <string>
+#include <cstdint>
 
 /**
  * @brief 2D Sprite node for displaying images
@@ -9,30 +10,130 @@
  * The Sprite class is used to display 2D images in the scene.
  * It inherits from Node2D and adds texture and color properties.
  */
-class Sprite : public Node2D
+class Sprite : public ReflectedNode<Sprite, Node2D>
 {
 public:
-    Sprite(const std::string &nodeName);
-    Sprite(const std::string &nodeName, NodeType nodeType);
+    Sprite(const StringAtom &nodeName);
+    Sprite(const StringAtom &nodeName, NodeType nodeType);
     virtual ~Sprite();
 
     // Sprite specific methods
+    /**
+     * Sets the texture to be displayed by the sprite.
+     * @param texturePath Path to the texture file
+     * @example sprite->SetTexture("assets/textures/player.png");
+     */
     void SetTexture(const std::string &texturePath);
+
+    /**
+     * Sets the color tint of the sprite.
+     * @param r Red component (0.0 to 1.0)
+     * @param g Green component (0.0 to 1.0)
+     * @param b Blue component (0.0 to 1.0)
+     * @param a Alpha component (0.0 to 1.0, default: 1.0)
+     * @example sprite->SetColor(1.0f, 0.5f, 0.5f, 0.8f); // Pink with 80% opacity
+     */
     void SetColor(float r, float g, float b, float a = 1.0f);
 
+    /**
+     * Gets the path to the texture being displayed.
+     * @return Reference to the texture path string
+     * @example std::string texturePath = sprite->GetTexturePath();
+     */
     const std::string &GetTexturePath() const;
+
+    /**
+     * Gets the color tint of the sprite.
+     * @return Pointer to an array of 4 floats representing the color [r, g, b, a]
+     * @example
+     * const float* color = sprite->GetColor();
+     * float r = color[0];
+     * float g = color[1];
+     * float b = color[2];
+     * float a = color[3];
+     */
     const float *GetColor() const;
 
+    // Draw ordering
+    /**
+     * Sets the canvas layer the sprite is drawn on. Lower layers are drawn first.
+     * @param layer Layer index (0 to 255)
+     * @example sprite->SetLayer(1); // Draw above layer 0
+     */
+    void SetLayer(int layer);
+
+    /**
+     * Gets the canvas layer the sprite is drawn on.
+     * @return The layer index
+     * @example int layer = sprite->GetLayer();
+     */
+    int GetLayer() const;
+
+    /**
+     * Sets the draw order of the sprite within its layer. Higher values are drawn on top.
+     * @param zIndex Z-index (-32768 to 32767)
+     * @example sprite->SetZIndex(10);
+     */
+    void SetZIndex(int zIndex);
+
+    /**
+     * Gets the draw order of the sprite within its layer.
+     * @return The z-index
+     * @example int zIndex = sprite->GetZIndex();
+     */
+    int GetZIndex() const;
+
+    /**
+     * Enables ordering by Y position between sprites that share a layer and z-index.
+     * @param enabled Whether Y sorting is enabled
+     * @example sprite->SetYSortEnabled(true); // Sprites lower on screen draw on top
+     */
+    void SetYSortEnabled(bool enabled);
+
+    /**
+     * Checks if the sprite is ordered by its Y position.
+     * @return True if Y sorting is enabled, false otherwise
+     * @example bool ySort = sprite->IsYSortEnabled();
+     */
+    bool IsYSortEnabled() const;
+
     // Override base methods
     virtual void Update(float deltaTime) override;
     virtual void Render() override;
-    virtual std::string GetTypeName() const override;
-    virtual void RenderInspectorProperties() override;
-
-    // Static documentation methods
-    static void InitializeDocumentation();
+    virtual void SubmitDraw(const Transform &world, RenderQueue &opaqueQueue, RenderQueue &transparentQueue) override;
+    virtual const StringAtom &GetTypeName() const override;
 
 private:
+    friend struct NodeFields<Sprite>;
+
     std::string texturePath;
     float color[4] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA
+    uint16_t textureId = 0;                     // Texture identifier used for batching, derived from texturePath
+
+    // Draw ordering
+    int layer = 0;      // Canvas layer (0 to 255)
+    int zIndex = 0;     // Z-index within the layer (-32768 to 32767)
+    bool ySort = false; // Order by Y position within the same z-index
+};
+
+// Reflected fields, see NodeReflection
+template <>
+struct NodeFields<Sprite>
+{
+    using Base = Node2D;
+    static constexpr const char *Section = "Sprite Properties";
+    static constexpr auto List = std::make_tuple(
+        Accessor<Sprite>(NodeProperty::Texture, "Texture", Widget(FieldWidget::Label), &Sprite::GetTexturePath, &Sprite::SetTexture),
+        Field(NodeProperty::Color, "Color", Widget(FieldWidget::Color4), &Sprite::color, &Sprite::MarkVisualDirty),
+        Accessor<Sprite>(NodeProperty::Layer, "Layer", Widget(FieldWidget::Int), &Sprite::GetLayer, &Sprite::SetLayer),
+        Accessor<Sprite>(NodeProperty::ZIndex, "Z Index", Widget(FieldWidget::Int), &Sprite::GetZIndex, &Sprite::SetZIndex),
+        Accessor<Sprite>(NodeProperty::YSort, "Y Sort", Widget(FieldWidget::Checkbox), &Sprite::IsYSortEnabled, &Sprite::SetYSortEnabled));
+};
+
+// Node type registration, fa-image icon
+template <>
+struct NodeTypeRegistration<NodeType::Sprite>
+{
+    static constexpr NodeTypeInfo Info = {"Sprite", "Sprite", "\xef\x83\x87", true,
+                                          &CreateRegisteredNode<Sprite>};
 };
\ No newline at end of file
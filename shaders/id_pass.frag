@@ -0,0 +1,12 @@
+#version 450
+
+// ID pass fragment shader - writes the node instance id of the covering primitive
+
+layout(location = 0) flat in uint inId;
+
+layout(location = 0) out uint outId;
+
+void main()
+{
+    outId = inId;
+}
@@ -0,0 +1,21 @@
+#version 450
+
+// ID pass vertex shader - takes ImGui vertices whose colour holds a node instance id
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec4 inColor;
+
+layout(push_constant) uniform PushConstants
+{
+    vec2 scale;
+    vec2 translate;
+} pushConstants;
+
+layout(location = 0) flat out uint outId;
+
+void main()
+{
+    // The colour attribute is read as UNORM, packing it again restores the original 32 bits
+    outId = packUnorm4x8(inColor);
+    gl_Position = vec4(inPosition * pushConstants.scale + pushConstants.translate, 0.0, 1.0);
+}
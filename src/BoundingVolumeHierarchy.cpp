@@ -0,0 +1,416 @@
+#include "BoundingVolumeHierarchy.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(float margin) : margin(margin)
+{
+}
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+    // Nothing to clean up
+}
+
+BoundingVolumeHierarchy::Box BoundingVolumeHierarchy::Union(const Box &a, const Box &b)
+{
+    Box result;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        result.min[axis] = std::min(a.min[axis], b.min[axis]);
+        result.max[axis] = std::max(a.max[axis], b.max[axis]);
+    }
+    return result;
+}
+
+float BoundingVolumeHierarchy::SurfaceArea(const Box &box)
+{
+    float dx = box.max[0] - box.min[0];
+    float dy = box.max[1] - box.min[1];
+    float dz = box.max[2] - box.min[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+bool BoundingVolumeHierarchy::ContainsBox(const Box &outer, const Box &inner)
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (inner.min[axis] < outer.min[axis] || inner.max[axis] > outer.max[axis])
+            return false;
+    }
+    return true;
+}
+
+bool BoundingVolumeHierarchy::RayHitsBox(const Box &box, const float origin[3], const float inverseDirection[3], float maxDistance, float &outDistance)
+{
+    // Slab test, infinite inverse directions handle axis-parallel rays
+    float entry = 0.0f;
+    float exit = maxDistance;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+        float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+
+        // A ray lying exactly on a slab plane gives NaN, treat it as inside when within the slab
+        if (std::isnan(t1) || std::isnan(t2))
+        {
+            if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis])
+                return false;
+            continue;
+        }
+
+        entry = std::max(entry, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+        if (entry > exit)
+            return false;
+    }
+    outDistance = entry;
+    return true;
+}
+
+int BoundingVolumeHierarchy::AllocateNode()
+{
+    if (freeList >= 0)
+    {
+        int index = freeList;
+        freeList = nodes[index].parent;
+        nodes[index] = TreeNode();
+        return index;
+    }
+
+    nodes.emplace_back();
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void BoundingVolumeHierarchy::FreeNode(int index)
+{
+    // Free slots are chained through the parent index
+    nodes[index].node = nullptr;
+    nodes[index].height = -1;
+    nodes[index].parent = freeList;
+    freeList = index;
+}
+
+void BoundingVolumeHierarchy::Update(Node *node, const float boundsMin[3], const float boundsMax[3])
+{
+    Box exact;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        exact.min[axis] = boundsMin[axis];
+        exact.max[axis] = boundsMax[axis];
+    }
+
+    auto it = leafLookup.find(node);
+    if (it != leafLookup.end())
+    {
+        // Moves inside the enlarged box don't touch the tree
+        TreeNode &leaf = nodes[it->second];
+        leaf.exact = exact;
+        if (ContainsBox(leaf.box, exact))
+            return;
+
+        RemoveLeaf(it->second);
+    }
+    else
+    {
+        int index = AllocateNode();
+        nodes[index].node = node;
+        nodes[index].exact = exact;
+        it = leafLookup.emplace(node, index).first;
+    }
+
+    TreeNode &leaf = nodes[it->second];
+    for (int axis = 0; axis < 3; axis++)
+    {
+        leaf.box.min[axis] = exact.min[axis] - margin;
+        leaf.box.max[axis] = exact.max[axis] + margin;
+    }
+    InsertLeaf(it->second);
+}
+
+void BoundingVolumeHierarchy::Remove(Node *node)
+{
+    auto it = leafLookup.find(node);
+    if (it == leafLookup.end())
+        return;
+
+    RemoveLeaf(it->second);
+    FreeNode(it->second);
+    leafLookup.erase(it);
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+    nodes.clear();
+    leafLookup.clear();
+    root = -1;
+    freeList = -1;
+}
+
+void BoundingVolumeHierarchy::InsertLeaf(int leaf)
+{
+    if (root < 0)
+    {
+        root = leaf;
+        nodes[leaf].parent = -1;
+        return;
+    }
+
+    // Walk down picking the child whose growth adds the least surface area
+    const Box leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].IsLeaf())
+    {
+        const TreeNode &current = nodes[index];
+        float area = SurfaceArea(current.box);
+        float combinedArea = SurfaceArea(Union(current.box, leafBox));
+
+        // Cost of pairing with this node, and the extra cost every level below pays for growing it
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCost[2];
+        const int children[2] = {current.child1, current.child2};
+        for (int i = 0; i < 2; i++)
+        {
+            const TreeNode &child = nodes[children[i]];
+            float grownArea = SurfaceArea(Union(child.box, leafBox));
+            childCost[i] = child.IsLeaf() ? grownArea + inheritanceCost
+                                          : grownArea - SurfaceArea(child.box) + inheritanceCost;
+        }
+
+        if (cost < childCost[0] && cost < childCost[1])
+            break;
+
+        index = childCost[0] < childCost[1] ? current.child1 : current.child2;
+    }
+    const int sibling = index;
+
+    // Replace the sibling with a new parent holding both
+    const int oldParent = nodes[sibling].parent;
+    const int newParent = AllocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = Union(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent >= 0)
+    {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+
+    RefitAncestors(nodes[leaf].parent);
+}
+
+void BoundingVolumeHierarchy::RemoveLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = -1;
+        return;
+    }
+
+    // The sibling takes the parent's place
+    const int parent = nodes[leaf].parent;
+    const int grandParent = nodes[parent].parent;
+    const int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent >= 0)
+    {
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        RefitAncestors(grandParent);
+    }
+    else
+    {
+        root = sibling;
+        nodes[sibling].parent = -1;
+        FreeNode(parent);
+    }
+    nodes[leaf].parent = -1;
+}
+
+void BoundingVolumeHierarchy::RefitAncestors(int index)
+{
+    while (index >= 0)
+    {
+        index = Balance(index);
+
+        TreeNode &current = nodes[index];
+        current.height = 1 + std::max(nodes[current.child1].height, nodes[current.child2].height);
+        current.box = Union(nodes[current.child1].box, nodes[current.child2].box);
+        index = current.parent;
+    }
+}
+
+int BoundingVolumeHierarchy::Balance(int a)
+{
+    // Rotate the taller grandchild up when the two sides differ by more than one level
+    if (nodes[a].IsLeaf() || nodes[a].height < 2)
+        return a;
+
+    const int b = nodes[a].child1;
+    const int c = nodes[a].child2;
+    const int balance = nodes[c].height - nodes[b].height;
+    if (balance >= -1 && balance <= 1)
+        return a;
+
+    // Promote the taller child: 'up' replaces a, 'down' is its sibling which stays under a
+    const int up = balance > 1 ? c : b;
+    const int down = balance > 1 ? b : c;
+    const int f = nodes[up].child1;
+    const int g = nodes[up].child2;
+
+    // Swap a and up
+    nodes[up].child1 = a;
+    nodes[up].parent = nodes[a].parent;
+    nodes[a].parent = up;
+
+    if (nodes[up].parent >= 0)
+    {
+        TreeNode &upParent = nodes[nodes[up].parent];
+        if (upParent.child1 == a)
+            upParent.child1 = up;
+        else
+            upParent.child2 = up;
+    }
+    else
+    {
+        root = up;
+    }
+
+    // The taller grandchild stays under up, the shorter one moves under a
+    const int keep = nodes[f].height > nodes[g].height ? f : g;
+    const int move = keep == f ? g : f;
+    nodes[up].child2 = keep;
+    nodes[a].child1 = down;
+    nodes[a].child2 = move;
+    nodes[move].parent = a;
+
+    nodes[a].box = Union(nodes[down].box, nodes[move].box);
+    nodes[a].height = 1 + std::max(nodes[down].height, nodes[move].height);
+    nodes[up].box = Union(nodes[a].box, nodes[keep].box);
+    nodes[up].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+    return up;
+}
+
+void BoundingVolumeHierarchy::QueryPoint(float x, float y, std::vector<Node *> &outNodes) const
+{
+    if (root < 0)
+        return;
+
+    std::vector<int> stack;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+        const TreeNode &current = nodes[stack.back()];
+        stack.pop_back();
+
+        if (x < current.box.min[0] || x > current.box.max[0] || y < current.box.min[1] || y > current.box.max[1])
+            continue;
+
+        if (current.IsLeaf())
+        {
+            if (x >= current.exact.min[0] && x <= current.exact.max[0] && y >= current.exact.min[1] && y <= current.exact.max[1])
+            {
+                outNodes.push_back(current.node);
+            }
+        }
+        else
+        {
+            stack.push_back(current.child1);
+            stack.push_back(current.child2);
+        }
+    }
+}
+
+Node *BoundingVolumeHierarchy::RayCast(const float origin[3], const float direction[3], float maxDistance, float *outDistance) const
+{
+    if (root < 0)
+        return nullptr;
+
+    float inverseDirection[3];
+    for (int axis = 0; axis < 3; axis++)
+    {
+        inverseDirection[axis] = 1.0f / direction[axis];
+    }
+
+    // Boxes further than the closest hit so far are skipped
+    Node *closest = nullptr;
+    float closestDistance = maxDistance;
+    float distance;
+
+    std::vector<int> stack;
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+        const TreeNode &current = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!RayHitsBox(current.box, origin, inverseDirection, closestDistance, distance))
+            continue;
+
+        if (current.IsLeaf())
+        {
+            if (RayHitsBox(current.exact, origin, inverseDirection, closestDistance, distance) &&
+                (!closest || distance < closestDistance))
+            {
+                closest = current.node;
+                closestDistance = distance;
+            }
+        }
+        else
+        {
+            stack.push_back(current.child1);
+            stack.push_back(current.child2);
+        }
+    }
+
+    if (closest && outDistance)
+    {
+        *outDistance = closestDistance;
+    }
+    return closest;
+}
+
+bool BoundingVolumeHierarchy::GetBounds(float outMin[3], float outMax[3]) const
+{
+    if (root < 0)
+        return false;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        outMin[axis] = nodes[root].box.min[axis];
+        outMax[axis] = nodes[root].box.max[axis];
+    }
+    return true;
+}
+
+bool BoundingVolumeHierarchy::Contains(const Node *node) const
+{
+    return leafLookup.find(node) != leafLookup.end();
+}
+
+size_t BoundingVolumeHierarchy::GetSize() const
+{
+    return leafLookup.size();
+}
+
+int BoundingVolumeHierarchy::GetHeight() const
+{
+    return root >= 0 ? nodes[root].height : 0;
+}
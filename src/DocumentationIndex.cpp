@@ -0,0 +1,418 @@
+#include "DocumentationIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+
+namespace
+{
+    // Score added by a match in each kind of field, indexed by FieldKind
+    const float FieldWeights[] = {
+        6.0f,  // NodeType
+        10.0f, // MethodName
+        4.0f,  // ParamName
+        3.0f,  // Description
+        2.0f,  // ParamDescription
+        2.0f,  // ReturnType
+        1.0f,  // ReturnDescription
+    };
+
+    char ToLower(char c)
+    {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    bool IsWordChar(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0;
+    }
+
+    bool IsUpper(char c)
+    {
+        return std::isupper(static_cast<unsigned char>(c)) != 0;
+    }
+
+    bool IsLower(char c)
+    {
+        return std::islower(static_cast<unsigned char>(c)) != 0;
+    }
+
+    uint32_t PackTrigram(const char *chars)
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(chars[0])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(chars[1])) << 8) |
+               static_cast<uint32_t>(static_cast<unsigned char>(chars[2]));
+    }
+}
+
+void DocumentationIndex::Build()
+{
+    Clear();
+
+    for (const NodeDoc &node : NodeDocumentation::GetNodes())
+    {
+        for (const MethodDoc &method : node.methods)
+        {
+            const uint32_t entry = static_cast<uint32_t>(methods.size());
+            methods.push_back({&node, &method, static_cast<uint32_t>(fields.size())});
+
+            AddField(entry, FieldKind::NodeType, node.nodeType);
+            AddField(entry, FieldKind::MethodName, method.name);
+            AddField(entry, FieldKind::Description, method.description);
+            for (const ParamDoc &param : method.params)
+            {
+                AddField(entry, FieldKind::ParamName, param.name);
+                AddField(entry, FieldKind::ParamDescription, param.description);
+            }
+            AddField(entry, FieldKind::ReturnType, method.returnType);
+            AddField(entry, FieldKind::ReturnDescription, method.returnDesc);
+        }
+    }
+
+    // Words stay in field order for Refine, their sorted order puts a prefix in one contiguous range
+    sortedWords.resize(words.size());
+    std::iota(sortedWords.begin(), sortedWords.end(), 0);
+    std::sort(sortedWords.begin(), sortedWords.end(), [this](uint32_t a, uint32_t b)
+              { return GetWordText(words[a]) < GetWordText(words[b]); });
+
+    // Fields were added in order, so a stable radix sort on the 24-bit trigram leaves each posting list sorted by field
+    std::vector<TrigramEntry> sorted(trigrams.size());
+    for (int shift = 0; shift < 24; shift += 12)
+    {
+        std::vector<uint32_t> counts(4097, 0);
+        for (const TrigramEntry &entry : trigrams)
+        {
+            counts[((entry.trigram >> shift) & 4095) + 1]++;
+        }
+        for (size_t i = 1; i < counts.size(); i++)
+        {
+            counts[i] += counts[i - 1];
+        }
+        for (const TrigramEntry &entry : trigrams)
+        {
+            sorted[counts[(entry.trigram >> shift) & 4095]++] = entry;
+        }
+        trigrams.swap(sorted);
+    }
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end(), [](const TrigramEntry &a, const TrigramEntry &b)
+                               { return a.trigram == b.trigram && a.field == b.field; }),
+                   trigrams.end());
+    trigrams.shrink_to_fit();
+
+    methodScores.assign(methods.size(), 0.0f);
+    methodTerms.assign(methods.size(), 0);
+    fieldMarks.assign(fields.size(), 0);
+    currentMark = 0;
+
+    // Grown to their worst case up front, so queries never allocate
+    lowerQuery.reserve(256);
+    matchedMethods.reserve(methods.size());
+    candidates.reserve(methods.size());
+}
+
+void DocumentationIndex::Clear()
+{
+    methods.clear();
+    fields.clear();
+    words.clear();
+    sortedWords.clear();
+    trigrams.clear();
+    text.clear();
+    methodScores.clear();
+    methodTerms.clear();
+    fieldMarks.clear();
+    matchedMethods.clear();
+}
+
+void DocumentationIndex::AddField(uint32_t method, FieldKind kind, std::string_view value)
+{
+    if (value.empty())
+        return;
+
+    const uint32_t fieldIndex = static_cast<uint32_t>(fields.size());
+    const uint32_t offset = static_cast<uint32_t>(text.size());
+    fields.push_back({method, offset, static_cast<uint32_t>(value.size()), static_cast<uint32_t>(words.size()), kind});
+    for (char c : value)
+    {
+        text.push_back(ToLower(c));
+    }
+
+    // Words end at punctuation and at camelCase humps, "SetZIndex" is "set", "z" and "index"
+    size_t wordStart = std::string_view::npos;
+    for (size_t i = 0; i <= value.size(); i++)
+    {
+        const bool wordChar = i < value.size() && IsWordChar(value[i]);
+        bool boundary = !wordChar;
+        if (wordChar && wordStart != std::string_view::npos && IsUpper(value[i]))
+        {
+            boundary = IsLower(value[i - 1]) || (i + 1 < value.size() && IsLower(value[i + 1]) && IsUpper(value[i - 1]));
+        }
+
+        if (boundary && wordStart != std::string_view::npos)
+        {
+            words.push_back({offset + static_cast<uint32_t>(wordStart), static_cast<uint32_t>(i - wordStart), fieldIndex});
+            wordStart = std::string_view::npos;
+        }
+        if (wordChar && wordStart == std::string_view::npos)
+        {
+            wordStart = i;
+        }
+    }
+
+    for (size_t i = 0; i + 3 <= value.size(); i++)
+    {
+        trigrams.push_back({PackTrigram(text.data() + offset + i), fieldIndex});
+    }
+}
+
+std::string_view DocumentationIndex::GetFieldText(const FieldEntry &field) const
+{
+    return std::string_view(text).substr(field.offset, field.length);
+}
+
+std::string_view DocumentationIndex::GetWordText(const WordEntry &word) const
+{
+    return std::string_view(text).substr(word.offset, word.length);
+}
+
+void DocumentationIndex::Search(std::string_view query, std::vector<Hit> &outHits)
+{
+    candidates.clear();
+    RunQuery(query, false, outHits);
+}
+
+bool DocumentationIndex::CanRefine(std::string_view previousQuery, std::string_view query)
+{
+    // A query of only spaces matched nothing, so its empty hits can't be narrowed into anything
+    if (previousQuery.find_first_not_of(" \t") == std::string_view::npos || query.size() < previousQuery.size())
+        return false;
+    for (size_t i = 0; i < previousQuery.size(); i++)
+    {
+        if (ToLower(previousQuery[i]) != ToLower(query[i]))
+            return false;
+    }
+
+    // Appended terms only narrow the hits, and so does extending the last term, unless that takes
+    // it from a word prefix to a substring, which can match inside words the prefix did not
+    size_t termStart = previousQuery.find_last_of(" \t");
+    termStart = termStart == std::string_view::npos ? 0 : termStart + 1;
+    const size_t previousLength = previousQuery.size() - termStart;
+    const size_t length = std::min(query.find_first_of(" \t", termStart), query.size()) - termStart;
+    return previousLength == 0 || previousLength >= 3 || length < 3;
+}
+
+void DocumentationIndex::Refine(std::string_view query, std::vector<Hit> &hits)
+{
+    candidates.clear();
+    for (const Hit &hit : hits)
+    {
+        candidates.push_back(hit.entry);
+    }
+    RunQuery(query, true, hits);
+}
+
+void DocumentationIndex::RunQuery(std::string_view query, bool refine, std::vector<Hit> &outHits)
+{
+    outHits.clear();
+
+    lowerQuery.assign(query.begin(), query.end());
+    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ToLower);
+
+    // Refined candidates count as having matched a term before the query's, so only they can match its terms
+    uint32_t termIndex = 0;
+    size_t liveMethods = methods.size();
+    if (refine)
+    {
+        for (uint32_t method : candidates)
+        {
+            methodTerms[method] = 1;
+            matchedMethods.push_back(method);
+        }
+        termIndex = 1;
+        liveMethods = candidates.size();
+    }
+    const uint32_t firstTerm = termIndex;
+
+    // Every whitespace separated term has to match, each narrows the methods left by the previous ones
+    std::string_view remaining = lowerQuery;
+    while (liveMethods > 0)
+    {
+        size_t start = remaining.find_first_not_of(" \t");
+        if (start == std::string_view::npos)
+            break;
+        remaining.remove_prefix(start);
+        size_t end = std::min(remaining.find_first_of(" \t"), remaining.size());
+
+        liveMethods = MatchTerm(remaining.substr(0, end), termIndex, liveMethods);
+        termIndex++;
+        remaining.remove_prefix(end);
+    }
+
+    if (liveMethods > 0 && termIndex > firstTerm)
+    {
+        for (uint32_t method : matchedMethods)
+        {
+            if (methodTerms[method] == termIndex)
+            {
+                outHits.push_back({methods[method].node, methods[method].doc, methodScores[method], method});
+            }
+        }
+
+        // Best first, ties in the order the documentation browser lists them, which is the order methods were indexed in
+        std::sort(outHits.begin(), outHits.end(), [](const Hit &a, const Hit &b)
+                  { return a.score != b.score ? a.score > b.score : a.entry < b.entry; });
+    }
+
+    // Leave the scratch clean for the next query
+    for (uint32_t method : matchedMethods)
+    {
+        methodScores[method] = 0.0f;
+        methodTerms[method] = 0;
+    }
+    matchedMethods.clear();
+}
+
+size_t DocumentationIndex::MatchTerm(std::string_view term, uint32_t termIndex, size_t liveMethods)
+{
+    currentMark++;
+    size_t matched = 0;
+
+    // Once few methods are left checking their own fields beats walking a long posting list, compared
+    // by the entries each would visit, the posting's length against the live methods' share of all entries
+    if (term.size() >= 3)
+    {
+        // Only fields holding the term's rarest trigram can contain it
+        auto rarestBegin = trigrams.end();
+        auto rarestEnd = trigrams.end();
+        for (size_t i = 0; i + 3 <= term.size(); i++)
+        {
+            const uint32_t trigram = PackTrigram(term.data() + i);
+            auto range = std::equal_range(trigrams.begin(), trigrams.end(), TrigramEntry{trigram, 0},
+                                          [](const TrigramEntry &a, const TrigramEntry &b)
+                                          { return a.trigram < b.trigram; });
+            if (range.first == range.second)
+                return 0;
+            if (rarestBegin == trigrams.end() || range.second - range.first < rarestEnd - rarestBegin)
+            {
+                rarestBegin = range.first;
+                rarestEnd = range.second;
+            }
+        }
+
+        if (termIndex > 0 && liveMethods * fields.size() < static_cast<size_t>(rarestEnd - rarestBegin) * methods.size())
+            return MatchLiveMethods(term, termIndex);
+
+        for (auto it = rarestBegin; it != rarestEnd; ++it)
+        {
+            size_t position = GetFieldText(fields[it->field]).find(term);
+            if (position != std::string_view::npos)
+            {
+                matched += ScoreField(it->field, position, term.size(), termIndex, IsWordStart(fields[it->field], position));
+            }
+        }
+    }
+    else
+    {
+        // Short terms only match the start of a word
+        auto begin = std::lower_bound(sortedWords.begin(), sortedWords.end(), term, [this](uint32_t word, std::string_view prefix)
+                                      { return GetWordText(words[word]) < prefix; });
+        auto end = std::upper_bound(begin, sortedWords.end(), term, [this](std::string_view prefix, uint32_t word)
+                                    { return prefix < GetWordText(words[word]).substr(0, prefix.size()); });
+
+        if (termIndex > 0 && liveMethods * words.size() < static_cast<size_t>(end - begin) * methods.size())
+            return MatchLiveMethods(term, termIndex);
+
+        for (auto it = begin; it != end; ++it)
+        {
+            const WordEntry &word = words[*it];
+            matched += ScoreField(word.field, word.offset - fields[word.field].offset, term.size(), termIndex, true);
+        }
+    }
+    return matched;
+}
+
+size_t DocumentationIndex::MatchLiveMethods(std::string_view term, uint32_t termIndex)
+{
+    size_t matched = 0;
+
+    // Same matching as the posting lists, over the fields of each method that matched every earlier term
+    for (uint32_t method : matchedMethods)
+    {
+        if (methodTerms[method] != termIndex)
+            continue;
+
+        const uint32_t fieldEnd = method + 1 < methods.size() ? methods[method + 1].firstField : static_cast<uint32_t>(fields.size());
+        for (uint32_t fieldIndex = methods[method].firstField; fieldIndex < fieldEnd; fieldIndex++)
+        {
+            const FieldEntry &field = fields[fieldIndex];
+            if (term.size() >= 3)
+            {
+                size_t position = GetFieldText(field).find(term);
+                if (position != std::string_view::npos)
+                {
+                    matched += ScoreField(fieldIndex, position, term.size(), termIndex, IsWordStart(field, position));
+                }
+                continue;
+            }
+
+            const uint32_t wordEnd = fieldIndex + 1 < fields.size() ? fields[fieldIndex + 1].firstWord : static_cast<uint32_t>(words.size());
+            for (uint32_t wordIndex = field.firstWord; wordIndex < wordEnd; wordIndex++)
+            {
+                const WordEntry &word = words[wordIndex];
+                if (GetWordText(word).compare(0, term.size(), term) == 0)
+                {
+                    matched += ScoreField(fieldIndex, word.offset - field.offset, term.size(), termIndex, true);
+                    break;
+                }
+            }
+        }
+    }
+    return matched;
+}
+
+bool DocumentationIndex::IsWordStart(const FieldEntry &field, size_t position) const
+{
+    return position == 0 || !IsWordChar(text[field.offset + position - 1]);
+}
+
+bool DocumentationIndex::ScoreField(uint32_t fieldIndex, size_t position, size_t termLength, uint32_t termIndex, bool wordStart)
+{
+    const FieldEntry &field = fields[fieldIndex];
+    const uint32_t method = field.method;
+
+    // The method has to have matched every earlier term, and a field counts once per term
+    if (methodTerms[method] < termIndex || fieldMarks[fieldIndex] == currentMark)
+        return false;
+    fieldMarks[fieldIndex] = currentMark;
+
+    float weight = FieldWeights[static_cast<size_t>(field.kind)];
+    if (wordStart)
+    {
+        weight *= 2.0f;
+    }
+    if (position == 0 && termLength == field.length)
+    {
+        weight *= 2.0f;
+    }
+    methodScores[method] += weight;
+
+    if (methodTerms[method] != termIndex)
+        return false;
+    methodTerms[method] = termIndex + 1;
+    if (termIndex == 0)
+    {
+        matchedMethods.push_back(method);
+    }
+    return true;
+}
+
+size_t DocumentationIndex::GetMethodCount() const
+{
+    return methods.size();
+}
+
+size_t DocumentationIndex::GetMemoryUsage() const
+{
+    return methods.capacity() * sizeof(MethodEntry) + fields.capacity() * sizeof(FieldEntry) +
+           words.capacity() * sizeof(WordEntry) + sortedWords.capacity() * sizeof(uint32_t) + trigrams.capacity() * sizeof(TrigramEntry) + text.capacity() +
+           methodScores.capacity() * sizeof(float) + (methodTerms.capacity() + fieldMarks.capacity()) * sizeof(uint32_t);
+}
@@ -1,22 +1,32 @@
 #include "DocumentationManager.h"
 #include "imgui.h"
-#include "Node.h"
-#include <algorithm>
-#include <cctype>
-#include "../nodes/Camera/Camera.h"
-#include "../nodes/Camera2D/Camera2D.h"
-#include "../nodes/Camera3D/Camera3D.h"
+#include <cstdio>
+#include <cstring>
 
-// Initialize static members
-std::map<std::string, std::vector<MethodDoc>> DocumentationManager::nodeDocumentation;
-std::map<std::string, std::string> DocumentationManager::nodeDescriptions;
+namespace
+{
+    // "returnType name(param, param)", formatted into a caller buffer as it is redrawn every frame
+    void FormatSignature(const MethodDoc &method, char *buffer, size_t size)
+    {
+        int length = snprintf(buffer, size, "%s %s(", method.returnType, method.name);
+        for (size_t i = 0; i < method.params.size() && length >= 0 && static_cast<size_t>(length) < size; ++i)
+        {
+            length += snprintf(buffer + length, size - length, i + 1 < method.params.size() ? "%s, " : "%s",
+                               method.params[i].name);
+        }
+        if (length >= 0 && static_cast<size_t>(length) < size)
+        {
+            snprintf(buffer + length, size - length, ")");
+        }
+    }
+}
 
 DocumentationManager::DocumentationManager()
 {
     // Initialize with default values
     isVisible = false;
-    selectedNodeType = "";
-    selectedMethod = "";
+    selectedNode = nullptr;
+    selectedMethod = nullptr;
 }
 
 DocumentationManager::~DocumentationManager()
@@ -24,12 +34,6 @@ DocumentationManager::~DocumentationManager()
     // Nothing to clean up
 }
 
-void DocumentationManager::Init()
-{
-    // Load documentation for all node types
-    LoadDocumentation();
-}
-
 void DocumentationManager::ShowDocumentation()
 {
     isVisible = true;
@@ -61,44 +65,6 @@ bool DocumentationManager::HandleKeyPress(int key, int scancode, int action, int
     return false;
 }
 
-void DocumentationManager::RegisterNodeDocumentation(const std::string &nodeType, const std::vector<MethodDoc> &methods)
-{
-    // Add or replace the documentation for this node type
-    nodeDocumentation[nodeType] = methods;
-}
-
-void DocumentationManager::RegisterNodeDescription(const std::string &nodeType, const std::string &description)
-{
-    // Add or replace the description for this node type
-    nodeDescriptions[nodeType] = description;
-}
-
-std::map<std::string, std::vector<MethodDoc>> &DocumentationManager::GetNodeDocumentation()
-{
-    return nodeDocumentation;
-}
-
-std::map<std::string, std::string> &DocumentationManager::GetNodeDescriptions()
-{
-    return nodeDescriptions;
-}
-
-void DocumentationManager::LoadDocumentation()
-{
-    // Explicitly initialize documentation for all node types
-    // This ensures documentation is available even if no instances have been created
-
-    // Base node
-    Node::InitializeDocumentation();
-
-    // Camera nodes
-    Camera::InitializeDocumentation();
-    Camera2D::InitializeDocumentation();
-    Camera3D::InitializeDocumentation();
-
-    // Other node types will register their documentation when they are instantiated
-}
-
 void DocumentationManager::Render()
 {
     if (!isVisible)
@@ -134,7 +100,7 @@ void DocumentationManager::Render()
         ImGui::Separator();
 
         // If search query is not empty, show search results
-        if (!searchQuery.empty())
+        if (searchQuery[0] != '\0')
         {
             RenderSearchResults();
         }
@@ -150,20 +116,20 @@ void DocumentationManager::Render()
             // Right column: Method list and details
             ImGui::NextColumn();
 
-            if (!selectedNodeType.empty())
+            if (selectedNode)
             {
                 // Show node description
-                ImGui::TextWrapped("%s", nodeDescriptions[selectedNodeType].c_str());
+                ImGui::TextWrapped("%s", selectedNode->description);
                 ImGui::Separator();
 
                 // Show method list for the selected node type
-                RenderMethodList(selectedNodeType);
+                RenderMethodList(*selectedNode);
 
                 // Show method details if a method is selected
-                if (!selectedMethod.empty())
+                if (selectedMethod)
                 {
                     ImGui::Separator();
-                    RenderMethodDetails(selectedNodeType, selectedMethod);
+                    RenderMethodDetails(*selectedMethod);
                 }
             }
 
@@ -189,19 +155,8 @@ void DocumentationManager::RenderSearchBar()
     // Search input
     ImGui::PushItemWidth(inputWidth);
 
-    // ImGui::InputText requires a char buffer, not a std::string
-    static char searchBuffer[256] = "";
-    if (ImGui::InputText("##SearchInput", searchBuffer, sizeof(searchBuffer), ImGuiInputTextFlags_EnterReturnsTrue))
-    {
-        searchQuery = searchBuffer;
-        UpdateSearchResults();
-    }
-
-    // Update searchQuery if buffer changes
-    if (searchQuery != searchBuffer)
-    {
-        searchQuery = searchBuffer;
-    }
+    // ImGui::InputText edits the query buffer directly
+    ImGui::InputText("##SearchInput", searchQuery, sizeof(searchQuery));
 
     ImGui::PopItemWidth();
 
@@ -209,131 +164,44 @@ void DocumentationManager::RenderSearchBar()
     ImGui::SameLine();
     if (ImGui::Button("Clear", ImVec2(buttonWidth, 0)))
     {
-        searchQuery.clear();
-        searchResults.clear();
-        // Also clear the buffer
-        memset(searchBuffer, 0, sizeof(searchBuffer));
+        searchQuery[0] = '\0';
     }
 
     // Update search results as user types
-    static std::string lastQuery;
-    if (searchQuery != lastQuery)
+    if (strcmp(searchQuery, searchedQuery) != 0)
     {
         UpdateSearchResults();
-        lastQuery = searchQuery;
     }
 }
 
 void DocumentationManager::UpdateSearchResults()
 {
-    searchResults.clear();
-
-    if (searchQuery.empty())
+    if (searchQuery[0] == '\0')
     {
+        searchResults.clear();
+        searchedQuery[0] = '\0';
         return;
     }
 
-    // Convert search query to lowercase for case-insensitive search
-    std::string lowerQuery = searchQuery;
-    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(),
-                   [](unsigned char c)
-                   { return std::tolower(c); });
-
-    // Search through all node types and methods
-    for (const auto &nodePair : nodeDocumentation)
+    // The documentation is compiled in, so the index is built once, on the first search
+    if (!searchIndexBuilt)
     {
-        const std::string &nodeType = nodePair.first;
-
-        // Search in node type name
-        std::string lowerNodeType = nodeType;
-        std::transform(lowerNodeType.begin(), lowerNodeType.end(), lowerNodeType.begin(),
-                       [](unsigned char c)
-                       { return std::tolower(c); });
-
-        if (lowerNodeType.find(lowerQuery) != std::string::npos)
-        {
-            // Add all methods of this node type to results
-            for (const auto &method : nodePair.second)
-            {
-                searchResults.push_back(std::make_pair(nodeType, method));
-            }
-            continue; // Skip individual method search for this node
-        }
-
-        // Search in methods
-        for (const auto &method : nodePair.second)
-        {
-            // Convert method name to lowercase
-            std::string lowerMethodName = method.name;
-            std::transform(lowerMethodName.begin(), lowerMethodName.end(), lowerMethodName.begin(),
-                           [](unsigned char c)
-                           { return std::tolower(c); });
-
-            // Search in method name
-            if (lowerMethodName.find(lowerQuery) != std::string::npos)
-            {
-                searchResults.push_back(std::make_pair(nodeType, method));
-                continue;
-            }
-
-            // Search in method description
-            std::string lowerDesc = method.description;
-            std::transform(lowerDesc.begin(), lowerDesc.end(), lowerDesc.begin(),
-                           [](unsigned char c)
-                           { return std::tolower(c); });
-
-            if (lowerDesc.find(lowerQuery) != std::string::npos)
-            {
-                searchResults.push_back(std::make_pair(nodeType, method));
-                continue;
-            }
-
-            // Search in parameter names and descriptions
-            bool foundInParams = false;
-            for (const auto &param : method.params)
-            {
-                std::string lowerParamName = param.first;
-                std::transform(lowerParamName.begin(), lowerParamName.end(), lowerParamName.begin(),
-                               [](unsigned char c)
-                               { return std::tolower(c); });
-
-                std::string lowerParamDesc = param.second;
-                std::transform(lowerParamDesc.begin(), lowerParamDesc.end(), lowerParamDesc.begin(),
-                               [](unsigned char c)
-                               { return std::tolower(c); });
-
-                if (lowerParamName.find(lowerQuery) != std::string::npos ||
-                    lowerParamDesc.find(lowerQuery) != std::string::npos)
-                {
-                    searchResults.push_back(std::make_pair(nodeType, method));
-                    foundInParams = true;
-                    break;
-                }
-            }
-
-            if (foundInParams)
-            {
-                continue;
-            }
-
-            // Search in return type and description
-            std::string lowerReturnType = method.returnType;
-            std::transform(lowerReturnType.begin(), lowerReturnType.end(), lowerReturnType.begin(),
-                           [](unsigned char c)
-                           { return std::tolower(c); });
-
-            std::string lowerReturnDesc = method.returnDesc;
-            std::transform(lowerReturnDesc.begin(), lowerReturnDesc.end(), lowerReturnDesc.begin(),
-                           [](unsigned char c)
-                           { return std::tolower(c); });
+        searchIndex.Build();
+        searchIndexBuilt = true;
+        searchResults.reserve(searchIndex.GetMethodCount());
+    }
 
-            if (lowerReturnType.find(lowerQuery) != std::string::npos ||
-                lowerReturnDesc.find(lowerQuery) != std::string::npos)
-            {
-                searchResults.push_back(std::make_pair(nodeType, method));
-            }
-        }
+    // Hits come ranked from the index, methods matching in their name first. Typing mostly
+    // extends the query, and narrowing the previous results is cheaper than searching again.
+    if (DocumentationIndex::CanRefine(searchedQuery, searchQuery))
+    {
+        searchIndex.Refine(searchQuery, searchResults);
     }
+    else
+    {
+        searchIndex.Search(searchQuery, searchResults);
+    }
+    memcpy(searchedQuery, searchQuery, sizeof(searchedQuery));
 }
 
 void DocumentationManager::RenderSearchResults()
@@ -343,67 +211,57 @@ void DocumentationManager::RenderSearchResults()
 
     if (searchResults.empty())
     {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "No results found for '%s'", searchQuery.c_str());
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "No results found for '%s'", searchQuery);
         return;
     }
 
     // Display search results
-    for (const auto &result : searchResults)
+    for (const DocumentationIndex::Hit &result : searchResults)
     {
-        const std::string &nodeType = result.first;
-        const MethodDoc &method = result.second;
+        const char *nodeType = result.node->nodeType;
+        const MethodDoc &method = *result.method;
 
         // Create a unique ID for this result
-        std::string resultId = nodeType + "::" + method.name;
+        char resultId[256];
+        snprintf(resultId, sizeof(resultId), "%s::%s", nodeType, method.name);
 
-        if (ImGui::CollapsingHeader(resultId.c_str()))
+        if (ImGui::CollapsingHeader(resultId))
         {
             ImGui::Indent();
 
             // Node type
-            ImGui::TextColored(ImVec4(0.5f, 0.5f, 1.0f, 1.0f), "Node Type: %s", nodeType.c_str());
+            ImGui::TextColored(ImVec4(0.5f, 0.5f, 1.0f, 1.0f), "Node Type: %s", nodeType);
 
             // Method signature
-            std::string signature = method.returnType + " " + method.name + "(";
-            for (size_t i = 0; i < method.params.size(); ++i)
-            {
-                signature += method.params[i].first;
-                if (i < method.params.size() - 1)
-                {
-                    signature += ", ";
-                }
-            }
-            signature += ")";
-            ImGui::TextColored(ImVec4(0.0f, 0.8f, 0.0f, 1.0f), "%s", signature.c_str());
+            char signature[512];
+            FormatSignature(method, signature, sizeof(signature));
+            ImGui::TextColored(ImVec4(0.0f, 0.8f, 0.0f, 1.0f), "%s", signature);
 
             // Method description
-            ImGui::TextWrapped("%s", method.description.c_str());
+            ImGui::TextWrapped("%s", method.description);
 
             // Parameters
             if (!method.params.empty())
             {
                 ImGui::Separator();
                 ImGui::Text("Parameters:");
-                for (const auto &param : method.params)
+                for (const ParamDoc &param : method.params)
                 {
-                    ImGui::BulletText("%s: %s", param.first.c_str(), param.second.c_str());
+                    ImGui::BulletText("%s: %s", param.name, param.description);
                 }
             }
 
             // Return value
             ImGui::Separator();
-            ImGui::Text("Returns: %s", method.returnDesc.c_str());
+            ImGui::Text("Returns: %s", method.returnDesc);
 
-            // Examples
-            if (!method.examples.empty())
+            // Example
+            if (method.example[0] != '\0')
             {
                 ImGui::Separator();
                 ImGui::Text("Example:");
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 0.0f, 1.0f));
-                for (const auto &example : method.examples)
-                {
-                    ImGui::TextWrapped("%s", example.c_str());
-                }
+                ImGui::TextWrapped("%s", method.example);
                 ImGui::PopStyleColor();
             }
 
@@ -417,15 +275,13 @@ void DocumentationManager::RenderNodeList()
     ImGui::Text("Node Types:");
     ImGui::BeginChild("NodeList", ImVec2(0, 0), true);
 
-    for (const auto &pair : nodeDocumentation)
+    for (const NodeDoc &node : NodeDocumentation::GetNodes())
     {
-        const std::string &nodeType = pair.first;
-
-        bool isSelected = (selectedNodeType == nodeType);
-        if (ImGui::Selectable(nodeType.c_str(), isSelected))
+        bool isSelected = (selectedNode == &node);
+        if (ImGui::Selectable(node.nodeType, isSelected))
         {
-            selectedNodeType = nodeType;
-            selectedMethod = ""; // Clear selected method when changing node type
+            selectedNode = &node;
+            selectedMethod = nullptr; // Clear selected method when changing node type
         }
 
         if (isSelected)
@@ -437,128 +293,70 @@ void DocumentationManager::RenderNodeList()
     ImGui::EndChild();
 }
 
-void DocumentationManager::RenderMethodList(const std::string &nodeType)
+void DocumentationManager::RenderMethodList(const NodeDoc &node)
 {
     ImGui::Text("Methods:");
     ImGui::BeginChild("MethodList", ImVec2(0, 150), true);
 
-    // Safety check for empty node type
-    if (nodeType.empty())
+    if (node.methods.empty())
     {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Select a node type first");
-        ImGui::EndChild();
-        return;
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "No methods found for %s", node.nodeType);
     }
-
-    auto it = nodeDocumentation.find(nodeType);
-    if (it != nodeDocumentation.end())
+    else
     {
-        if (it->second.empty())
-        {
-            ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "No methods found for %s", nodeType.c_str());
-        }
-        else
+        for (const MethodDoc &method : node.methods)
         {
-            for (const auto &method : it->second)
+            bool isSelected = (selectedMethod == &method);
+            if (ImGui::Selectable(method.name, isSelected))
             {
-                bool isSelected = (selectedMethod == method.name);
-                if (ImGui::Selectable(method.name.c_str(), isSelected))
-                {
-                    selectedMethod = method.name;
-                }
+                selectedMethod = &method;
+            }
 
-                if (isSelected)
-                {
-                    ImGui::SetItemDefaultFocus();
-                }
+            if (isSelected)
+            {
+                ImGui::SetItemDefaultFocus();
             }
         }
     }
-    else
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Node type not found: %s", nodeType.c_str());
-    }
 
     ImGui::EndChild();
 }
 
-void DocumentationManager::RenderMethodDetails(const std::string &nodeType, const std::string &methodName)
+void DocumentationManager::RenderMethodDetails(const MethodDoc &method)
 {
-    // Safety check for empty inputs
-    if (nodeType.empty() || methodName.empty())
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Select a method to view details");
-        return;
-    }
-
-    auto nodeIt = nodeDocumentation.find(nodeType);
-    if (nodeIt == nodeDocumentation.end())
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Node type not found: %s", nodeType.c_str());
-        return;
-    }
-
-    // Find the method in the node's documentation
-    const MethodDoc *methodDoc = nullptr;
-    for (const auto &method : nodeIt->second)
-    {
-        if (method.name == methodName)
-        {
-            methodDoc = &method;
-            break;
-        }
-    }
-
-    if (!methodDoc)
-    {
-        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Method not found: %s", methodName.c_str());
-        return;
-    }
-
     ImGui::Text("Method Details:");
     ImGui::BeginChild("MethodDetails", ImVec2(0, 0), true);
 
     // Method signature
-    std::string signature = methodDoc->returnType + " " + methodDoc->name + "(";
-    for (size_t i = 0; i < methodDoc->params.size(); ++i)
-    {
-        signature += methodDoc->params[i].first;
-        if (i < methodDoc->params.size() - 1)
-        {
-            signature += ", ";
-        }
-    }
-    signature += ")";
-    ImGui::TextColored(ImVec4(0.0f, 0.8f, 0.0f, 1.0f), "%s", signature.c_str());
+    char signature[512];
+    FormatSignature(method, signature, sizeof(signature));
+    ImGui::TextColored(ImVec4(0.0f, 0.8f, 0.0f, 1.0f), "%s", signature);
 
     // Method description
-    ImGui::TextWrapped("%s", methodDoc->description.c_str());
+    ImGui::TextWrapped("%s", method.description);
 
     // Parameters
-    if (!methodDoc->params.empty())
+    if (!method.params.empty())
     {
         ImGui::Separator();
         ImGui::Text("Parameters:");
-        for (const auto &param : methodDoc->params)
+        for (const ParamDoc &param : method.params)
         {
-            ImGui::BulletText("%s: %s", param.first.c_str(), param.second.c_str());
+            ImGui::BulletText("%s: %s", param.name, param.description);
         }
     }
 
     // Return value
     ImGui::Separator();
-    ImGui::Text("Returns: %s", methodDoc->returnDesc.c_str());
+    ImGui::Text("Returns: %s", method.returnDesc);
 
-    // Examples
-    if (!methodDoc->examples.empty())
+    // Example
+    if (method.example[0] != '\0')
     {
         ImGui::Separator();
         ImGui::Text("Example:");
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 0.0f, 1.0f));
-        for (const auto &example : methodDoc->examples)
-        {
-            ImGui::TextWrapped("%s", example.c_str());
-        }
+        ImGui::TextWrapped("%s", method.example);
         ImGui::PopStyleColor();
     }
 
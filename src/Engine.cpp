@@ -47,7 +47,8 @@ bool Engine::Init()
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow *w, int width, int height)
                                    {
         auto engine = reinterpret_cast<Engine*>(glfwGetWindowUserPointer(w));
-        engine->framebufferResized.store(true); });
+        engine->framebufferResized.store(true);
+        WakeFromWindow(w); });
 
     // Set keyboard callback
     glfwSetKeyCallback(window, KeyCallback);
@@ -57,6 +58,9 @@ bool Engine::Init()
         return false;
     }
 
+    // Input wakes the idle loop. Installed before ImGui so its backend chains to them.
+    InstallWakeCallbacks();
+
     VkApplicationInfo appInfo{};
     appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
     appInfo.pApplicationName = "EGE-2D";
@@ -94,6 +98,7 @@ bool Engine::Init()
     CreateDescriptorPool();
     SetupImGui();
     CreateSyncObjects();
+    idPickingPass.Init(physicalDevice, device, swapChainExtent);
 
     // Initialize UI
     if (!ui.Init())
@@ -102,6 +107,9 @@ bool Engine::Init()
         return false;
     }
 
+    // The UI has built the font atlas, start its upload without waiting for it
+    fontTexture.Upload(physicalDevice, device, graphicsQueue, commandPool, ImGui::GetIO().Fonts);
+
     return true;
 }
 
@@ -109,8 +117,21 @@ void Engine::MainLoop()
 {
     while (isRunning && !glfwWindowShouldClose(window))
     {
-        // Process window events
-        glfwPollEvents();
+        // Process window events, sleeping while the editor is idle
+        if (idleMode)
+        {
+            // Time spent asleep isn't a missed frame
+            if (WaitForRedraw())
+            {
+                framePacer.Reset();
+            }
+            if (!isRunning)
+                break;
+        }
+        else
+        {
+            glfwPollEvents();
+        }
 
         // Check if window should close
         if (glfwWindowShouldClose(window))
@@ -119,6 +140,9 @@ void Engine::MainLoop()
             break;
         }
 
+        // Hold the frame until its scheduled start
+        framePacer.WaitForNextFrame();
+
         // Signal render thread that a new frame is ready to be processed
         {
             std::lock_guard<std::mutex> lock(renderMutex);
@@ -133,11 +157,126 @@ void Engine::MainLoop()
         {
             std::this_thread::yield();
         }
+        lastFrameTime = glfwGetTime();
+
+        // Keep drawing while the scene or the UI is still changing, or a pick is being read back
+        if (ui.NeedsRedraw() || idPickingPass.HasPendingPick())
+        {
+            redrawRequested = true;
+        }
     }
 
     // Signal render thread to stop
     StopThreads();
     vkDeviceWaitIdle(device);
+
+    if (framePacer.GetMode() == FramePacer::Mode::Benchmark)
+    {
+        const FramePacer::Stats &stats = framePacer.GetStats();
+        std::cout << "Frames: " << stats.frameCount
+                  << ", average " << stats.averageFrameTime << " ms"
+                  << ", deviation " << stats.frameTimeDeviation << " ms"
+                  << ", worst " << stats.worstFrameTime << " ms" << std::endl;
+    }
+}
+
+bool Engine::WaitForRedraw()
+{
+    bool waited = false;
+    while (isRunning)
+    {
+        // Anything pending draws right away, otherwise sleep until an event or the keep-alive
+        bool pending = framesToDraw > 0 || redrawRequested;
+        double remaining = idleKeepAlive - (glfwGetTime() - lastFrameTime);
+        if (pending || remaining <= 0.0)
+        {
+            glfwPollEvents();
+        }
+        else
+        {
+            glfwWaitEventsTimeout(remaining);
+            waited = true;
+        }
+
+        if (glfwWindowShouldClose(window))
+            return waited;
+
+        // Input callbacks refill framesToDraw, each frame consumes one
+        int frames = framesToDraw;
+        while (frames > 0 && !framesToDraw.compare_exchange_weak(frames, frames - 1))
+        {
+        }
+        bool requested = redrawRequested.exchange(false);
+        bool keepAliveDue = glfwGetTime() - lastFrameTime >= idleKeepAlive;
+        if (frames > 0 || requested || keepAliveDue)
+            return waited;
+    }
+    return waited;
+}
+
+void Engine::RequestRedraw()
+{
+    redrawRequested = true;
+
+    // Wake the event loop if it is waiting
+    glfwPostEmptyEvent();
+}
+
+void Engine::SetIdleMode(bool enabled)
+{
+    idleMode = enabled;
+    RequestRedraw();
+}
+
+bool Engine::IsIdleMode() const
+{
+    return idleMode;
+}
+
+void Engine::SetIdleKeepAlive(double seconds)
+{
+    idleKeepAlive = seconds > 0.0 ? seconds : 0.0;
+}
+
+void Engine::SetFramePacing(FramePacer::Mode mode, double targetFrameRate)
+{
+    framePacer.SetMode(mode);
+    framePacer.SetTargetFrameRate(targetFrameRate);
+
+    // Only the editor sleeps between frames, games and benchmarks draw continuously
+    idleMode = mode == FramePacer::Mode::Editor;
+}
+
+const FramePacer &Engine::GetFramePacer() const
+{
+    return framePacer;
+}
+
+void Engine::WakeFromWindow(GLFWwindow *window)
+{
+    auto engine = reinterpret_cast<Engine *>(glfwGetWindowUserPointer(window));
+    if (engine)
+    {
+        engine->framesToDraw = FramesAfterInput;
+    }
+}
+
+void Engine::InstallWakeCallbacks()
+{
+    glfwSetCursorPosCallback(window, [](GLFWwindow *w, double, double)
+                             { WakeFromWindow(w); });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow *w, int, int, int)
+                               { WakeFromWindow(w); });
+    glfwSetScrollCallback(window, [](GLFWwindow *w, double, double)
+                          { WakeFromWindow(w); });
+    glfwSetCharCallback(window, [](GLFWwindow *w, unsigned int)
+                        { WakeFromWindow(w); });
+    glfwSetCursorEnterCallback(window, [](GLFWwindow *w, int)
+                               { WakeFromWindow(w); });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow *w, int)
+                               { WakeFromWindow(w); });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow *w)
+                                 { WakeFromWindow(w); });
 }
 
 void Engine::RenderLoop()
@@ -170,12 +309,20 @@ void Engine::RenderLoop()
 
 void Engine::Cleanup()
 {
+    // The font texture's descriptor set is freed through the ImGui backend, so before it shuts down
+    if (device != VK_NULL_HANDLE)
+    {
+        vkDeviceWaitIdle(device);
+        fontTexture.Cleanup();
+    }
+
     // Cleanup ImGui resources
     CleanupImGui();
 
     if (device != VK_NULL_HANDLE)
     {
         vkDeviceWaitIdle(device);
+        idPickingPass.Cleanup();
 
         // Destroy sync objects
         vkDestroySemaphore(device, renderFinishedSemaphore, nullptr);
@@ -365,6 +512,19 @@ void Engine::CreateSwapChain()
 
     VkSurfaceFormatKHR surfaceFormat = formats[0];
     VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+
+    // Outside the editor the frame pacer sets the rate, so vsync is relaxed when the surface allows it
+    if (framePacer.GetMode() != FramePacer::Mode::Editor)
+    {
+        VkPresentModeKHR preferred = framePacer.GetMode() == FramePacer::Mode::Benchmark ? VK_PRESENT_MODE_IMMEDIATE_KHR : VK_PRESENT_MODE_MAILBOX_KHR;
+        for (VkPresentModeKHR mode : presentModes)
+        {
+            if (mode == preferred || (mode == VK_PRESENT_MODE_MAILBOX_KHR && presentMode == VK_PRESENT_MODE_FIFO_KHR))
+            {
+                presentMode = mode;
+            }
+        }
+    }
     // Determine swapchain extent (handling window resizing)
     int width = 0, height = 0;
     glfwGetFramebufferSize(window, &width, &height);
@@ -579,30 +739,6 @@ void Engine::SetupImGui()
     initInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 
     ImGui_ImplVulkan_Init(&initInfo);
-
-    // Upload fonts
-    VkCommandBuffer cmd;
-    VkCommandBufferAllocateInfo cmdAlloc{};
-    cmdAlloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cmdAlloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cmdAlloc.commandPool = commandPool;
-    cmdAlloc.commandBufferCount = 1;
-    vkAllocateCommandBuffers(device, &cmdAlloc, &cmd);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
-    ImGui_ImplVulkan_CreateFontsTexture();
-    vkEndCommandBuffer(cmd);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue);
-    ImGui_ImplVulkan_DestroyFontsTexture();
 }
 
 void Engine::CleanupImGui()
@@ -614,6 +750,17 @@ void Engine::CleanupImGui()
 
 void Engine::DrawFrame()
 {
+    // Refresh world transforms and everything derived from the scene once per frame, whether or not the
+    // frame gets drawn, so recorded changes never pile up
+    NodeChangeBus::Flush();
+
+    // Apply a GPU pick whose readback finished since the last frame
+    uint32_t pickedId;
+    if (idPickingPass.PollResult(pickedId))
+    {
+        ui.ApplyGpuPickResult(pickedId);
+    }
+
     if (framebufferResized.load())
     {
         framebufferResized.store(false);
@@ -647,7 +794,9 @@ void Engine::DrawFrame()
     rpInfo.pClearValues = &clearColor;
     vkCmdBeginRenderPass(commandBuffers[imageIndex], &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-    ImGui_ImplVulkan_NewFrame();
+    // ImGui_ImplVulkan_NewFrame is left out, all it does is create and upload the backend's own
+    // font texture, synchronously, when it has none. The atlas is already on its way through fontTexture.
+    fontTexture.Poll();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
@@ -655,9 +804,21 @@ void Engine::DrawFrame()
     ui.Render();
 
     ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffers[imageIndex]);
+    ImDrawData *drawData = ImGui::GetDrawData();
+    ImGui_ImplVulkan_RenderDrawData(drawData, commandBuffers[imageIndex]);
 
     vkCmdEndRenderPass(commandBuffers[imageIndex]);
+
+    // Render node ids for a click. While an earlier pick or its readback is in flight the request stays with the
+    // UI, along with the id geometry captured on the frame of the click, so a delayed pick still sees the nodes
+    ImVec2 pickPos;
+    if (!idPickingPass.HasPendingPick() && ui.TakeGpuPickRequest(pickPos))
+    {
+        idPickingPass.RequestPick(static_cast<int>((pickPos.x - drawData->DisplayPos.x) * drawData->FramebufferScale.x),
+                                  static_cast<int>((pickPos.y - drawData->DisplayPos.y) * drawData->FramebufferScale.y));
+    }
+    idPickingPass.Record(commandBuffers[imageIndex], ui.GetIdPickGeometry(), drawData->DisplayPos, drawData->DisplaySize, drawData->FramebufferScale);
+
     vkEndCommandBuffer(commandBuffers[imageIndex]);
 
     VkSemaphore waitSems[] = {imageAvailableSemaphore};
@@ -673,7 +834,8 @@ void Engine::DrawFrame()
     submitInfo.signalSemaphoreCount = 1;
     submitInfo.pSignalSemaphores = signalSems;
 
-    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+    // The id readback completes with this submission's fence
+    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, idPickingPass.TakeSubmitFence()) != VK_SUCCESS)
     {
         throw std::runtime_error("failed to submit draw command buffer!");
     }
@@ -725,6 +887,7 @@ void Engine::RecreateSwapChain()
     CreateImageViews();
     CreateFramebuffers();
     CreateCommandBuffers();
+    idPickingPass.Resize(swapChainExtent);
     // Update ImGui with new image count
     ImGui_ImplVulkan_SetMinImageCount(static_cast<uint32_t>(swapChainImages.size()));
 }
@@ -735,6 +898,7 @@ void Engine::KeyCallback(GLFWwindow *window, int key, int scancode, int action,
     auto engine = reinterpret_cast<Engine *>(glfwGetWindowUserPointer(window));
     if (!engine)
         return;
+    WakeFromWindow(window);
 
     // Forward the key event to the UI for documentation handling
     engine->ui.HandleDocumentationKeyPress(key, scancode, action, mods);
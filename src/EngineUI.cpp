@@ -1,4 +1,6 @@
 #include "EngineUI.h"
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <filesystem>
 #include <imgui.h>
@@ -6,27 +8,32 @@
 #include "Node.h"
 #include "../nodes/Node2D/Node2D.h"
 #include "../nodes/Sprite/Sprite.h"
+#include "../nodes/Camera2D/Camera2D.h"
+#include "../nodes/Camera3D/Camera3D.h"
+#include "../nodes/Light2D/Light2D.h"
+#include "../nodes/Label/Label.h"
+#include "../nodes/PrefabInstance/PrefabInstance.h"
+#include "SceneFile.h"
+#include "TextSceneFile.h"
+#include "FontAtlasCache.h"
 
 EngineUI::EngineUI()
 {
-    // Initialize node counters
-    for (int i = 0; i < static_cast<int>(NodeType::Panel) + 1; i++)
-    {
-        nodeCounters[static_cast<NodeType>(i)] = 0;
-    }
-
     InitializeSceneHierarchy();
+    changeSubscription = NodeChangeBus::Subscribe(NodeChangeTransform | NodeChangeVisual | NodeChangeDestroyed,
+                                                  [this](const std::vector<NodeChangeEvent> &events)
+                                                  { UpdateSceneIndex(events); });
 }
 
-EngineUI::~EngineUI() {}
+EngineUI::~EngineUI()
+{
+    NodeChangeBus::Unsubscribe(changeSubscription);
+}
 
 void EngineUI::InitializeSceneHierarchy()
 {
     // Initialize node counters
-    for (int i = 0; i < static_cast<int>(NodeType::Panel) + 1; i++)
-    {
-        nodeCounters[static_cast<NodeType>(i)] = 0;
-    }
+    nodeCounters.fill(0);
 
     // Create root node
     rootNode = std::make_shared<Node>(GenerateUniqueName(NodeType::Root), NodeType::Root);
@@ -45,13 +52,116 @@ void EngineUI::InitializeSceneHierarchy()
 
     // Create a UI node with custom name
     auto ui = std::make_shared<Node2D>("UI", NodeType::Node2D);
-    nodeCounters[NodeType::Node2D]++; // Manually increment for this custom-named node
-    rootNode->children.push_back(ui);
+    nodeCounters[static_cast<size_t>(NodeType::Node2D)]++; // Manually increment for this custom-named node
+    rootNode->AddChild(ui);
 
     AddChildNode(ui, NodeType::Label);
     AddChildNode(ui, NodeType::Button);
 }
 
+bool EngineUI::SaveScene(const std::string &path)
+{
+    // The extension picks the text or binary format
+    bool saved = TextSceneFile::IsTextScenePath(path) ? TextSceneFile::Save(rootNode.get(), path) : SceneFile::Save(rootNode.get(), path);
+    if (!saved)
+    {
+        std::cerr << "Failed to save scene: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool EngineUI::LoadScene(const std::string &path)
+{
+    std::shared_ptr<Node> loadedRoot = TextSceneFile::IsTextScenePath(path) ? TextSceneFile::Load(path) : SceneFile::Load(path);
+    if (!loadedRoot)
+    {
+        std::cerr << "Failed to load scene: " << path << std::endl;
+        return false;
+    }
+
+    // Drop everything that points into the old tree, its nodes leave the scene index as they are destroyed
+    worldPartition.Close();
+    ClearSelection();
+    inspectorRecording.Cancel();
+    gizmoRecording.Cancel();
+    journal.Clear();
+    rootNode = loadedRoot;
+    hierarchyRowsDirty = true;
+
+    // New nodes are numbered after the loaded ones
+    nodeCounters.fill(0);
+    std::vector<Node *> stack = {rootNode.get()};
+    while (!stack.empty())
+    {
+        Node *node = stack.back();
+        stack.pop_back();
+        nodeCounters[static_cast<size_t>(node->type)]++;
+        for (auto &child : node->children)
+        {
+            stack.push_back(child.get());
+        }
+    }
+    return true;
+}
+
+void EngineUI::ToggleWorldStreaming()
+{
+    if (worldPartition.IsOpen())
+    {
+        worldPartition.Close();
+        return;
+    }
+
+    std::shared_ptr<Node> worldRoot = std::make_shared<Node>("World", NodeType::Root);
+    if (!worldPartition.Open(worldDirectory, worldSettings))
+    {
+        std::cerr << "Failed to open world: " << worldDirectory << std::endl;
+        return;
+    }
+
+    // The streamed world replaces the scene, cells are attached under an empty root as they load
+    ClearSelection();
+    inspectorRecording.Cancel();
+    gizmoRecording.Cancel();
+    journal.Clear();
+    rootNode = worldRoot;
+    hierarchyRowsDirty = true;
+}
+
+void EngineUI::UpdateWorldStreaming()
+{
+    if (!worldPartition.IsOpen())
+        return;
+
+    // Follow the scene camera when there is one, otherwise whatever the editor is looking at
+    float focusX = camera2D.posX;
+    float focusY = camera2D.posY;
+    Camera2D *activeCamera = Camera2D::GetActiveCamera();
+    if (activeCamera && activeCamera->IsInTree(rootNode.get()))
+    {
+        focusX = activeCamera->worldTransform.position[0];
+        focusY = activeCamera->worldTransform.position[1];
+    }
+
+    worldPartition.Update(rootNode.get(), focusX, focusY);
+}
+
+void EngineUI::Undo()
+{
+    // Close any edit still in progress so it is undone first
+    journal.Commit(inspectorRecording);
+    journal.Commit(gizmoRecording);
+    journal.Undo();
+}
+
+void EngineUI::Redo()
+{
+    journal.Commit(inspectorRecording);
+    journal.Commit(gizmoRecording);
+    journal.Redo();
+}
+
 bool EngineUI::Init()
 {
     // Load fonts and setup theme
@@ -63,9 +173,6 @@ bool EngineUI::Init()
 
     SetupTheme();
 
-    // Initialize documentation manager
-    docManager.Init();
-
     return true;
 }
 
@@ -73,6 +180,24 @@ void EngineUI::HandleDocumentationKeyPress(int key, int scancode, int action, in
 {
     docManager.HandleKeyPress(key, scancode, action, mods);
 
+    // Undo and redo, left to text fields while one is being typed in
+    if (action == 1 && (mods & 0x2) && !ImGui::GetIO().WantTextInput) // Key press with Ctrl
+    {
+        if (key == 90) // Z key - Undo, or Redo with Shift
+        {
+            if (mods & 0x1)
+                Redo();
+            else
+                Undo();
+            return;
+        }
+        if (key == 89) // Y key - Redo
+        {
+            Redo();
+            return;
+        }
+    }
+
     // Handle gizmo operation shortcuts
     if (action == 1) // Key press
     {
@@ -134,35 +259,14 @@ bool EngineUI::LoadFonts()
         // Continue anyway, we'll just have no icons
     }
 
-    // Setup icon mappings
-    SetupIcons();
-
-    return true;
-}
-
-void EngineUI::SetupIcons()
-{
-    // Map node types to Font Awesome 5 icons with more appropriate choices
-    // These are Unicode values for Font Awesome 5 icons
-    nodeIcons[NodeType::Root] = "\xef\x81\x80";            // fa-sitemap
-    nodeIcons[NodeType::Node2D] = "\xef\x81\x88";          // fa-square-o (empty square representing a 2D node)
-    nodeIcons[NodeType::Sprite] = "\xef\x83\x87";          // fa-image
-    nodeIcons[NodeType::CharacterBody2D] = "\xef\x86\x8e"; // fa-user
-    nodeIcons[NodeType::Camera] = "\xef\x80\xbd";          // fa-camera
-    nodeIcons[NodeType::Light] = "\xef\x83\x85";           // fa-lightbulb
-    nodeIcons[NodeType::Label] = "\xef\x81\x9e";           // fa-font
-    nodeIcons[NodeType::Button] = "\xef\x81\x95";          // fa-hand-pointer-o
-    nodeIcons[NodeType::Panel] = "\xef\x84\xa6";           // fa-window-maximize
-}
-
-const char *EngineUI::GetNodeIcon(NodeType type)
-{
-    auto it = nodeIcons.find(type);
-    if (it != nodeIcons.end())
+    // Bake the atlas now, from the cache left by an earlier launch when the fonts haven't changed
+    if (!FontAtlasCache::Build(io.Fonts, "cache/editor_fonts.atlas"))
     {
-        return it->second;
+        std::cerr << "Failed to build font atlas" << std::endl;
+        return false;
     }
-    return "\xef\x81\x90"; // fa-question-circle as fallback
+
+    return true;
 }
 
 void EngineUI::SetupTheme()
@@ -219,6 +323,13 @@ void EngineUI::SetupTheme()
 
 void EngineUI::Render()
 {
+    // Cells attached here are indexed when the engine next flushes the change bus
+    UpdateWorldStreaming();
+
+    // The ID pass only runs on frames where a click may complete and select something
+    idPickGeometry.Clear();
+    idCaptureActive = gpuPicking && selectionPressPending && ImGui::IsMouseReleased(ImGuiMouseButton_Left);
+
     // Set the main font for the UI
     ImGui::PushFont(mainFont);
 
@@ -312,6 +423,16 @@ void EngineUI::Render()
     docManager.Render();
 
     ImGui::PopFont();
+
+    // Edits made this frame are only visible next frame, and drags or text input keep the UI live
+    needsRedraw = NodeChangeBus::HasPendingChanges() || ImGui::IsAnyItemActive() ||
+                  ImGui::IsMouseDragging(ImGuiMouseButton_Left) || ImGui::IsMouseDragging(ImGuiMouseButton_Middle) ||
+                  ImGui::IsMouseDragging(ImGuiMouseButton_Right) || worldPartition.IsStreaming() || showDemoWindow;
+}
+
+bool EngineUI::NeedsRedraw() const
+{
+    return needsRedraw;
 }
 
 void EngineUI::RenderTopBar()
@@ -325,13 +446,28 @@ void EngineUI::RenderTopBar()
             }
             if (ImGui::MenuItem("Open Scene", "Ctrl+O"))
             {
+                LoadScene(scenePath);
             }
             if (ImGui::MenuItem("Save Scene", "Ctrl+S"))
             {
+                SaveScene(scenePath);
             }
             if (ImGui::MenuItem("Save Scene As", "Ctrl+Shift+S"))
             {
             }
+            if (ImGui::MenuItem("Export Text Scene"))
+            {
+                SaveScene(textScenePath);
+            }
+            ImGui::Separator();
+            if (ImGui::MenuItem("Export World Cells"))
+            {
+                WorldPartition::Export(rootNode.get(), worldDirectory, worldSettings.cellSize);
+            }
+            if (ImGui::MenuItem("Stream World", nullptr, worldPartition.IsOpen()))
+            {
+                ToggleWorldStreaming();
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit", "Alt+F4"))
             {
@@ -341,11 +477,13 @@ void EngineUI::RenderTopBar()
 
         if (ImGui::BeginMenu("Edit"))
         {
-            if (ImGui::MenuItem("Undo", "Ctrl+Z"))
+            if (ImGui::MenuItem("Undo", "Ctrl+Z", false, journal.CanUndo()))
             {
+                Undo();
             }
-            if (ImGui::MenuItem("Redo", "Ctrl+Y"))
+            if (ImGui::MenuItem("Redo", "Ctrl+Y", false, journal.CanRedo()))
             {
+                Redo();
             }
             ImGui::Separator();
             if (ImGui::MenuItem("Cut", "Ctrl+X"))
@@ -365,6 +503,9 @@ void EngineUI::RenderTopBar()
             if (ImGui::MenuItem("Toggle ImGui Demo", nullptr, &showDemoWindow))
             {
             }
+            if (ImGui::MenuItem("GPU Picking", nullptr, &gpuPicking))
+            {
+            }
             ImGui::EndMenu();
         }
 
@@ -407,46 +548,10 @@ void EngineUI::RenderScenePanel()
 
     if (ImGui::BeginPopup("AddNodePopup"))
     {
-        // Get available node types from Node class
-        std::vector<NodeType> nodeTypes = Node::GetAvailableNodeTypes();
-
-        // Display menu items for each node type
-        for (const auto &type : nodeTypes)
+        // Display menu items for each registered node type
+        for (NodeType type : NodeTypeRegistry::GetCreatableTypes())
         {
-            // Get name based on type
-            std::string name;
-            switch (type)
-            {
-            case NodeType::Node2D:
-                name = "Node2D";
-                break;
-            case NodeType::Sprite:
-                name = "Sprite";
-                break;
-            case NodeType::CharacterBody2D:
-                name = "CharacterBody2D";
-                break;
-            case NodeType::Camera:
-                name = "Camera";
-                break;
-            case NodeType::Light:
-                name = "Light";
-                break;
-            case NodeType::Label:
-                name = "Label";
-                break;
-            case NodeType::Button:
-                name = "Button";
-                break;
-            case NodeType::Panel:
-                name = "Panel";
-                break;
-            default:
-                name = "Unknown";
-                break;
-            }
-
-            if (ImGui::MenuItem(name.c_str()))
+            if (ImGui::MenuItem(NodeTypeRegistry::Get(type).name))
                 AddChildNode(rootNode, type);
         }
         ImGui::EndPopup();
@@ -454,75 +559,103 @@ void EngineUI::RenderScenePanel()
 
     ImGui::Separator();
 
-    // Render the scene hierarchy
+    // Render the scene hierarchy, only the rows that are on screen
     if (rootNode)
     {
-        RenderSceneNode(rootNode);
+        if (hierarchyRowsDirty || hierarchyRowsVersion != Node::GetHierarchyVersion())
+        {
+            RebuildHierarchyRows();
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(hierarchyRows.size()));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                RenderSceneNode(hierarchyRows[row].node, hierarchyRows[row].depth);
+            }
+        }
+        clipper.End();
     }
 }
 
-void EngineUI::RenderSceneNode(std::shared_ptr<Node> node)
+void EngineUI::RebuildHierarchyRows()
 {
-    if (!node)
-        return;
+    hierarchyRows.clear();
+    hierarchyRowsVersion = Node::GetHierarchyVersion();
+    hierarchyRowsDirty = false;
+
+    // Depth-first walk that only descends into expanded nodes
+    std::vector<HierarchyRow> stack;
+    stack.push_back({rootNode.get(), 0});
+    while (!stack.empty())
+    {
+        HierarchyRow row = stack.back();
+        stack.pop_back();
+        hierarchyRows.push_back(row);
 
-    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth;
+        if (row.node->expanded)
+        {
+            // Pushed in reverse so children come out in order
+            for (auto it = row.node->children.rbegin(); it != row.node->children.rend(); ++it)
+            {
+                stack.push_back({it->get(), row.depth + 1});
+            }
+        }
+    }
+}
+
+void EngineUI::RenderSceneNode(Node *node, int depth)
+{
+    // Rows are drawn flat, so nesting is shown with indentation instead of TreePush
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
     // Add selection flag if this node is selected
-    if (node->selected)
+    if (IsSelected(node))
         flags |= ImGuiTreeNodeFlags_Selected;
 
     // If node has no children, make it a leaf node
     if (node->children.empty())
         flags |= ImGuiTreeNodeFlags_Leaf;
 
-    // Use node's expanded state
-    if (node->expanded)
-        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+    float indent = depth * ImGui::GetStyle().IndentSpacing;
+    if (indent > 0.0f)
+        ImGui::Indent(indent);
 
     // Push icon font for the icon
     ImGui::PushFont(iconFont);
-    std::string icon = GetNodeIcon(node->type);
-    ImGui::Text("%s", icon.c_str());
+    ImGui::TextUnformatted(NodeTypeRegistry::Get(node->type).icon);
     ImGui::PopFont();
 
     ImGui::SameLine();
 
-    // Display the node with its name
-    bool nodeOpen = ImGui::TreeNodeEx(node->name.c_str(), flags);
+    // Display the node with its name, the node's expanded state drives the tree state
+    ImGui::SetNextItemOpen(node->expanded);
+    bool nodeOpen = ImGui::TreeNodeEx(node, flags, "%s", node->name.c_str());
 
-    // Handle selection
+    // Handle selection, Shift adds to or removes from the current selection
     if (ImGui::IsItemClicked())
     {
-        // Deselect previous node
-        if (selectedNode)
-            selectedNode->selected = false;
-
-        // Select this node
-        node->selected = true;
-        selectedNode = node;
+        SelectNode(node, ImGui::GetIO().KeyShift);
     }
 
     // Context menu for node operations
     if (ImGui::BeginPopupContextItem())
     {
-        RenderNodeContextMenu(node);
+        RenderNodeContextMenu(node->shared_from_this());
         ImGui::EndPopup();
     }
 
-    // Update expanded state
-    node->expanded = nodeOpen;
-
-    // Render children if node is open
-    if (nodeOpen)
+    // Update expanded state, the visible rows change with it
+    if (nodeOpen != node->expanded)
     {
-        for (auto &child : node->children)
-        {
-            RenderSceneNode(child);
-        }
-
-        ImGui::TreePop();
+        node->expanded = nodeOpen;
+        hierarchyRowsDirty = true;
     }
+
+    if (indent > 0.0f)
+        ImGui::Unindent(indent);
 }
 
 void EngineUI::RenderNodeContextMenu(std::shared_ptr<Node> node)
@@ -534,51 +667,36 @@ void EngineUI::RenderNodeContextMenu(std::shared_ptr<Node> node)
 
     if (ImGui::BeginPopup("AddChildNodePopup"))
     {
-        // Get available node types from Node class
-        std::vector<NodeType> nodeTypes = Node::GetAvailableNodeTypes();
+        // Display menu items for each registered node type
+        for (NodeType type : NodeTypeRegistry::GetCreatableTypes())
+        {
+            if (ImGui::MenuItem(NodeTypeRegistry::Get(type).name))
+                AddChildNode(node, type);
+        }
 
-        // Display menu items for each node type
-        for (const auto &type : nodeTypes)
+        // Prefabs are placed as instances that share the prefab's nodes
+        if (!prefabs.empty())
         {
-            // Get name based on type
-            std::string name;
-            switch (type)
+            ImGui::Separator();
+            char label[128];
+            for (const auto &prefab : prefabs)
             {
-            case NodeType::Node2D:
-                name = "Node2D";
-                break;
-            case NodeType::Sprite:
-                name = "Sprite";
-                break;
-            case NodeType::CharacterBody2D:
-                name = "CharacterBody2D";
-                break;
-            case NodeType::Camera:
-                name = "Camera";
-                break;
-            case NodeType::Light:
-                name = "Light";
-                break;
-            case NodeType::Label:
-                name = "Label";
-                break;
-            case NodeType::Button:
-                name = "Button";
-                break;
-            case NodeType::Panel:
-                name = "Panel";
-                break;
-            default:
-                name = "Unknown";
-                break;
+                std::snprintf(label, sizeof(label), "Instance %s", prefab->GetName().c_str());
+                if (ImGui::MenuItem(label))
+                    AddPrefabInstance(node, prefab);
             }
-
-            if (ImGui::MenuItem(name.c_str()))
-                AddChildNode(node, type);
         }
         ImGui::EndPopup();
     }
 
+    if (node != rootNode && ImGui::MenuItem("Create Prefab"))
+    {
+        if (std::shared_ptr<const Prefab> prefab = Prefab::Create(node.get()))
+        {
+            prefabs.push_back(prefab);
+        }
+    }
+
     if (ImGui::MenuItem("Delete Node"))
     {
         // TODO: Implement node deletion
@@ -591,55 +709,23 @@ void EngineUI::RenderNodeContextMenu(std::shared_ptr<Node> node)
 }
 
 // Generate a unique name for a node based on its type
-std::string EngineUI::GenerateUniqueName(NodeType type)
+StringAtom EngineUI::GenerateUniqueName(NodeType type)
 {
     // Increment the counter for this node type
-    nodeCounters[type]++;
-
-    // Base name for each node type
-    std::string baseName;
-    switch (type)
-    {
-    case NodeType::Root:
-        baseName = "Scene";
-        break;
-    case NodeType::Node2D:
-        baseName = "Node2D";
-        break;
-    case NodeType::Sprite:
-        baseName = "Sprite";
-        break;
-    case NodeType::CharacterBody2D:
-        baseName = "CharacterBody2D";
-        break;
-    case NodeType::Camera:
-        baseName = "Camera2D";
-        break;
-    case NodeType::Light:
-        baseName = "Light2D";
-        break;
-    case NodeType::Label:
-        baseName = "Label";
-        break;
-    case NodeType::Button:
-        baseName = "Button";
-        break;
-    case NodeType::Panel:
-        baseName = "Panel";
-        break;
-    default:
-        baseName = "Node";
-        break;
-    }
+    int &counter = nodeCounters[static_cast<size_t>(type)];
+    counter++;
 
     // For the first node of a type, don't add a number
-    if (nodeCounters[type] == 1)
+    const char *baseName = NodeTypeRegistry::Get(type).baseName;
+    if (counter == 1)
     {
-        return baseName;
+        return StringAtom(baseName);
     }
 
-    // For subsequent nodes, add the counter number
-    return baseName + std::to_string(nodeCounters[type]);
+    // For subsequent nodes, add the counter number, formatted on the stack and interned
+    char uniqueName[64];
+    std::snprintf(uniqueName, sizeof(uniqueName), "%s%d", baseName, counter);
+    return StringAtom(uniqueName);
 }
 
 void EngineUI::AddChildNode(std::shared_ptr<Node> parent, NodeType type)
@@ -648,46 +734,28 @@ void EngineUI::AddChildNode(std::shared_ptr<Node> parent, NodeType type)
         return;
 
     // Generate a unique name for the node
-    std::string uniqueName = GenerateUniqueName(type);
+    StringAtom uniqueName = GenerateUniqueName(type);
 
     // Create a new node with the unique name based on type
-    std::shared_ptr<Node> newNode;
-
-    switch (type)
-    {
-    case NodeType::Node2D:
-        newNode = std::make_shared<Node2D>(uniqueName);
-        break;
-    case NodeType::Sprite:
-        newNode = std::make_shared<Sprite>(uniqueName);
-        break;
-    default:
-        newNode = std::make_shared<Node>(uniqueName, type);
-        break;
-    }
+    std::shared_ptr<Node> newNode = NodeTypeRegistry::Create(type, uniqueName, is3DMode);
 
     if (newNode)
     {
         // Add it to the parent's children
-        parent->children.push_back(newNode);
+        parent->AddChild(newNode);
 
         // Expand the parent to show the new child
         parent->expanded = true;
     }
 }
 
-std::shared_ptr<Node> EngineUI::CreateNodeOfType(NodeType type, const std::string &name)
+void EngineUI::AddPrefabInstance(std::shared_ptr<Node> parent, const std::shared_ptr<const Prefab> &prefab)
 {
-    // Create node based on type
-    switch (type)
-    {
-    case NodeType::Node2D:
-        return std::make_shared<Node2D>(name);
-    case NodeType::Sprite:
-        return std::make_shared<Sprite>(name);
-    default:
-        return std::make_shared<Node>(name, type);
-    }
+    if (!parent || !prefab)
+        return;
+
+    parent->AddChild(std::make_shared<PrefabInstance>(prefab->GetName(), prefab));
+    parent->expanded = true;
 }
 
 void EngineUI::RenderEditorPanel()
@@ -799,29 +867,99 @@ void EngineUI::Render2DEditor()
         ImVec2(startPos.x + viewportSize.x, centerY),
         IM_COL32(0, 255, 0, 100), 2.0f);
 
-    // Render nodes in the editor
-    if (rootNode)
+    // Query the spatial index for nodes overlapping the visible area
+    editorViewportPos = startPos;
+    editorViewportSize = viewportSize;
+    idPickGeometry.clipRect = ImVec4(startPos.x, startPos.y, startPos.x + viewportSize.x, startPos.y + viewportSize.y);
+    ImVec2 viewTopLeft = ScreenToWorld2D(startPos.x, startPos.y, viewportSize, startPos);
+    ImVec2 viewBottomRight = ScreenToWorld2D(startPos.x + viewportSize.x, startPos.y + viewportSize.y, viewportSize, startPos);
+    float viewMin[2] = {viewTopLeft.x, viewTopLeft.y};
+    float viewMax[2] = {viewBottomRight.x, viewBottomRight.y};
+    visibleNodes.clear();
+    sceneGrid.Query(viewMin, viewMax, visibleNodes);
+
+    // Lights are binned before drawing, cached subtrees and live nodes are split apart
+    Node *selectedCacheRoot = selectedNode && Node::HasRenderCaches() ? selectedNode->GetRenderCacheRoot() : nullptr;
+    liveNodes.clear();
+    visibleCacheRoots.clear();
+    lightCuller.Begin(viewportSize.x, viewportSize.y);
+    for (Node *node : visibleNodes)
     {
-        for (auto &node : rootNode->children)
+        // Lights overlapping the view are binned into screen tiles
+        if (node->type == NodeType::Light)
         {
-            RenderNodeInEditor(node, false);
+            if (Light2D *light = dynamic_cast<Light2D *>(node))
+            {
+                ImVec2 lightPos = WorldToScreen2D(light->worldTransform.position[0], light->worldTransform.position[1], viewportSize, startPos);
+                float lightScale = std::max(fabsf(light->worldTransform.scale[0]), fabsf(light->worldTransform.scale[1]));
+                TiledLightCuller::Light tileLight;
+                tileLight.position[0] = lightPos.x - startPos.x;
+                tileLight.position[1] = lightPos.y - startPos.y;
+                tileLight.radius = light->GetRadius() * lightScale * camera2D.zoom;
+                tileLight.color[0] = light->GetColor()[0];
+                tileLight.color[1] = light->GetColor()[1];
+                tileLight.color[2] = light->GetColor()[2];
+                tileLight.energy = light->GetEnergy();
+                lightCuller.AddLight(tileLight);
+            }
         }
+
+        // The subtree being edited is drawn live so selection highlights stay current
+        Node *cacheRoot = Node::HasRenderCaches() ? node->GetRenderCacheRoot() : nullptr;
+        if (cacheRoot && cacheRoot != selectedCacheRoot && cacheRoot != rootNode.get())
+        {
+            if (std::find(visibleCacheRoots.begin(), visibleCacheRoots.end(), cacheRoot) == visibleCacheRoots.end())
+            {
+                visibleCacheRoots.push_back(cacheRoot);
+            }
+        }
+        else
+        {
+            liveNodes.push_back(node);
+        }
+    }
+
+    // Cached subtrees are drawn first, each as one block of retained geometry
+    subtreeCache.NextFrame();
+    for (Node *cacheRoot : visibleCacheRoots)
+    {
+        RenderCachedSubtree2D(cacheRoot, viewportSize, startPos);
+    }
+    DrawNodes2D(liveNodes, viewportSize, startPos);
+
+    // Shade the lit tiles on top of the scene
+    lightCuller.Cull();
+    RenderLighting2D(startPos, viewportSize);
+
+    // Outline the area seen by the active scene camera
+    Camera2D *activeCamera = Camera2D::GetActiveCamera();
+    if (activeCamera && activeCamera->IsInTree(rootNode.get()))
+    {
+        float cameraMin[2], cameraMax[2];
+        activeCamera->GetViewBounds(viewportSize.x, viewportSize.y, cameraMin, cameraMax);
+        drawList->AddRect(WorldToScreen2D(cameraMin[0], cameraMin[1], viewportSize, startPos),
+                          WorldToScreen2D(cameraMax[0], cameraMax[1], viewportSize, startPos),
+                          IM_COL32(180, 120, 255, 200), 0.0f, 0, 1.5f);
     }
 
-    // Render gizmos for the selected node
+    // Culling statistics
+    char cullingStats[128];
+    snprintf(cullingStats, sizeof(cullingStats), "Visible: %d / %d  Lights: %d  Cached: %d (%d KB)", static_cast<int>(visibleNodes.size()), static_cast<int>(sceneGrid.GetSize()),
+             static_cast<int>(lightCuller.GetLightCount()), static_cast<int>(subtreeCache.GetEntryCount()), static_cast<int>(subtreeCache.GetMemoryUsage() / 1024));
+    drawList->AddText(ImVec2(startPos.x + 5, startPos.y + viewportSize.y - 20), IM_COL32(200, 200, 200, 160), cullingStats);
+
+    // Render gizmos for the selection
+    bool gizmoActive = false;
     if (selectedNode)
     {
-        RenderGizmos(startPos, viewportSize);
+        gizmoActive = RenderGizmos(startPos, viewportSize);
     }
 
     // Make the viewport area interactive
     ImGui::InvisibleButton("viewport2d", viewportSize);
 
-    // Handle node selection when clicking in the viewport
-    if (ImGui::IsItemClicked() && !ImGui::IsMouseDragging(0) && !ImGui::IsMouseDragging(1) && !ImGui::IsMouseDragging(2))
-    {
-        HandleNodeSelection(ImGui::GetIO().MousePos);
-    }
+    // Click to pick a node, drag on empty space to select everything inside a rectangle
+    HandleViewportSelection(gizmoActive, true, startPos, viewportSize);
 
     // Handle camera controls (zoom and pan)
     if (ImGui::IsItemHovered())
@@ -845,6 +983,181 @@ void EngineUI::Render2DEditor()
     }
 }
 
+// Draw nodes in render queue order, nodes that submit no draws are drawn as markers
+void EngineUI::DrawNodes2D(const std::vector<Node *> &nodes, ImVec2 viewportSize, ImVec2 startPos)
+{
+    float nodeSize = 10.0f * camera2D.zoom;
+    opaqueQueue.Clear();
+    transparentQueue.Clear();
+    prefabNodeDraws.clear();
+    for (Node *node : nodes)
+    {
+        // Prefab instances draw the prefab's nodes in place of their own
+        if (node->type == NodeType::Node2D)
+        {
+            PrefabInstance *instance = dynamic_cast<PrefabInstance *>(node);
+            if (instance && instance->GetPrefab())
+            {
+                SubmitPrefabInstance2D(instance, viewportSize, startPos, nodeSize);
+                continue;
+            }
+        }
+
+        size_t submittedDraws = opaqueQueue.GetSize() + transparentQueue.GetSize();
+        node->SubmitDraw(node->worldTransform, opaqueQueue, transparentQueue);
+        if (opaqueQueue.GetSize() + transparentQueue.GetSize() == submittedDraws)
+        {
+            RenderNodeInEditor(node, WorldToScreen2D(node->worldTransform.position[0], node->worldTransform.position[1], viewportSize, startPos), nodeSize);
+        }
+    }
+
+    opaqueQueue.Sort();
+    transparentQueue.Sort();
+    for (const RenderQueue *queue : {&opaqueQueue, &transparentQueue})
+    {
+        for (const RenderItem &item : queue->GetItems())
+        {
+            if (item.origin == RenderQueue::NoOrigin)
+            {
+                RenderNodeInEditor(item.node, WorldToScreen2D(item.node->worldTransform.position[0], item.node->worldTransform.position[1], viewportSize, startPos), nodeSize);
+                continue;
+            }
+
+            const PrefabNodeDraw &draw = prefabNodeDraws[item.origin];
+            RenderNodeInEditor(item.node, WorldToScreen2D(draw.world.position[0], draw.world.position[1], viewportSize, startPos), nodeSize, draw.owner);
+        }
+    }
+}
+
+// Submit the nodes of a prefab at an instance with its overrides applied, they select and pick as the instance
+void EngineUI::SubmitPrefabInstance2D(PrefabInstance *instance, ImVec2 viewportSize, ImVec2 startPos, float nodeSize)
+{
+    instance->GetNodeTransforms(prefabNodeTransforms);
+    for (uint32_t i = 0; i < prefabNodeTransforms.size(); i++)
+    {
+        // The queues tag the node's draws with its placement, the node itself is shared with other instances
+        const Node::Transform &world = prefabNodeTransforms[i];
+        const uint32_t origin = static_cast<uint32_t>(prefabNodeDraws.size());
+        prefabNodeDraws.push_back({instance, world});
+        opaqueQueue.SetOrigin(origin);
+        transparentQueue.SetOrigin(origin);
+
+        Node *node = instance->GetResolvedNode(i);
+        size_t submittedDraws = opaqueQueue.GetSize() + transparentQueue.GetSize();
+        node->SubmitDraw(world, opaqueQueue, transparentQueue);
+        if (opaqueQueue.GetSize() + transparentQueue.GetSize() == submittedDraws)
+        {
+            RenderNodeInEditor(node, WorldToScreen2D(world.position[0], world.position[1], viewportSize, startPos), nodeSize, instance);
+        }
+    }
+    opaqueQueue.SetOrigin(RenderQueue::NoOrigin);
+    transparentQueue.SetOrigin(RenderQueue::NoOrigin);
+}
+
+// Replay a cached subtree, recording it again if anything it depends on changed
+void EngineUI::RenderCachedSubtree2D(Node *cacheRoot, ImVec2 viewportSize, ImVec2 startPos)
+{
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = WorldToScreen2D(cacheRoot->worldTransform.position[0], cacheRoot->worldTransform.position[1], viewportSize, startPos);
+
+    SubtreeRenderCache::CacheKey key;
+    key.version = cacheRoot->GetRenderCacheVersion();
+    key.zoom = camera2D.zoom;
+    key.rotation = cacheRoot->worldTransform.rotation[2];
+    key.scale[0] = cacheRoot->worldTransform.scale[0];
+    key.scale[1] = cacheRoot->worldTransform.scale[1];
+    const int idVertexStart = drawList->VtxBuffer.Size;
+    const int idIndexStart = drawList->IdxBuffer.Size;
+    const unsigned int idVertexBase = drawList->_VtxCurrentIdx;
+    if (subtreeCache.Draw(drawList, cacheRoot, key, origin))
+    {
+        // A replayed subtree picks as its cache root
+        if (idCaptureActive)
+        {
+            CaptureIdGeometry(drawList, idVertexStart, idIndexStart, idVertexBase, cacheRoot);
+        }
+        return;
+    }
+
+    // Record the whole subtree, not just its visible part, so panning can reuse it
+    cachedSubtreeNodes.clear();
+    std::function<void(Node *)> collect = [&](Node *node)
+    {
+        cachedSubtreeNodes.push_back(node);
+        for (auto &child : node->children)
+        {
+            collect(child.get());
+        }
+    };
+    collect(cacheRoot);
+
+    // ImGui drops text outside the clip rect, so partly visible subtrees can't be moved later
+    float subtreeMin[2] = {INFINITY, INFINITY};
+    float subtreeMax[2] = {-INFINITY, -INFINITY};
+    float boundsMin[2], boundsMax[2];
+    for (Node *node : cachedSubtreeNodes)
+    {
+        node->GetWorldBounds(boundsMin, boundsMax);
+        subtreeMin[0] = std::min(subtreeMin[0], boundsMin[0]);
+        subtreeMin[1] = std::min(subtreeMin[1], boundsMin[1]);
+        subtreeMax[0] = std::max(subtreeMax[0], boundsMax[0]);
+        subtreeMax[1] = std::max(subtreeMax[1], boundsMax[1]);
+    }
+    ImVec2 screenMin = WorldToScreen2D(subtreeMin[0], subtreeMin[1], viewportSize, startPos);
+    ImVec2 screenMax = WorldToScreen2D(subtreeMax[0], subtreeMax[1], viewportSize, startPos);
+    bool movable = screenMin.x >= startPos.x && screenMin.y >= startPos.y &&
+                   screenMax.x <= startPos.x + viewportSize.x && screenMax.y <= startPos.y + viewportSize.y;
+
+    subtreeCache.BeginRecord(drawList);
+    DrawNodes2D(cachedSubtreeNodes, viewportSize, startPos);
+    subtreeCache.EndRecord(drawList, cacheRoot, key, origin, movable);
+}
+
+// Draw the light of each screen tile, evaluating only the lights binned into it
+void EngineUI::RenderLighting2D(ImVec2 startPos, ImVec2 viewportSize)
+{
+    if (lightCuller.GetLightCount() == 0)
+        return;
+
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    const float tileSize = lightCuller.GetTileSize();
+
+    for (int tileY = 0; tileY < lightCuller.GetTileCountY(); tileY++)
+    {
+        for (int tileX = 0; tileX < lightCuller.GetTileCountX(); tileX++)
+        {
+            uint32_t lightCount;
+            lightCuller.GetTileLights(tileX, tileY, lightCount);
+            if (lightCount == 0)
+                continue;
+
+            // Shade the tile corners and let the rectangle interpolate between them
+            float minX = tileX * tileSize;
+            float minY = tileY * tileSize;
+            float maxX = std::min(minX + tileSize, viewportSize.x);
+            float maxY = std::min(minY + tileSize, viewportSize.y);
+            const float cornerX[4] = {minX, maxX, maxX, minX};
+            const float cornerY[4] = {minY, minY, maxY, maxY};
+            ImU32 cornerColors[4];
+            for (int corner = 0; corner < 4; corner++)
+            {
+                float light[3];
+                lightCuller.EvaluateTile(tileX, tileY, cornerX[corner], cornerY[corner], light);
+                float peak = std::max(light[0], std::max(light[1], light[2]));
+                float norm = peak > 1.0f ? 1.0f / peak : 1.0f;
+                cornerColors[corner] = IM_COL32(static_cast<int>(light[0] * norm * 255.0f),
+                                                static_cast<int>(light[1] * norm * 255.0f),
+                                                static_cast<int>(light[2] * norm * 255.0f),
+                                                static_cast<int>(std::min(peak, 1.0f) * 120.0f));
+            }
+
+            drawList->AddRectFilledMultiColor(ImVec2(startPos.x + minX, startPos.y + minY),
+                                              ImVec2(startPos.x + maxX, startPos.y + maxY),
+                                              cornerColors[0], cornerColors[1], cornerColors[2], cornerColors[3]);
+        }
+    }
+}
+
 void EngineUI::Render3DEditor()
 {
     // Editor viewport
@@ -952,22 +1265,42 @@ void EngineUI::Render3DEditor()
         IM_COL32(50, 50, 255, 255), "Z");
 
     // Render nodes in the editor with camera transform applied
-    if (rootNode)
+    editorViewportPos = startPos;
+    editorViewportSize = viewportSize;
+    idPickGeometry.clipRect = ImVec4(startPos.x, startPos.y, startPos.x + viewportSize.x, startPos.y + viewportSize.y);
+
+    // Only the nodes inside the editor camera's view are drawn, culled with the projection WorldToScreen3D applies
+    Frustum editorFrustum;
+    BuildEditorFrustum3D(viewportSize, editorFrustum);
+    visibleBoundsIndices.clear();
+    editorFrustum.CullAABBs(sceneBounds3D, visibleBoundsIndices);
+
+    float nodeSize = 10.0f * camera3D.zoom / 5.0f;
+    for (uint32_t index : visibleBoundsIndices)
     {
-        for (auto &node : rootNode->children)
-        {
-            RenderNodeInEditor(node, true);
-        }
+        Node *node = sceneBoundsNodes[index];
+        ImVec2 screenPos = WorldToScreen3D(node->worldTransform.position[0], node->worldTransform.position[1], viewportSize, startPos);
+        RenderNodeInEditor(node, screenPos, nodeSize);
     }
 
+    // Culling statistics, plus what the active scene camera would see
+    char cullingStats[96];
+    int written = snprintf(cullingStats, sizeof(cullingStats), "Visible: %d / %d", static_cast<int>(visibleBoundsIndices.size()), static_cast<int>(sceneBounds3D.GetSize()));
+    Camera3D *activeCamera = dynamic_cast<Camera3D *>(Camera::GetActiveCamera());
+    if (activeCamera && rootNode && activeCamera->IsInTree(rootNode.get()))
+    {
+        float aspectRatio = viewportSize.y > 0.0f ? viewportSize.x / viewportSize.y : 1.0f;
+        cameraBoundsIndices.clear();
+        activeCamera->GetVisibleNodes(sceneBounds3D, aspectRatio, cameraBoundsIndices);
+        snprintf(cullingStats + written, sizeof(cullingStats) - written, "  In camera frustum: %d", static_cast<int>(cameraBoundsIndices.size()));
+    }
+    drawList->AddText(ImVec2(startPos.x + 5, startPos.y + viewportSize.y - 20), IM_COL32(200, 200, 200, 160), cullingStats);
+
     // Make the viewport area interactive
     ImGui::InvisibleButton("viewport3d", viewportSize);
 
-    // Handle node selection on click
-    if (ImGui::IsItemClicked() && !ImGui::IsMouseDragging(0) && !ImGui::IsMouseDragging(1) && !ImGui::IsMouseDragging(2))
-    {
-        HandleNodeSelection(ImGui::GetIO().MousePos);
-    }
+    // Handle node selection on click, the 3D view has no rectangle selection
+    HandleViewportSelection(false, false, startPos, viewportSize);
 
     // Handle camera controls
     if (ImGui::IsItemHovered())
@@ -1013,13 +1346,20 @@ void EngineUI::RenderInspectorPanel()
     // If no node is selected, show a message
     if (!selectedNode)
     {
+        inspectorRecording.Cancel();
         ImGui::TextWrapped("Select a node to edit its properties");
         return;
     }
 
+    // With several nodes selected the inspector edits the primary one
+    if (selection.GetSize() > 1)
+    {
+        ImGui::TextDisabled("%d nodes selected, editing the last one", static_cast<int>(selection.GetSize()));
+    }
+
     // Show node type with icon
     ImGui::PushFont(iconFont);
-    ImGui::Text("%s", GetNodeIcon(selectedNode->type));
+    ImGui::Text("%s", NodeTypeRegistry::Get(selectedNode->type).icon);
     ImGui::PopFont();
     ImGui::SameLine();
     ImGui::Text("%s (%s)", selectedNode->name.c_str(),
@@ -1027,8 +1367,52 @@ void EngineUI::RenderInspectorPanel()
 
     ImGui::Separator();
 
+    // Snapshot the node only on frames where one of its widgets can start an edit, before the widget
+    // runs: a click or an activation key in the inspector, or a widget that was activated without
+    // changing anything yet, like a field tabbed into. Frames without input do no undo work at all.
+    if (!inspectorRecording.IsActive() && (IsEditingInCurrentWindow() || IsActivatingInCurrentWindow()))
+    {
+        inspectorRecording.Begin("Edit " + std::string(selectedNode->name.GetView()));
+        inspectorRecording.TrackAll(selectedNode.get());
+    }
+
     // Let the node render its own properties
     selectedNode->RenderInspectorProperties();
+
+    // A held slider or a field being typed in keeps adding to the same entry, it's committed once released
+    if (inspectorRecording.IsActive() && !IsEditingInCurrentWindow())
+    {
+        journal.Commit(inspectorRecording);
+    }
+}
+
+bool EngineUI::IsEditingInCurrentWindow() const
+{
+    // The active widget may sit in a child window or a popup opened from this one
+    ImGuiContext &context = *GImGui;
+    if (!context.ActiveId)
+        return false;
+
+    ImGuiWindow *currentWindow = ImGui::GetCurrentWindow();
+    for (ImGuiWindow *window = context.ActiveIdWindow; window; window = window->ParentWindow)
+    {
+        if (window == currentWindow)
+            return true;
+    }
+    return false;
+}
+
+bool EngineUI::IsActivatingInCurrentWindow() const
+{
+    // Clicks and keyboard presses can change a widget's value in the same frame they activate it
+    if (ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows) &&
+        (ImGui::IsMouseClicked(ImGuiMouseButton_Left) || ImGui::IsMouseClicked(ImGuiMouseButton_Right)))
+    {
+        return true;
+    }
+    return ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows) &&
+           (ImGui::IsKeyPressed(ImGuiKey_Space, false) || ImGui::IsKeyPressed(ImGuiKey_Enter, false) ||
+            ImGui::IsKeyPressed(ImGuiKey_KeypadEnter, false));
 }
 
 // Render gizmo control buttons
@@ -1126,81 +1510,151 @@ void EngineUI::RenderGizmoControls()
     ImGui::SetCursorScreenPos(windowPos);
 }
 
-// Render a node in the editor
-void EngineUI::RenderNodeInEditor(std::shared_ptr<Node> node, bool is3D,
-                                  float parentX, float parentY,
-                                  float parentRotation,
-                                  float parentScaleX, float parentScaleY)
+// Keep the spatial index in sync with scene edits, the bus has already refreshed world transforms
+void EngineUI::UpdateSceneIndex(const std::vector<NodeChangeEvent> &events)
 {
-    if (!node)
-        return;
+    // Drop destroyed nodes first, their addresses may have been reused
+    for (const NodeChangeEvent &event : events)
+    {
+        if (event.node)
+            continue;
+
+        sceneGrid.Remove(event.address);
+        pickingTree.Remove(event.address);
+        RemoveSceneBounds3D(event.address);
+        subtreeCache.Remove(event.address);
+    }
 
-    // Skip rendering for certain node types
-    if (node->type == NodeType::Root)
+    float boundsMin[3], boundsMax[3];
+    for (const NodeChangeEvent &event : events)
     {
-        // Recursively render children
-        for (auto &child : node->children)
+        // Moved nodes, and nodes whose bounds changed without moving (label text, light radius)
+        Node *node = event.node;
+        if (!node || !(event.changes & (NodeChangeTransform | NodeChangeVisual)))
+            continue;
+
+        // The root isn't drawn and detached subtrees leave the index
+        if (node == rootNode.get() || !node->IsInTree(rootNode.get()))
         {
-            RenderNodeInEditor(child, is3D, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f);
+            sceneGrid.Remove(node);
+            pickingTree.Remove(node);
+            RemoveSceneBounds3D(node);
+            continue;
         }
+
+        node->GetWorldBounds3D(boundsMin, boundsMax);
+        sceneGrid.Update(node, boundsMin, boundsMax);
+        pickingTree.Update(node, boundsMin, boundsMax);
+        UpdateSceneBounds3D(node, boundsMin, boundsMax);
+    }
+}
+
+void EngineUI::UpdateSceneBounds3D(Node *node, const float boundsMin[3], const float boundsMax[3])
+{
+    auto it = sceneBoundsLookup.find(node);
+    if (it != sceneBoundsLookup.end())
+    {
+        sceneBounds3D.Set(it->second, boundsMin, boundsMax);
         return;
     }
 
-    ImDrawList *drawList = ImGui::GetWindowDrawList();
-    ImVec2 startPos = ImGui::GetCursorScreenPos();
-    ImVec2 viewportSize = ImGui::GetContentRegionAvail();
+    sceneBoundsLookup.emplace(node, static_cast<uint32_t>(sceneBounds3D.Add(boundsMin, boundsMax)));
+    sceneBoundsNodes.push_back(node);
+}
 
-    // Calculate node position in viewport
-    float centerX = startPos.x + viewportSize.x / 2;
-    float centerY = startPos.y + viewportSize.y / 2;
+void EngineUI::RemoveSceneBounds3D(Node *node)
+{
+    auto it = sceneBoundsLookup.find(node);
+    if (it == sceneBoundsLookup.end())
+        return;
 
-    // Apply parent transform to this node's position
-    float worldX = parentX + node->transform.position[0];
-    float worldY = parentY + node->transform.position[1];
+    // Swap the last box into the freed slot and repoint its owner
+    uint32_t index = it->second;
+    sceneBoundsLookup.erase(it);
+    sceneBounds3D.SwapRemove(index);
+    Node *moved = sceneBoundsNodes.back();
+    sceneBoundsNodes[index] = moved;
+    sceneBoundsNodes.pop_back();
+    if (moved != node)
+    {
+        sceneBoundsLookup[moved] = index;
+    }
+}
 
-    // Calculate viewport center
-    float viewportCenterX = startPos.x + viewportSize.x / 2;
-    float viewportCenterY = startPos.y + viewportSize.y / 2;
+// Convert between 2D world space and viewport screen space
+ImVec2 EngineUI::WorldToScreen2D(float worldX, float worldY, ImVec2 viewportSize, ImVec2 viewportPos)
+{
+    return ImVec2(viewportPos.x + viewportSize.x / 2 + (worldX - camera2D.posX) * camera2D.zoom,
+                  viewportPos.y + viewportSize.y / 2 + (worldY - camera2D.posY) * camera2D.zoom);
+}
 
-    // Apply camera transform based on editor mode
-    if (is3D)
-    {
-        // For 3D mode
-        float zoom = camera3D.zoom / 5.0f;
+ImVec2 EngineUI::ScreenToWorld2D(float screenX, float screenY, ImVec2 viewportSize, ImVec2 viewportPos)
+{
+    return ImVec2(camera2D.posX + (screenX - viewportPos.x - viewportSize.x / 2) / camera2D.zoom,
+                  camera2D.posY + (screenY - viewportPos.y - viewportSize.y / 2) / camera2D.zoom);
+}
 
-        // Apply camera rotation (simplified for 2D representation of 3D)
-        float cosY = cosf(camera3D.rotY);
-        float sinY = sinf(camera3D.rotY);
-        float rotatedX = worldX * cosY - worldY * sinY;
-        float rotatedY = worldX * sinY + worldY * cosY;
+// Project a world position with the simplified 3D editor camera
+ImVec2 EngineUI::ScreenToWorld3D(float screenX, float screenY, ImVec2 viewportSize, ImVec2 viewportPos)
+{
+    // Inverse of WorldToScreen3D
+    float zoom = camera3D.zoom / 5.0f;
+    float rotatedX = (screenX - viewportPos.x - viewportSize.x / 2) / zoom + camera3D.posX;
+    float rotatedY = (screenY - viewportPos.y - viewportSize.y / 2) / zoom + camera3D.posZ;
 
-        // Convert world position to screen position
-        worldX = viewportCenterX + (rotatedX - camera3D.posX) * zoom;
-        worldY = viewportCenterY + (rotatedY - camera3D.posZ) * zoom;
-    }
-    else
-    {
-        // For 2D mode
-        // Convert world position to screen position
-        worldX = viewportCenterX + (worldX - camera2D.posX) * camera2D.zoom;
-        worldY = viewportCenterY + (worldY - camera2D.posY) * camera2D.zoom;
-    }
+    float cosY = cosf(camera3D.rotY);
+    float sinY = sinf(camera3D.rotY);
+    return ImVec2(rotatedX * cosY + rotatedY * sinY, -rotatedX * sinY + rotatedY * cosY);
+}
 
-    // Set node position directly in screen space
-    float nodeX = worldX;
-    float nodeY = worldY;
+ImVec2 EngineUI::WorldToScreen3D(float worldX, float worldY, ImVec2 viewportSize, ImVec2 viewportPos)
+{
+    float zoom = camera3D.zoom / 5.0f;
 
-    // Node position is already in screen space after camera transform
+    // Apply camera rotation (simplified for 2D representation of 3D)
+    float cosY = cosf(camera3D.rotY);
+    float sinY = sinf(camera3D.rotY);
+    float rotatedX = worldX * cosY - worldY * sinY;
+    float rotatedY = worldX * sinY + worldY * cosY;
 
-    // Node visual representation based on type
-    ImU32 nodeColor = node->selected ? IM_COL32(255, 255, 0, 255) : IM_COL32(200, 200, 200, 255);
-    float nodeSize = 10.0f;
+    return ImVec2(viewportPos.x + viewportSize.x / 2 + (rotatedX - camera3D.posX) * zoom,
+                  viewportPos.y + viewportSize.y / 2 + (rotatedY - camera3D.posZ) * zoom);
+}
 
-    // Adjust node size based on camera zoom
-    if (is3D)
-        nodeSize *= camera3D.zoom / 5.0f;
-    else
-        nodeSize *= camera2D.zoom;
+// View volume of the 3D editor camera, the region WorldToScreen3D maps into the viewport
+void EngineUI::BuildEditorFrustum3D(ImVec2 viewportSize, Frustum &outFrustum)
+{
+    // WorldToScreen3D rotates world XY by rotY, so the view axes are the rows of that rotation
+    float zoom = camera3D.zoom / 5.0f;
+    float cosY = cosf(camera3D.rotY);
+    float sinY = sinf(camera3D.rotY);
+    const float axisX[2] = {cosY, -sinY};
+    const float axisY[2] = {sinY, cosY};
+    const float center[2] = {camera3D.posX, camera3D.posZ};
+    outFrustum.SetFromOrthographic(axisX, axisY, center, viewportSize.x * 0.5f / zoom, viewportSize.y * 0.5f / zoom);
+}
+
+// Render a node in the editor at its screen position
+void EngineUI::RenderNodeInEditor(Node *node, ImVec2 screenPos, float nodeSize, Node *owner)
+{
+    if (!node)
+        return;
+
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    float nodeX = screenPos.x;
+    float nodeY = screenPos.y;
+
+    // Remember where this node's geometry starts so it can be tagged for the ID pass
+    const int idVertexStart = drawList->VtxBuffer.Size;
+    const int idIndexStart = drawList->IdxBuffer.Size;
+    const unsigned int idVertexBase = drawList->_VtxCurrentIdx;
+
+    // Nodes drawn on behalf of an owner, like a prefab's shared nodes, select and pick as the owner
+    Node *pickNode = owner ? owner : node;
+
+    // Node visual representation based on type
+    const bool nodeSelected = IsSelected(pickNode);
+    ImU32 nodeColor = nodeSelected ? IM_COL32(255, 255, 0, 255) : IM_COL32(200, 200, 200, 255);
 
     switch (node->type)
     {
@@ -1225,6 +1679,16 @@ void EngineUI::RenderNodeInEditor(std::shared_ptr<Node> node, bool is3D,
         drawList->AddCircle(ImVec2(nodeX, nodeY), nodeSize, nodeColor, 0, 2.0f);
         break;
 
+    case NodeType::Label:
+        // Preview the text at its laid-out size, scaled like the marker
+        if (Label *label = dynamic_cast<Label *>(node))
+        {
+            const float *textColor = label->GetColor();
+            ImU32 labelColor = nodeSelected ? nodeColor : ImGui::ColorConvertFloat4ToU32(ImVec4(textColor[0], textColor[1], textColor[2], textColor[3]));
+            drawList->AddText(nullptr, label->GetFontSize() * nodeSize / 10.0f, screenPos, labelColor, label->GetText().c_str());
+        }
+        break;
+
     case NodeType::Camera:
         // Draw a camera icon
         drawList->AddTriangleFilled(
@@ -1240,152 +1704,294 @@ void EngineUI::RenderNodeInEditor(std::shared_ptr<Node> node, bool is3D,
         break;
     }
 
-    // Draw node name if selected
-    if (node->selected)
+    // Draw node name if selected, an owner is named once at its first node
+    if (nodeSelected && (!owner || node->parent == nullptr))
     {
         drawList->AddText(ImVec2(nodeX + nodeSize + 5, nodeY - 10),
-                          IM_COL32(255, 255, 255, 255), node->name.c_str());
+                          IM_COL32(255, 255, 255, 255), pickNode->name.c_str());
+    }
+
+    if (idCaptureActive)
+    {
+        CaptureIdGeometry(drawList, idVertexStart, idIndexStart, idVertexBase, pickNode);
     }
+}
 
-    // Calculate combined transform to pass to children
-    float combinedX = worldX;
-    float combinedY = worldY;
-    float combinedRotation = parentRotation + node->transform.rotation[2];
-    float combinedScaleX = parentScaleX * node->transform.scale[0];
-    float combinedScaleY = parentScaleY * node->transform.scale[1];
+// Copy the geometry a node just drew into the ID pass, with its instance id as the vertex colour
+void EngineUI::CaptureIdGeometry(ImDrawList *drawList, int vertexStart, int indexStart, unsigned int vertexBase, const Node *node)
+{
+    // A new draw command restarted the vertex indices, the range can't be remapped
+    if (drawList->_VtxCurrentIdx < vertexBase)
+        return;
 
-    // Recursively render children with combined transform
-    for (auto &child : node->children)
+    const uint32_t base = static_cast<uint32_t>(idPickGeometry.vertices.size());
+    const ImU32 id = node->GetInstanceId();
+    for (int i = vertexStart; i < drawList->VtxBuffer.Size; i++)
     {
-        RenderNodeInEditor(child, is3D, combinedX, combinedY, combinedRotation, combinedScaleX, combinedScaleY);
+        ImDrawVert vertex = drawList->VtxBuffer.Data[i];
+        vertex.col = id;
+        idPickGeometry.vertices.push_back(vertex);
+    }
+    for (int i = indexStart; i < drawList->IdxBuffer.Size; i++)
+    {
+        idPickGeometry.indices.push_back(base + drawList->IdxBuffer.Data[i] - vertexBase);
     }
 }
 
-// Handle node selection in the editor
-void EngineUI::HandleNodeSelection(ImVec2 mousePos)
+bool EngineUI::IsGpuPickingEnabled() const
 {
-    // Deselect current node
-    if (selectedNode)
+    return gpuPicking;
+}
+
+const IdPickGeometry &EngineUI::GetIdPickGeometry() const
+{
+    return gpuPickGeometry;
+}
+
+bool EngineUI::TakeGpuPickRequest(ImVec2 &outScreenPos)
+{
+    if (!gpuPickRequested)
+        return false;
+
+    gpuPickRequested = false;
+    outScreenPos = gpuPickPos;
+    return true;
+}
+
+void EngineUI::ApplyGpuPickResult(uint32_t instanceId)
+{
+    // The node may have been destroyed while the readback was in flight
+    Node *pickedNode = Node::FindByInstanceId(instanceId);
+    if (pickedNode && !pickedNode->IsInTree(rootNode.get()))
+    {
+        pickedNode = nullptr;
+    }
+
+    if (pickedNode)
     {
-        selectedNode->selected = false;
+        SelectNode(pickedNode, gpuPickAdditive);
     }
+    else if (!gpuPickAdditive)
+    {
+        ClearSelection();
+    }
+}
+
+// Handle node selection in the editor
+void EngineUI::HandleNodeSelection(ImVec2 mousePos, bool additive)
+{
+    // With GPU picking the selection arrives once the ID pass has been read back
+    if (gpuPicking)
+    {
+        gpuPickRequested = true;
+        gpuPickPos = mousePos;
+        gpuPickAdditive = additive;
 
-    // Find node under mouse cursor
-    std::shared_ptr<Node> clickedNode = nullptr;
-    Node::Transform emptyTransform; // Default transform with no offset
-    FindNodeAtPosition(rootNode, mousePos, clickedNode, emptyTransform);
+        // The ids are rendered from what was on screen at the click, even if the pass only runs frames later
+        gpuPickGeometry = idPickGeometry;
+        return;
+    }
 
-    // Select the node
+    // Find node under mouse cursor, clicking empty space clears the selection
+    Node *clickedNode = PickNodeAt(mousePos);
     if (clickedNode)
     {
-        clickedNode->selected = true;
-        selectedNode = clickedNode;
+        SelectNode(clickedNode, additive);
+    }
+    else if (!additive)
+    {
+        ClearSelection();
     }
 }
 
-// Helper function to find a node at a specific position
-void EngineUI::FindNodeAtPosition(std::shared_ptr<Node> node, ImVec2 pos, std::shared_ptr<Node> &result,
-                                  Node::Transform parentTransform)
+// Turn a press on a viewport into a click or rectangle selection once the mouse is released
+void EngineUI::HandleViewportSelection(bool gizmoActive, bool allowMarquee, ImVec2 startPos, ImVec2 viewportSize)
 {
-    if (!node)
-        return;
+    ImGuiIO &io = ImGui::GetIO();
 
-    // Skip root node
-    if (node->type != NodeType::Root)
+    // Presses on a gizmo handle drive the gizmo instead
+    if (ImGui::IsItemClicked(ImGuiMouseButton_Left) && !gizmoActive)
     {
-        ImVec2 startPos = ImGui::GetCursorScreenPos();
-        ImVec2 viewportSize = ImGui::GetContentRegionAvail();
+        selectionPressPending = true;
+        selectionPressPos = io.MousePos;
+    }
 
-        // Calculate node position in viewport
-        float centerX = startPos.x + viewportSize.x / 2;
-        float centerY = startPos.y + viewportSize.y / 2;
+    if (!selectionPressPending)
+        return;
 
-        // Apply parent position to this node's position
-        float worldX = parentTransform.position[0] + node->transform.position[0];
-        float worldY = parentTransform.position[1] + node->transform.position[1];
+    float dragX = io.MousePos.x - selectionPressPos.x;
+    float dragY = io.MousePos.y - selectionPressPos.y;
+    bool dragged = dragX * dragX + dragY * dragY > io.MouseDragThreshold * io.MouseDragThreshold;
+    ImVec2 rectMin(std::min(selectionPressPos.x, io.MousePos.x), std::min(selectionPressPos.y, io.MousePos.y));
+    ImVec2 rectMax(std::max(selectionPressPos.x, io.MousePos.x), std::max(selectionPressPos.y, io.MousePos.y));
 
-        // Apply camera transform based on editor mode
-        bool is3D = is3DMode; // Use the current editor mode
-        if (is3D)
+    if (ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    {
+        // Show the rectangle while dragging
+        if (allowMarquee && dragged)
         {
-            // Only apply 3D camera transform in 3D mode
-            float zoom = camera3D.zoom / 5.0f;
+            ImDrawList *drawList = ImGui::GetWindowDrawList();
+            drawList->AddRectFilled(rectMin, rectMax, IM_COL32(90, 150, 255, 40));
+            drawList->AddRect(rectMin, rectMax, IM_COL32(90, 150, 255, 200), 0.0f, 0, 1.0f);
+        }
+        return;
+    }
 
-            // Apply camera rotation (simplified for 2D representation of 3D)
-            float cosY = cosf(camera3D.rotY);
-            float sinY = sinf(camera3D.rotY);
-            float rotatedX = worldX * cosY - worldY * sinY;
-            float rotatedY = worldX * sinY + worldY * cosY;
+    selectionPressPending = false;
+    if (!dragged)
+    {
+        HandleNodeSelection(io.MousePos, io.KeyShift);
+    }
+    else if (allowMarquee)
+    {
+        SelectNodesInRect(rectMin, rectMax, io.KeyShift, viewportSize, startPos);
+    }
+}
 
-            // Apply camera position and zoom
-            worldX = (rotatedX - camera3D.posX) * zoom;
-            worldY = (rotatedY - camera3D.posZ) * zoom;
-        }
-        else
+// Select every node overlapping a screen rectangle of the 2D viewport
+void EngineUI::SelectNodesInRect(ImVec2 screenMin, ImVec2 screenMax, bool additive, ImVec2 viewportSize, ImVec2 startPos)
+{
+    ImVec2 worldMin = ScreenToWorld2D(screenMin.x, screenMin.y, viewportSize, startPos);
+    ImVec2 worldMax = ScreenToWorld2D(screenMax.x, screenMax.y, viewportSize, startPos);
+    float boundsMin[2] = {worldMin.x, worldMin.y};
+    float boundsMax[2] = {worldMax.x, worldMax.y};
+
+    // The spatial index gives the candidates, so the cost follows the rectangle and not the scene
+    marqueeNodes.clear();
+    sceneGrid.Query(boundsMin, boundsMax, marqueeNodes);
+
+    if (!additive)
+    {
+        ClearSelection();
+    }
+    for (Node *node : marqueeNodes)
+    {
+        if (node == rootNode.get())
+            continue;
+
+        if (selection.Add(node->GetInstanceId()) && Node::HasRenderCaches())
         {
-            // Only apply 2D camera transform in 2D mode
-            // For 2D, we simply offset by camera position and scale by zoom
-            worldX = (worldX - camera2D.posX) * camera2D.zoom;
-            worldY = (worldY - camera2D.posY) * camera2D.zoom;
+            node->InvalidateRenderCache();
         }
+    }
+    SyncPrimarySelection();
+}
 
-        // Node position is already in screen space after camera transform
-        float nodeX = worldX;
-        float nodeY = worldY;
+bool EngineUI::IsSelected(const Node *node) const
+{
+    return selection.Contains(node->GetInstanceId());
+}
 
-        // Increase the hit area for better selection
-        float nodeSize = 15.0f; // Increased from 10.0f for better selection
+// Select a node, or toggle it in or out of the selection when additive
+void EngineUI::SelectNode(Node *node, bool additive)
+{
+    if (additive)
+    {
+        selection.Toggle(node->GetInstanceId());
+    }
+    else
+    {
+        ClearSelection();
+        selection.Add(node->GetInstanceId());
+    }
 
-        // Adjust hit area based on node type
-        switch (node->type)
+    // Cached subtrees holding the node are redrawn with the new highlight
+    if (Node::HasRenderCaches())
+    {
+        node->InvalidateRenderCache();
+    }
+    SyncPrimarySelection();
+}
+
+void EngineUI::ClearSelection()
+{
+    if (Node::HasRenderCaches())
+    {
+        for (uint32_t id : selection.GetIds())
         {
-        case NodeType::Sprite:
-            nodeSize = 20.0f; // Larger hit area for sprites
-            break;
-        case NodeType::CharacterBody2D:
-            nodeSize = 20.0f; // Larger hit area for character bodies
-            break;
-        default:
-            break;
+            if (Node *node = Node::FindByInstanceId(id))
+            {
+                node->InvalidateRenderCache();
+            }
         }
+    }
+    selection.Clear();
+    selectedNode = nullptr;
+}
 
-        // Apply scale to the hit area
-        float worldScaleX = parentTransform.scale[0] * node->transform.scale[0];
-        nodeSize *= worldScaleX; // Use X scale for simplicity
+// Point the inspector and gizmo anchor at the primary selection
+void EngineUI::SyncPrimarySelection()
+{
+    Node *primary = Node::FindByInstanceId(selection.GetPrimary());
+    selectedNode = primary ? primary->shared_from_this() : nullptr;
+}
 
-        // Also apply camera zoom to hit area
-        if (is3D)
-            nodeSize *= camera3D.zoom / 5.0f;
-        else
-            nodeSize *= camera2D.zoom;
+// Collect the selected nodes without a selected ancestor, moving these moves the whole selection once
+const std::vector<Node *> &EngineUI::GetSelectionRoots()
+{
+    if (selectionRootsVersion == selection.GetVersion() && selectionRootsHierarchyVersion == Node::GetHierarchyVersion())
+        return selectionRoots;
 
-        // Check if mouse is over this node
-        if (pos.x >= nodeX - nodeSize && pos.x <= nodeX + nodeSize &&
-            pos.y >= nodeY - nodeSize && pos.y <= nodeY + nodeSize)
+    selectionRoots.clear();
+    for (uint32_t id : selection.GetIds())
+    {
+        Node *node = Node::FindByInstanceId(id);
+        if (!node || !node->IsInTree(rootNode.get()))
+            continue;
+
+        bool ancestorSelected = false;
+        for (Node *ancestor = node->parent; ancestor && !ancestorSelected; ancestor = ancestor->parent)
         {
-            result = node;
-            return;
+            ancestorSelected = IsSelected(ancestor);
         }
+        if (!ancestorSelected)
+        {
+            selectionRoots.push_back(node);
+        }
+    }
 
-        // Create combined transform to pass to children
-        Node::Transform combinedTransform;
-        combinedTransform.position[0] = worldX;
-        combinedTransform.position[1] = worldY;
-        combinedTransform.rotation[2] = parentTransform.rotation[2] + node->transform.rotation[2];
-        combinedTransform.scale[0] = worldScaleX;
-        combinedTransform.scale[1] = parentTransform.scale[1] * node->transform.scale[1];
+    selectionRootsVersion = selection.GetVersion();
+    selectionRootsHierarchyVersion = Node::GetHierarchyVersion();
+    return selectionRoots;
+}
 
-        // Pass the combined transform to children
-        parentTransform = combinedTransform;
+// Find the node under a point of the editor viewport using the picking tree
+Node *EngineUI::PickNodeAt(ImVec2 screenPos)
+{
+    if (is3DMode)
+    {
+        // The 3D view looks down the Z axis, so cast from just above the scene and take the first hit.
+        // Starting close keeps hit distances small enough for float precision to tell them apart.
+        float sceneMin[3], sceneMax[3];
+        if (!pickingTree.GetBounds(sceneMin, sceneMax))
+            return nullptr;
+
+        const float startMargin = 1.0f;
+        ImVec2 world = ScreenToWorld3D(screenPos.x, screenPos.y, editorViewportSize, editorViewportPos);
+        const float origin[3] = {world.x, world.y, sceneMax[2] + startMargin};
+        const float direction[3] = {0.0f, 0.0f, -1.0f};
+        return pickingTree.RayCast(origin, direction, sceneMax[2] - sceneMin[2] + startMargin);
     }
 
-    // Check children in reverse order (to select top-most node first)
-    for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+    ImVec2 world = ScreenToWorld2D(screenPos.x, screenPos.y, editorViewportSize, editorViewportPos);
+    std::vector<Node *> candidates;
+    pickingTree.QueryPoint(world.x, world.y, candidates);
+
+    // Prefer the smallest node under the cursor, it's usually the one drawn on top
+    Node *result = nullptr;
+    float resultArea = 0.0f;
+    float boundsMin[2], boundsMax[2];
+    for (Node *node : candidates)
     {
-        FindNodeAtPosition(*it, pos, result, parentTransform);
-        if (result)
-            return;
+        node->GetWorldBounds(boundsMin, boundsMax);
+        float area = (boundsMax[0] - boundsMin[0]) * (boundsMax[1] - boundsMin[1]);
+        if (!result || area < resultArea)
+        {
+            result = node;
+            resultArea = area;
+        }
     }
+    return result;
 }
 
 // Helper function to calculate a node's world position
@@ -1398,64 +2004,42 @@ void EngineUI::CalculateNodeWorldTransform(std::shared_ptr<Node> node, float &ou
         return;
     }
 
-    // Start with the node's local position
-    outWorldX = node->transform.position[0];
-    outWorldY = node->transform.position[1];
-
-    // Traverse up the parent hierarchy to calculate world position
-    std::shared_ptr<Node> parent = nullptr;
-
-    // Find the parent by searching through all nodes
-    if (node != rootNode) // Skip if this is the root node
-    {
-        std::function<bool(std::shared_ptr<Node>, std::shared_ptr<Node>, std::shared_ptr<Node> &)> findParent;
-        findParent = [&findParent](std::shared_ptr<Node> current, std::shared_ptr<Node> target, std::shared_ptr<Node> &result) -> bool
-        {
-            for (auto &child : current->children)
-            {
-                if (child == target)
-                {
-                    result = current;
-                    return true;
-                }
-                if (findParent(child, target, result))
-                    return true;
-            }
-            return false;
-        };
-
-        findParent(rootNode, node, parent);
-    }
-
-    // If we found a parent, add its world position
-    if (parent)
-    {
-        float parentX, parentY;
-        CalculateNodeWorldTransform(parent, parentX, parentY);
-        outWorldX += parentX;
-        outWorldY += parentY;
-    }
+    // World transforms are cached on the node and refreshed by NodeChangeBus::Flush
+    outWorldX = node->worldTransform.position[0];
+    outWorldY = node->worldTransform.position[1];
 }
 
-// Render gizmos for the selected node
-void EngineUI::RenderGizmos(ImVec2 startPos, ImVec2 viewportSize)
+// Render gizmos for the selection, returns true while the mouse is over or dragging a handle
+bool EngineUI::RenderGizmos(ImVec2 startPos, ImVec2 viewportSize)
 {
     if (!selectedNode)
-        return;
+        return false;
 
     ImDrawList *drawList = ImGui::GetWindowDrawList();
 
-    // Calculate node position in viewport
-    float centerX = startPos.x + viewportSize.x / 2;
-    float centerY = startPos.y + viewportSize.y / 2;
-
-    // Calculate world position of the selected node
-    float worldX, worldY;
-    CalculateNodeWorldTransform(selectedNode, worldX, worldY);
+    // The gizmo sits on what a drag moves, the topmost selected nodes. A lone root may be an ancestor
+    // of the primary selection, and a group pivots around the centre of its roots.
+    const std::vector<Node *> &roots = GetSelectionRoots();
+    float worldX = 0.0f, worldY = 0.0f;
+    if (!roots.empty())
+    {
+        for (Node *node : roots)
+        {
+            worldX += node->worldTransform.position[0];
+            worldY += node->worldTransform.position[1];
+        }
+        worldX /= roots.size();
+        worldY /= roots.size();
+    }
+    else
+    {
+        CalculateNodeWorldTransform(selectedNode, worldX, worldY);
+    }
 
-    // Apply world transform to viewport coordinates
-    float nodeX = centerX + worldX;
-    float nodeY = centerY + worldY;
+    // Apply the editor camera to get viewport coordinates
+    ImVec2 nodeScreenPos = WorldToScreen2D(worldX, worldY, viewportSize, startPos);
+    float nodeX = nodeScreenPos.x;
+    float nodeY = nodeScreenPos.y;
 
     // Gizmo colors
     ImU32 xAxisColor = IM_COL32(255, 0, 0, 255);
@@ -1615,20 +2199,42 @@ void EngineUI::RenderGizmos(ImVec2 startPos, ImVec2 viewportSize)
         {
             ImVec2 mouseDelta = ImVec2(mousePos.x - lastMousePos.x, mousePos.y - lastMousePos.y);
 
-            switch (currentGizmoOp)
+            // The whole selection moves in one pass, children follow their selected parent
+            std::vector<Node *> singleNode;
+            if (roots.empty())
             {
-            case GizmoOperation::Translate:
-                if (activeAxis == 0) // X-axis
+                singleNode.push_back(selectedNode.get());
+            }
+            const std::vector<Node *> &targets = roots.empty() ? singleNode : roots;
+
+            // The whole drag becomes one undo entry
+            if (!gizmoRecording.IsActive())
+            {
+                gizmoRecording.Begin("Transform");
+                for (Node *node : targets)
                 {
-                    // Apply translation only to the selected node
-                    selectedNode->transform.position[0] += mouseDelta.x;
+                    gizmoRecording.Track(node, NodeProperty::Position);
+                    gizmoRecording.Track(node, NodeProperty::Rotation);
+                    gizmoRecording.Track(node, NodeProperty::Scale);
                 }
-                else if (activeAxis == 1) // Y-axis
+            }
+
+            switch (currentGizmoOp)
+            {
+            case GizmoOperation::Translate:
+            {
+                // The drag moves along a world axis, each node takes it in its parent's space
+                float worldDeltaX = activeAxis == 0 ? mouseDelta.x / camera2D.zoom : 0.0f;
+                float worldDeltaY = activeAxis == 1 ? mouseDelta.y / camera2D.zoom : 0.0f;
+                for (Node *node : targets)
                 {
-                    // Apply translation only to the selected node
-                    selectedNode->transform.position[1] += mouseDelta.y; // Y should move up when dragging up
+                    float localX, localY;
+                    node->WorldOffsetToLocal(worldDeltaX, worldDeltaY, localX, localY);
+                    node->transform.position[0] += localX;
+                    node->transform.position[1] += localY;
                 }
                 break;
+            }
 
             case GizmoOperation::Rotate:
                 if (activeAxis == 2) // Rotation
@@ -1636,31 +2242,60 @@ void EngineUI::RenderGizmos(ImVec2 startPos, ImVec2 viewportSize)
                     // Calculate angle change based on mouse movement relative to node center
                     float prevAngle = atan2(lastMousePos.y - nodeY, lastMousePos.x - nodeX);
                     float newAngle = atan2(mousePos.y - nodeY, mousePos.x - nodeX);
-                    float angleDelta = (newAngle - prevAngle) * 180.0f / 3.14159f; // Convert to degrees
-
-                    // Apply rotation only to the selected node
-                    selectedNode->transform.rotation[2] += angleDelta;
+                    float angleRadians = newAngle - prevAngle;
+                    float angleDelta = angleRadians * 180.0f / 3.14159f; // Convert to degrees
+                    float cosAngle = cosf(angleRadians);
+                    float sinAngle = sinf(angleRadians);
+
+                    // Each node turns in place and its position swings around the pivot
+                    for (Node *node : targets)
+                    {
+                        if (targets.size() > 1)
+                        {
+                            float offsetX = node->worldTransform.position[0] - worldX;
+                            float offsetY = node->worldTransform.position[1] - worldY;
+                            float localX, localY;
+                            node->WorldOffsetToLocal(offsetX * cosAngle - offsetY * sinAngle - offsetX,
+                                                     offsetX * sinAngle + offsetY * cosAngle - offsetY, localX, localY);
+                            node->transform.position[0] += localX;
+                            node->transform.position[1] += localY;
+                        }
+                        node->transform.rotation[2] += angleDelta;
+                    }
                 }
                 break;
 
             case GizmoOperation::Scale:
-                if (activeAxis == 0) // X-axis scale
+                if (activeAxis == 0 || activeAxis == 1)
                 {
-                    float scaleFactor = 1.0f + mouseDelta.x / 100.0f;
-
-                    // Apply X scale only to the selected node
-                    selectedNode->transform.scale[0] *= scaleFactor;
-                }
-                else if (activeAxis == 1) // Y-axis scale
-                {
-                    float scaleFactor = 1.0f - mouseDelta.y / 100.0f; // Subtract because Y is inverted
-
-                    // Apply Y scale only to the selected node
-                    selectedNode->transform.scale[1] *= scaleFactor;
+                    // Subtract on Y because screen Y is inverted
+                    float scaleFactor = activeAxis == 0 ? 1.0f + mouseDelta.x / 100.0f : 1.0f - mouseDelta.y / 100.0f;
+
+                    // Each node scales in place and its distance to the pivot scales with it
+                    for (Node *node : targets)
+                    {
+                        if (targets.size() > 1)
+                        {
+                            float offset = node->worldTransform.position[activeAxis] - (activeAxis == 0 ? worldX : worldY);
+                            float worldDelta[2] = {0.0f, 0.0f};
+                            worldDelta[activeAxis] = offset * (scaleFactor - 1.0f);
+                            float localX, localY;
+                            node->WorldOffsetToLocal(worldDelta[0], worldDelta[1], localX, localY);
+                            node->transform.position[0] += localX;
+                            node->transform.position[1] += localY;
+                        }
+                        node->transform.scale[activeAxis] *= scaleFactor;
+                    }
                 }
                 break;
             }
 
+            // Refresh the moved nodes' world transforms and spatial index entries
+            for (Node *node : targets)
+            {
+                node->MarkTransformDirty();
+            }
+
             lastMousePos = mousePos;
         }
         else
@@ -1668,6 +2303,9 @@ void EngineUI::RenderGizmos(ImVec2 startPos, ImVec2 viewportSize)
             // Mouse released, stop dragging
             isDraggingGizmo = false;
             activeAxis = -1;
+            journal.Commit(gizmoRecording);
         }
     }
+
+    return isMouseOverGizmo || isDraggingGizmo;
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "FontAtlasCache.h"
+#include "MappedFile.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    const char AtlasMagic[8] = {'E', 'G', 'E', 'F', 'O', 'N', 'T', 'S'};
+    constexpr uint32_t AtlasVersion = 1;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t glyphSize; // sizeof(ImFontGlyph), glyphs are stored as ImGui lays them out
+        uint64_t key;
+        uint32_t width;
+        uint32_t height;
+        uint32_t fontCount;
+        uint32_t rectCount;
+    };
+
+    // One per ImFont, in atlas order. The glyphs of all fonts follow the records, then the alpha texture.
+    struct FontRecord
+    {
+        float fontSize;
+        float ascent;
+        float descent;
+        int32_t metricsTotalSurface;
+        uint32_t glyphCount;
+    };
+
+    // Where the atlas' own rectangles (mouse cursors, baked lines) were packed
+    struct RectRecord
+    {
+        uint16_t x, y;
+        uint16_t width, height;
+    };
+
+    uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+    {
+        // FNV-1a
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    uint64_t HashValue(uint64_t hash, const T &value)
+    {
+        return HashBytes(hash, &value, sizeof(T));
+    }
+}
+
+bool FontAtlasCache::Build(ImFontAtlas *atlas, const std::string &cachePath)
+{
+    const uint64_t key = ComputeKey(atlas);
+    if (Load(atlas, cachePath, key))
+        return true;
+
+    if (!atlas->Build())
+        return false;
+
+    // A stale or missing cache only costs this launch the rasterization
+    Save(atlas, cachePath, key);
+    return true;
+}
+
+uint64_t FontAtlasCache::ComputeKey(ImFontAtlas *atlas)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash = HashValue(hash, AtlasVersion);
+    hash = HashValue(hash, IMGUI_VERSION_NUM);
+    hash = HashValue(hash, atlas->Flags);
+    hash = HashValue(hash, atlas->TexDesiredWidth);
+    hash = HashValue(hash, atlas->TexGlyphPadding);
+
+    for (const ImFontConfig &config : atlas->ConfigData)
+    {
+        hash = HashValue(hash, config.FontDataSize);
+        hash = HashBytes(hash, config.FontData, static_cast<size_t>(config.FontDataSize));
+        hash = HashValue(hash, config.FontNo);
+        hash = HashValue(hash, config.SizePixels);
+        hash = HashValue(hash, config.OversampleH);
+        hash = HashValue(hash, config.OversampleV);
+        hash = HashValue(hash, config.PixelSnapH);
+        hash = HashValue(hash, config.GlyphExtraSpacing);
+        hash = HashValue(hash, config.GlyphOffset);
+        hash = HashValue(hash, config.GlyphMinAdvanceX);
+        hash = HashValue(hash, config.GlyphMaxAdvanceX);
+        hash = HashValue(hash, config.MergeMode);
+        hash = HashValue(hash, config.FontBuilderFlags);
+        hash = HashValue(hash, config.RasterizerMultiply);
+        hash = HashValue(hash, config.RasterizerDensity);
+        hash = HashValue(hash, config.EllipsisChar);
+
+        // Ranges are pairs ending in 0, fonts added without any get the default ones
+        const ImWchar *ranges = config.GlyphRanges ? config.GlyphRanges : atlas->GetGlyphRangesDefault();
+        for (; ranges[0]; ranges += 2)
+        {
+            hash = HashValue(hash, ranges[0]);
+            hash = HashValue(hash, ranges[1]);
+        }
+        hash = HashValue(hash, ImWchar(0));
+    }
+    return hash;
+}
+
+bool FontAtlasCache::Load(ImFontAtlas *atlas, const std::string &cachePath, uint64_t key)
+{
+    // No cache yet is the normal first launch, not worth a message
+    std::error_code error;
+    if (!std::filesystem::exists(cachePath, error))
+        return false;
+
+    MappedFile mapping;
+    if (!mapping.Open(cachePath))
+        return false;
+
+    const uint8_t *data = mapping.GetData();
+    const size_t size = mapping.GetSize();
+    Header header;
+    if (size < sizeof(Header))
+        return false;
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, AtlasMagic, sizeof(header.magic)) != 0 || header.version != AtlasVersion ||
+        header.glyphSize != sizeof(ImFontGlyph) || header.key != key ||
+        header.fontCount != static_cast<uint32_t>(atlas->Fonts.Size) || header.width == 0 || header.height == 0)
+    {
+        return false;
+    }
+
+    // Check every section fits before touching the atlas
+    const size_t fontsOffset = sizeof(Header);
+    const size_t rectsOffset = fontsOffset + header.fontCount * sizeof(FontRecord);
+    const size_t glyphsOffset = rectsOffset + header.rectCount * sizeof(RectRecord);
+    if (glyphsOffset > size)
+        return false;
+
+    std::vector<FontRecord> fonts(header.fontCount);
+    std::memcpy(fonts.data(), data + fontsOffset, fonts.size() * sizeof(FontRecord));
+    size_t glyphCount = 0;
+    for (const FontRecord &font : fonts)
+    {
+        glyphCount += font.glyphCount;
+    }
+
+    const size_t pixelsOffset = glyphsOffset + glyphCount * sizeof(ImFontGlyph);
+    const size_t pixelCount = static_cast<size_t>(header.width) * header.height;
+    if (pixelsOffset > size || size - pixelsOffset != pixelCount)
+        return false;
+
+    // Registers the atlas' own rectangles the same way a build does, only their packing is restored
+    ImFontAtlasBuildInit(atlas);
+    if (atlas->CustomRects.Size != static_cast<int>(header.rectCount))
+        return false;
+    for (int i = 0; i < atlas->CustomRects.Size; ++i)
+    {
+        RectRecord rect;
+        std::memcpy(&rect, data + rectsOffset + i * sizeof(RectRecord), sizeof(RectRecord));
+        ImFontAtlasCustomRect &target = atlas->CustomRects[i];
+        if (target.Font != nullptr || target.Width != rect.width || target.Height != rect.height)
+            return false;
+        target.X = rect.x;
+        target.Y = rect.y;
+    }
+
+    atlas->ClearTexData();
+    atlas->TexWidth = static_cast<int>(header.width);
+    atlas->TexHeight = static_cast<int>(header.height);
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexPixelsAlpha8 = static_cast<unsigned char *>(IM_ALLOC(pixelCount));
+    std::memcpy(atlas->TexPixelsAlpha8, data + pixelsOffset, pixelCount);
+
+    const uint8_t *glyphs = data + glyphsOffset;
+    for (uint32_t i = 0; i < header.fontCount; ++i)
+    {
+        ImFont *font = atlas->Fonts[static_cast<int>(i)];
+        font->ClearOutputData();
+        font->FontSize = fonts[i].fontSize;
+        font->ContainerAtlas = atlas;
+        font->Ascent = fonts[i].ascent;
+        font->Descent = fonts[i].descent;
+        font->MetricsTotalSurface = fonts[i].metricsTotalSurface;
+        font->Glyphs.resize(static_cast<int>(fonts[i].glyphCount));
+        std::memcpy(font->Glyphs.Data, glyphs, fonts[i].glyphCount * sizeof(ImFontGlyph));
+        glyphs += fonts[i].glyphCount * sizeof(ImFontGlyph);
+    }
+
+    // Draws the cursors and lines into their rectangles, sets their UVs and builds the glyph lookup tables
+    ImFontAtlasBuildFinish(atlas);
+    return true;
+}
+
+bool FontAtlasCache::Save(const ImFontAtlas *atlas, const std::string &cachePath, uint64_t key)
+{
+    // Colored glyphs need the RGBA texture and custom glyphs point into fonts, neither is cached
+    if (atlas->TexPixelsAlpha8 == nullptr || atlas->TexPixelsUseColors)
+        return false;
+    for (const ImFontAtlasCustomRect &rect : atlas->CustomRects)
+    {
+        if (rect.Font != nullptr)
+            return false;
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, AtlasMagic, sizeof(header.magic));
+    header.version = AtlasVersion;
+    header.glyphSize = sizeof(ImFontGlyph);
+    header.key = key;
+    header.width = static_cast<uint32_t>(atlas->TexWidth);
+    header.height = static_cast<uint32_t>(atlas->TexHeight);
+    header.fontCount = static_cast<uint32_t>(atlas->Fonts.Size);
+    header.rectCount = static_cast<uint32_t>(atlas->CustomRects.Size);
+
+    std::vector<FontRecord> fonts;
+    fonts.reserve(header.fontCount);
+    for (const ImFont *font : atlas->Fonts)
+    {
+        fonts.push_back({font->FontSize, font->Ascent, font->Descent, font->MetricsTotalSurface,
+                         static_cast<uint32_t>(font->Glyphs.Size)});
+    }
+
+    std::vector<RectRecord> rects;
+    rects.reserve(header.rectCount);
+    for (const ImFontAtlasCustomRect &rect : atlas->CustomRects)
+    {
+        rects.push_back({rect.X, rect.Y, rect.Width, rect.Height});
+    }
+
+    std::error_code error;
+    const std::filesystem::path directory = std::filesystem::path(cachePath).parent_path();
+    if (!directory.empty())
+        std::filesystem::create_directories(directory, error);
+
+    // Written beside the cache and moved over it, so another editor reading the old file through
+    // a mapping never sees it truncated, and a crash mid-write never leaves a partial cache
+    const std::string tempPath = cachePath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "Failed to open font atlas cache for writing: " << tempPath << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char *>(fonts.data()), static_cast<std::streamsize>(fonts.size() * sizeof(FontRecord)));
+    file.write(reinterpret_cast<const char *>(rects.data()), static_cast<std::streamsize>(rects.size() * sizeof(RectRecord)));
+    for (const ImFont *font : atlas->Fonts)
+    {
+        file.write(reinterpret_cast<const char *>(font->Glyphs.Data), static_cast<std::streamsize>(font->Glyphs.Size * sizeof(ImFontGlyph)));
+    }
+    file.write(reinterpret_cast<const char *>(atlas->TexPixelsAlpha8), static_cast<std::streamsize>(atlas->TexWidth) * atlas->TexHeight);
+    file.close();
+
+    if (!file)
+    {
+        std::cerr << "Failed to write font atlas cache: " << tempPath << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, cachePath, error);
+    if (error)
+    {
+        std::cerr << "Failed to replace font atlas cache: " << cachePath << " (" << error.message() << ")" << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
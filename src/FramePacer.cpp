@@ -0,0 +1,214 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    // Spin margin limits, in seconds
+    constexpr double MinSpinMargin = 0.00025;
+    constexpr double MaxSpinMargin = 0.004;
+
+    // Late by more than this fraction of the interval counts as a missed deadline
+    constexpr double MissTolerance = 0.1;
+
+    // Misses in a row before halving the rate, and frames with headroom before doubling it back.
+    // The interval is a power of two multiple of the target frame time, at most a quarter of the rate.
+    constexpr int MissesBeforeSlowdown = 3;
+    constexpr int HeadroomFramesBeforeSpeedup = 60;
+    constexpr int MaxIntervalMultiplier = 4;
+
+    double ToSeconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double>(duration).count();
+    }
+}
+
+FramePacer::FramePacer()
+{
+}
+
+FramePacer::~FramePacer()
+{
+    // Nothing to clean up
+}
+
+bool FramePacer::ParseMode(const std::string &name, Mode &outMode)
+{
+    if (name == "editor")
+        outMode = Mode::Editor;
+    else if (name == "game")
+        outMode = Mode::Game;
+    else if (name == "benchmark")
+        outMode = Mode::Benchmark;
+    else
+        return false;
+    return true;
+}
+
+const char *FramePacer::GetModeName(Mode mode)
+{
+    switch (mode)
+    {
+    case Mode::Editor:
+        return "editor";
+    case Mode::Game:
+        return "game";
+    case Mode::Benchmark:
+        return "benchmark";
+    }
+    return "unknown";
+}
+
+void FramePacer::SetMode(Mode mode)
+{
+    this->mode = mode;
+    intervalMultiplier = 1;
+    Reset();
+}
+
+FramePacer::Mode FramePacer::GetMode() const
+{
+    return mode;
+}
+
+void FramePacer::SetTargetFrameRate(double framesPerSecond)
+{
+    if (framesPerSecond > 0.0)
+    {
+        targetFrameTime = 1.0 / framesPerSecond;
+        intervalMultiplier = 1;
+        Reset();
+    }
+}
+
+double FramePacer::GetTargetFrameRate() const
+{
+    return 1.0 / targetFrameTime;
+}
+
+double FramePacer::GetEffectiveFrameRate() const
+{
+    return 1.0 / (targetFrameTime * intervalMultiplier);
+}
+
+void FramePacer::Reset()
+{
+    hasLastFrame = false;
+    missStreak = 0;
+    headroomStreak = 0;
+}
+
+const FramePacer::Stats &FramePacer::GetStats() const
+{
+    return stats;
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    Clock::time_point now = Clock::now();
+    if (!hasLastFrame)
+    {
+        // First frame after a reset starts right away
+        hasLastFrame = true;
+        deadline = now;
+        lastFrameStart = now;
+        return;
+    }
+
+    if (mode != Mode::Benchmark)
+    {
+        const double interval = targetFrameTime * intervalMultiplier;
+        const double workTime = ToSeconds(now - lastFrameStart);
+        deadline += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+
+        // A late frame restarts the schedule from now instead of rushing the next ones to catch up
+        bool missed = ToSeconds(now - deadline) > interval * MissTolerance;
+        if (missed)
+        {
+            deadline = now;
+            stats.missedDeadlines++;
+        }
+        else
+        {
+            SleepUntil(deadline);
+        }
+
+        if (mode == Mode::Game)
+        {
+            // Headroom means the work would have fit the next faster interval, half this one, with some margin
+            bool headroom = intervalMultiplier > 1 && workTime < targetFrameTime * (intervalMultiplier / 2) * 0.8;
+            if (missed)
+            {
+                missStreak++;
+                headroomStreak = 0;
+            }
+            else
+            {
+                missStreak = 0;
+                headroomStreak = headroom ? headroomStreak + 1 : 0;
+            }
+            AdaptInterval(missed);
+        }
+    }
+
+    Clock::time_point frameStart = Clock::now();
+    RecordFrame(ToSeconds(frameStart - lastFrameStart));
+    lastFrameStart = frameStart;
+}
+
+void FramePacer::SleepUntil(Clock::time_point deadline)
+{
+    // Sleep in the coarse part, the OS may wake us late by up to the spin margin
+    while (true)
+    {
+        Clock::time_point now = Clock::now();
+        double remaining = ToSeconds(deadline - now);
+        if (remaining <= spinMargin)
+            break;
+
+        double requested = remaining - spinMargin;
+        std::this_thread::sleep_for(std::chrono::duration<double>(requested));
+        double oversleep = std::max(ToSeconds(Clock::now() - now) - requested, 0.0);
+
+        // Track the typical wake-up latency and keep a safety factor on top of it
+        averageOversleep = averageOversleep * 0.9 + oversleep * 0.1;
+        spinMargin = std::clamp(averageOversleep * 2.0, MinSpinMargin, MaxSpinMargin);
+    }
+
+    // Spin for the last fraction of a millisecond
+    while (Clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::AdaptInterval(bool missed)
+{
+    if (missed && missStreak >= MissesBeforeSlowdown && intervalMultiplier < MaxIntervalMultiplier)
+    {
+        // Steady half rate looks smoother than a rate that keeps dropping frames
+        intervalMultiplier *= 2;
+        missStreak = 0;
+    }
+    else if (headroomStreak >= HeadroomFramesBeforeSpeedup)
+    {
+        intervalMultiplier /= 2;
+        headroomStreak = 0;
+    }
+}
+
+void FramePacer::RecordFrame(double frameTime)
+{
+    // Totals over the whole run, so the report covers the same frames as its frame count
+    const double milliseconds = frameTime * 1000.0;
+    frameTimeSum += milliseconds;
+    frameTimeSquareSum += milliseconds * milliseconds;
+    stats.frameCount++;
+
+    const double average = frameTimeSum / stats.frameCount;
+    const double variance = std::max(frameTimeSquareSum / stats.frameCount - average * average, 0.0);
+    stats.averageFrameTime = average;
+    stats.frameTimeDeviation = std::sqrt(variance);
+    stats.worstFrameTime = std::max(stats.worstFrameTime, milliseconds);
+}
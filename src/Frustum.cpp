@@ -0,0 +1,293 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_USE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_USE_SSE 1
+#endif
+
+namespace
+{
+    const float DegreesToRadians = 3.14159265f / 180.0f;
+
+    void Normalize(float v[3])
+    {
+        float length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length > 0.0f)
+        {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+    }
+
+    float Dot(const float a[3], const float b[3])
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // Rotate a vector by Euler angles in Z (roll), X (pitch), Y (yaw) order
+    void Rotate(const float rotationDegrees[3], const float in[3], float out[3])
+    {
+        float pitch = rotationDegrees[0] * DegreesToRadians;
+        float yaw = rotationDegrees[1] * DegreesToRadians;
+        float roll = rotationDegrees[2] * DegreesToRadians;
+
+        // Roll around Z
+        float x = in[0] * cosf(roll) - in[1] * sinf(roll);
+        float y = in[0] * sinf(roll) + in[1] * cosf(roll);
+        float z = in[2];
+
+        // Pitch around X
+        float y2 = y * cosf(pitch) - z * sinf(pitch);
+        float z2 = y * sinf(pitch) + z * cosf(pitch);
+
+        // Yaw around Y
+        out[0] = x * cosf(yaw) + z2 * sinf(yaw);
+        out[1] = y2;
+        out[2] = -x * sinf(yaw) + z2 * cosf(yaw);
+    }
+
+    // Plane through a point with the given (unnormalized) inward normal
+    Plane MakePlane(float nx, float ny, float nz, const float point[3])
+    {
+        Plane plane;
+        plane.normal[0] = nx;
+        plane.normal[1] = ny;
+        plane.normal[2] = nz;
+        Normalize(plane.normal);
+        plane.distance = -Dot(plane.normal, point);
+        return plane;
+    }
+}
+
+void BoundsArray3D::Clear()
+{
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+}
+
+void BoundsArray3D::Reserve(size_t count)
+{
+    centerX.reserve(count);
+    centerY.reserve(count);
+    centerZ.reserve(count);
+    extentX.reserve(count);
+    extentY.reserve(count);
+    extentZ.reserve(count);
+}
+
+size_t BoundsArray3D::Add(const float boundsMin[3], const float boundsMax[3])
+{
+    size_t index = centerX.size();
+    centerX.push_back(0.0f);
+    centerY.push_back(0.0f);
+    centerZ.push_back(0.0f);
+    extentX.push_back(0.0f);
+    extentY.push_back(0.0f);
+    extentZ.push_back(0.0f);
+    Set(index, boundsMin, boundsMax);
+    return index;
+}
+
+void BoundsArray3D::Set(size_t index, const float boundsMin[3], const float boundsMax[3])
+{
+    centerX[index] = (boundsMin[0] + boundsMax[0]) * 0.5f;
+    centerY[index] = (boundsMin[1] + boundsMax[1]) * 0.5f;
+    centerZ[index] = (boundsMin[2] + boundsMax[2]) * 0.5f;
+    extentX[index] = (boundsMax[0] - boundsMin[0]) * 0.5f;
+    extentY[index] = (boundsMax[1] - boundsMin[1]) * 0.5f;
+    extentZ[index] = (boundsMax[2] - boundsMin[2]) * 0.5f;
+}
+
+void BoundsArray3D::SwapRemove(size_t index)
+{
+    for (std::vector<float> *column : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ})
+    {
+        (*column)[index] = column->back();
+        column->pop_back();
+    }
+}
+
+size_t BoundsArray3D::GetSize() const
+{
+    return centerX.size();
+}
+
+Frustum::Frustum()
+{
+}
+
+void Frustum::SetFromPerspective(const float position[3], const float rotationDegrees[3],
+                                 float fovDegrees, float aspectRatio, float nearClip, float farClip)
+{
+    // Camera basis in world space
+    const float localForward[3] = {0.0f, 0.0f, -1.0f};
+    const float localRight[3] = {1.0f, 0.0f, 0.0f};
+    const float localUp[3] = {0.0f, 1.0f, 0.0f};
+    float forward[3], right[3], up[3];
+    Rotate(rotationDegrees, localForward, forward);
+    Rotate(rotationDegrees, localRight, right);
+    Rotate(rotationDegrees, localUp, up);
+
+    float tanHalfV = tanf(fovDegrees * 0.5f * DegreesToRadians);
+    float tanHalfH = tanHalfV * aspectRatio;
+
+    // Near and far planes face each other along the view direction
+    float nearPoint[3], farPoint[3];
+    for (int i = 0; i < 3; i++)
+    {
+        nearPoint[i] = position[i] + forward[i] * nearClip;
+        farPoint[i] = position[i] + forward[i] * farClip;
+    }
+    planes[Near] = MakePlane(forward[0], forward[1], forward[2], nearPoint);
+    planes[Far] = MakePlane(-forward[0], -forward[1], -forward[2], farPoint);
+
+    // Side planes pass through the camera position.
+    // A point is inside the right plane when dot(p, right) <= tanHalfH * dot(p, forward).
+    planes[Left] = MakePlane(forward[0] * tanHalfH + right[0], forward[1] * tanHalfH + right[1], forward[2] * tanHalfH + right[2], position);
+    planes[Right] = MakePlane(forward[0] * tanHalfH - right[0], forward[1] * tanHalfH - right[1], forward[2] * tanHalfH - right[2], position);
+    planes[Top] = MakePlane(forward[0] * tanHalfV - up[0], forward[1] * tanHalfV - up[1], forward[2] * tanHalfV - up[2], position);
+    planes[Bottom] = MakePlane(forward[0] * tanHalfV + up[0], forward[1] * tanHalfV + up[1], forward[2] * tanHalfV + up[2], position);
+}
+
+void Frustum::SetFromOrthographic(const float axisX[2], const float axisY[2], const float center[2], float halfWidth, float halfHeight)
+{
+    // Every depth is in view, the depth planes sit far enough out to accept any box
+    const float unbounded = 1e30f;
+    planes[Near] = {{0.0f, 0.0f, 1.0f}, unbounded};
+    planes[Far] = {{0.0f, 0.0f, -1.0f}, unbounded};
+
+    // A point is inside when its coordinate along each view axis is within the half extent of the centre's
+    planes[Left] = {{axisX[0], axisX[1], 0.0f}, halfWidth - center[0]};
+    planes[Right] = {{-axisX[0], -axisX[1], 0.0f}, halfWidth + center[0]};
+    planes[Bottom] = {{axisY[0], axisY[1], 0.0f}, halfHeight - center[1]};
+    planes[Top] = {{-axisY[0], -axisY[1], 0.0f}, halfHeight + center[1]};
+}
+
+bool Frustum::TestAABB(const float center[3], const float extent[3]) const
+{
+    for (const Plane &plane : planes)
+    {
+        // Distance of the centre against the box's projected radius
+        float distance = Dot(plane.normal, center) + plane.distance;
+        float radius = fabsf(plane.normal[0]) * extent[0] +
+                       fabsf(plane.normal[1]) * extent[1] +
+                       fabsf(plane.normal[2]) * extent[2];
+        if (distance + radius < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Frustum::CullAABBsScalar(const BoundsArray3D &bounds, size_t begin, std::vector<uint32_t> &outVisible) const
+{
+    for (size_t i = begin; i < bounds.GetSize(); i++)
+    {
+        const float center[3] = {bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i]};
+        const float extent[3] = {bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i]};
+        if (TestAABB(center, extent))
+        {
+            outVisible.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void Frustum::CullAABBs(const BoundsArray3D &bounds, std::vector<uint32_t> &outVisible) const
+{
+    const size_t count = bounds.GetSize();
+    size_t i = 0;
+
+#if defined(FRUSTUM_USE_AVX)
+    // Eight boxes per iteration
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(&bounds.centerX[i]);
+        __m256 cy = _mm256_loadu_ps(&bounds.centerY[i]);
+        __m256 cz = _mm256_loadu_ps(&bounds.centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&bounds.extentX[i]);
+        __m256 ey = _mm256_loadu_ps(&bounds.extentY[i]);
+        __m256 ez = _mm256_loadu_ps(&bounds.extentZ[i]);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const Plane &plane : planes)
+        {
+            __m256 nx = _mm256_set1_ps(plane.normal[0]);
+            __m256 ny = _mm256_set1_ps(plane.normal[1]);
+            __m256 nz = _mm256_set1_ps(plane.normal[2]);
+
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                                            _mm256_add_ps(_mm256_mul_ps(nz, cz), _mm256_set1_ps(plane.distance)));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(signMask, nx), ex),
+                                                        _mm256_mul_ps(_mm256_andnot_ps(signMask, ny), ey)),
+                                          _mm256_mul_ps(_mm256_andnot_ps(signMask, nz), ez));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        // Compact the visible lanes into the output list
+        int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; mask; lane++, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                outVisible.push_back(static_cast<uint32_t>(i + lane));
+            }
+        }
+    }
+#elif defined(FRUSTUM_USE_SSE)
+    // Four boxes per iteration
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(&bounds.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&bounds.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&bounds.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&bounds.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&bounds.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&bounds.extentZ[i]);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const Plane &plane : planes)
+        {
+            __m128 nx = _mm_set1_ps(plane.normal[0]);
+            __m128 ny = _mm_set1_ps(plane.normal[1]);
+            __m128 nz = _mm_set1_ps(plane.normal[2]);
+
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                                         _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.distance)));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, nx), ex),
+                                                  _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey)),
+                                       _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        }
+
+        // Compact the visible lanes into the output list
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            if (mask & (1 << lane))
+            {
+                outVisible.push_back(static_cast<uint32_t>(i + lane));
+            }
+        }
+    }
+#endif
+
+    // Remaining boxes (or all of them without SIMD)
+    CullAABBsScalar(bounds, i, outVisible);
+}
+
+const Plane &Frustum::GetPlane(int index) const
+{
+    return planes[index];
+}
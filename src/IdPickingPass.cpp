@@ -0,0 +1,532 @@
+#include "IdPickingPass.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+// SPIR-V generated from shaders/ by the build
+#include "id_pass.vert.h"
+#include "id_pass.frag.h"
+
+IdPickingPass::IdPickingPass()
+{
+}
+
+IdPickingPass::~IdPickingPass()
+{
+    // Resources are released by Cleanup while the device is still alive
+}
+
+void IdPickingPass::Init(VkPhysicalDevice physicalDevice, VkDevice device, VkExtent2D extent)
+{
+    this->physicalDevice = physicalDevice;
+    this->device = device;
+    this->extent = extent;
+
+    CreateRenderPass();
+    CreatePipeline();
+    CreateTarget();
+
+    // The readback block is tiny and persistently mapped
+    CreateBuffer(ReadbackSize * ReadbackSize * sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                 readbackBuffer, readbackMemory, &readbackMapped);
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (vkCreateFence(device, &fenceInfo, nullptr, &readbackFence) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass fence!");
+    }
+}
+
+void IdPickingPass::Resize(VkExtent2D extent)
+{
+    // Called after the device is idle, so a readback in flight has finished
+    this->extent = extent;
+    DestroyTarget();
+    CreateTarget();
+}
+
+void IdPickingPass::Cleanup()
+{
+    if (device == VK_NULL_HANDLE)
+        return;
+
+    DestroyTarget();
+    DestroyBuffer(vertexBuffer, vertexMemory);
+    DestroyBuffer(indexBuffer, indexMemory);
+    DestroyBuffer(readbackBuffer, readbackMemory);
+    vertexCapacity = indexCapacity = 0;
+    vkDestroyFence(device, readbackFence, nullptr);
+    vkDestroyPipeline(device, pipeline, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    vkDestroyRenderPass(device, renderPass, nullptr);
+    device = VK_NULL_HANDLE;
+}
+
+void IdPickingPass::CreateRenderPass()
+{
+    VkAttachmentDescription idAttachment{};
+    idAttachment.format = VK_FORMAT_R32_UINT;
+    idAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    idAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    idAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    idAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    idAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkAttachmentReference idRef{};
+    idRef.attachment = 0;
+    idRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &idRef;
+
+    // Wait for the previous readback's copy before clearing, and make the writes visible to this one
+    VkSubpassDependency dependencies[2]{};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    VkRenderPassCreateInfo rpInfo{};
+    rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    rpInfo.attachmentCount = 1;
+    rpInfo.pAttachments = &idAttachment;
+    rpInfo.subpassCount = 1;
+    rpInfo.pSubpasses = &subpass;
+    rpInfo.dependencyCount = 2;
+    rpInfo.pDependencies = dependencies;
+
+    if (vkCreateRenderPass(device, &rpInfo, nullptr, &renderPass) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass render pass!");
+    }
+}
+
+VkShaderModule IdPickingPass::CreateShaderModule(const uint32_t *code, size_t codeSize)
+{
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = codeSize;
+    moduleInfo.pCode = code;
+
+    VkShaderModule module;
+    if (vkCreateShaderModule(device, &moduleInfo, nullptr, &module) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass shader module!");
+    }
+    return module;
+}
+
+void IdPickingPass::CreatePipeline()
+{
+    VkShaderModule vertexModule = CreateShaderModule(id_pass_vert, sizeof(id_pass_vert));
+    VkShaderModule fragmentModule = CreateShaderModule(id_pass_frag, sizeof(id_pass_frag));
+
+    VkPipelineShaderStageCreateInfo stages[2]{};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName = "main";
+
+    // ImGui's vertex layout, the texture coordinates aren't needed
+    VkVertexInputBindingDescription binding{};
+    binding.binding = 0;
+    binding.stride = sizeof(ImDrawVert);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    VkVertexInputAttributeDescription attributes[2]{};
+    attributes[0].location = 0;
+    attributes[0].binding = 0;
+    attributes[0].format = VK_FORMAT_R32G32_SFLOAT;
+    attributes[0].offset = offsetof(ImDrawVert, pos);
+    attributes[1].location = 1;
+    attributes[1].binding = 0;
+    attributes[1].format = VK_FORMAT_R8G8B8A8_UNORM;
+    attributes[1].offset = offsetof(ImDrawVert, col);
+
+    VkPipelineVertexInputStateCreateInfo vertexInput{};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = 1;
+    vertexInput.pVertexBindingDescriptions = &binding;
+    vertexInput.vertexAttributeDescriptionCount = 2;
+    vertexInput.pVertexAttributeDescriptions = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.cullMode = VK_CULL_MODE_NONE;
+    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterizer.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // Integer targets can't blend, later primitives simply overwrite earlier ones
+    VkPipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+
+    VkPipelineColorBlendStateCreateInfo blendState{};
+    blendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    blendState.attachmentCount = 1;
+    blendState.pAttachments = &blendAttachment;
+
+    VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    // Scale and translation from ImGui screen space to clip space
+    VkPushConstantRange pushRange{};
+    pushRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(float) * 4;
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushRange;
+    if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass pipeline layout!");
+    }
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisample;
+    pipelineInfo.pColorBlendState = &blendState;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = pipelineLayout;
+    pipelineInfo.renderPass = renderPass;
+    pipelineInfo.subpass = 0;
+
+    VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+    vkDestroyShaderModule(device, vertexModule, nullptr);
+    vkDestroyShaderModule(device, fragmentModule, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass pipeline!");
+    }
+}
+
+void IdPickingPass::CreateTarget()
+{
+    if (extent.width == 0 || extent.height == 0)
+        return;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = VK_FORMAT_R32_UINT;
+    imageInfo.extent = {extent.width, extent.height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vkCreateImage(device, &imageInfo, nullptr, &image) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass image!");
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, image, &requirements);
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate id pass image memory!");
+    }
+    vkBindImageMemory(device, image, imageMemory, 0);
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = VK_FORMAT_R32_UINT;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(device, &viewInfo, nullptr, &imageView) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass image view!");
+    }
+
+    VkFramebufferCreateInfo fbInfo{};
+    fbInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fbInfo.renderPass = renderPass;
+    fbInfo.attachmentCount = 1;
+    fbInfo.pAttachments = &imageView;
+    fbInfo.width = extent.width;
+    fbInfo.height = extent.height;
+    fbInfo.layers = 1;
+    if (vkCreateFramebuffer(device, &fbInfo, nullptr, &framebuffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass framebuffer!");
+    }
+}
+
+void IdPickingPass::DestroyTarget()
+{
+    if (framebuffer != VK_NULL_HANDLE)
+        vkDestroyFramebuffer(device, framebuffer, nullptr);
+    if (imageView != VK_NULL_HANDLE)
+        vkDestroyImageView(device, imageView, nullptr);
+    if (image != VK_NULL_HANDLE)
+        vkDestroyImage(device, image, nullptr);
+    if (imageMemory != VK_NULL_HANDLE)
+        vkFreeMemory(device, imageMemory, nullptr);
+    framebuffer = VK_NULL_HANDLE;
+    imageView = VK_NULL_HANDLE;
+    image = VK_NULL_HANDLE;
+    imageMemory = VK_NULL_HANDLE;
+}
+
+uint32_t IdPickingPass::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return i;
+        }
+    }
+    throw std::runtime_error("failed to find a suitable memory type for the id pass!");
+}
+
+void IdPickingPass::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &outBuffer, VkDeviceMemory &outMemory, void **outMapped)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &outBuffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create id pass buffer!");
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, outBuffer, &requirements);
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &outMemory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate id pass buffer memory!");
+    }
+    vkBindBufferMemory(device, outBuffer, outMemory, 0);
+    vkMapMemory(device, outMemory, 0, size, 0, outMapped);
+}
+
+void IdPickingPass::DestroyBuffer(VkBuffer &buffer, VkDeviceMemory &memory)
+{
+    if (buffer != VK_NULL_HANDLE)
+        vkDestroyBuffer(device, buffer, nullptr);
+    if (memory != VK_NULL_HANDLE)
+        vkFreeMemory(device, memory, nullptr);
+    buffer = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+}
+
+void IdPickingPass::EnsureGeometryCapacity(size_t vertexBytes, size_t indexBytes)
+{
+    // Grow by doubling, the previous buffers are unused since no pass is in flight
+    if (vertexBytes > vertexCapacity)
+    {
+        DestroyBuffer(vertexBuffer, vertexMemory);
+        vertexCapacity = std::max<VkDeviceSize>(vertexBytes, vertexCapacity * 2);
+        CreateBuffer(vertexCapacity, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertexBuffer, vertexMemory, &vertexMapped);
+    }
+    if (indexBytes > indexCapacity)
+    {
+        DestroyBuffer(indexBuffer, indexMemory);
+        indexCapacity = std::max<VkDeviceSize>(indexBytes, indexCapacity * 2);
+        CreateBuffer(indexCapacity, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indexBuffer, indexMemory, &indexMapped);
+    }
+}
+
+void IdPickingPass::RequestPick(int x, int y)
+{
+    pickPending = true;
+    pickX = x;
+    pickY = y;
+}
+
+bool IdPickingPass::HasPendingPick() const
+{
+    return pickPending || readbackInFlight;
+}
+
+void IdPickingPass::Record(VkCommandBuffer commandBuffer, const IdPickGeometry &geometry, ImVec2 displayPos, ImVec2 displaySize, ImVec2 framebufferScale)
+{
+    // One readback at a time, a newer request waits for the current one to land
+    if (!pickPending || readbackInFlight || framebuffer == VK_NULL_HANDLE)
+        return;
+    pickPending = false;
+
+    // Clamp the block around the cursor to the image
+    readbackWidth = ReadbackSize;
+    readbackHeight = ReadbackSize;
+    readbackX = std::clamp(pickX - ReadbackSize / 2, 0, std::max(static_cast<int>(extent.width) - ReadbackSize, 0));
+    readbackY = std::clamp(pickY - ReadbackSize / 2, 0, std::max(static_cast<int>(extent.height) - ReadbackSize, 0));
+    readbackWidth = std::min(readbackWidth, static_cast<int>(extent.width));
+    readbackHeight = std::min(readbackHeight, static_cast<int>(extent.height));
+    readbackCenterX = std::clamp(pickX - readbackX, 0, readbackWidth - 1);
+    readbackCenterY = std::clamp(pickY - readbackY, 0, readbackHeight - 1);
+
+    bool hasGeometry = !geometry.indices.empty();
+    if (hasGeometry)
+    {
+        size_t vertexBytes = geometry.vertices.size() * sizeof(ImDrawVert);
+        size_t indexBytes = geometry.indices.size() * sizeof(uint32_t);
+        EnsureGeometryCapacity(vertexBytes, indexBytes);
+        std::memcpy(vertexMapped, geometry.vertices.data(), vertexBytes);
+        std::memcpy(indexMapped, geometry.indices.data(), indexBytes);
+    }
+
+    VkClearValue clearValue{};
+    clearValue.color.uint32[0] = 0;
+    VkRenderPassBeginInfo rpInfo{};
+    rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    rpInfo.renderPass = renderPass;
+    rpInfo.framebuffer = framebuffer;
+    rpInfo.renderArea.extent = extent;
+    rpInfo.clearValueCount = 1;
+    rpInfo.pClearValues = &clearValue;
+    vkCmdBeginRenderPass(commandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    if (hasGeometry)
+    {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+        VkViewport viewport{};
+        viewport.width = static_cast<float>(extent.width);
+        viewport.height = static_cast<float>(extent.height);
+        viewport.maxDepth = 1.0f;
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+        // Same projection and clipping as the ImGui backend
+        float pushConstants[4];
+        pushConstants[0] = 2.0f / displaySize.x;
+        pushConstants[1] = 2.0f / displaySize.y;
+        pushConstants[2] = -1.0f - displayPos.x * pushConstants[0];
+        pushConstants[3] = -1.0f - displayPos.y * pushConstants[1];
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(pushConstants), pushConstants);
+
+        float clipMinX = std::max((geometry.clipRect.x - displayPos.x) * framebufferScale.x, 0.0f);
+        float clipMinY = std::max((geometry.clipRect.y - displayPos.y) * framebufferScale.y, 0.0f);
+        float clipMaxX = std::min((geometry.clipRect.z - displayPos.x) * framebufferScale.x, static_cast<float>(extent.width));
+        float clipMaxY = std::min((geometry.clipRect.w - displayPos.y) * framebufferScale.y, static_cast<float>(extent.height));
+        VkRect2D scissor{};
+        scissor.offset.x = static_cast<int32_t>(clipMinX);
+        scissor.offset.y = static_cast<int32_t>(clipMinY);
+        scissor.extent.width = static_cast<uint32_t>(std::max(clipMaxX - clipMinX, 0.0f));
+        scissor.extent.height = static_cast<uint32_t>(std::max(clipMaxY - clipMinY, 0.0f));
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(geometry.indices.size()), 1, 0, 0, 0);
+    }
+    vkCmdEndRenderPass(commandBuffer);
+
+    // Copy the block around the cursor and make it visible to the host
+    VkBufferImageCopy region{};
+    region.bufferRowLength = static_cast<uint32_t>(readbackWidth);
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {readbackX, readbackY, 0};
+    region.imageExtent = {static_cast<uint32_t>(readbackWidth), static_cast<uint32_t>(readbackHeight), 1};
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, 1, &region);
+
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = readbackBuffer;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                         0, nullptr, 1, &barrier, 0, nullptr);
+
+    readbackInFlight = true;
+    fenceTaken = false;
+}
+
+VkFence IdPickingPass::TakeSubmitFence()
+{
+    if (!readbackInFlight || fenceTaken)
+        return VK_NULL_HANDLE;
+
+    fenceTaken = true;
+    return readbackFence;
+}
+
+bool IdPickingPass::PollResult(uint32_t &outId)
+{
+    if (!readbackInFlight || !fenceTaken || vkGetFenceStatus(device, readbackFence) != VK_SUCCESS)
+        return false;
+
+    vkResetFences(device, 1, &readbackFence);
+    readbackInFlight = false;
+
+    // The pixel under the cursor wins, otherwise the nearest covered pixel in the block
+    const uint32_t *ids = static_cast<const uint32_t *>(readbackMapped);
+    outId = 0;
+    int bestDistance = 0;
+    for (int y = 0; y < readbackHeight; y++)
+    {
+        for (int x = 0; x < readbackWidth; x++)
+        {
+            uint32_t id = ids[y * readbackWidth + x];
+            int distance = (x - readbackCenterX) * (x - readbackCenterX) + (y - readbackCenterY) * (y - readbackCenterY);
+            if (id != 0 && (outId == 0 || distance < bestDistance))
+            {
+                outId = id;
+                bestDistance = distance;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,457 @@
+#include "JsonSaxParser.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    // Powers of ten that are exact in a double
+    const double ExactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    int HexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    void AppendUtf8(std::string &out, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            out.push_back(static_cast<char>(codePoint));
+        }
+        else if (codePoint < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+}
+
+JsonSaxParser::JsonSaxParser()
+{
+}
+
+JsonSaxParser::~JsonSaxParser()
+{
+    // Nothing to clean up
+}
+
+bool JsonSaxParser::Parse(const char *data, size_t size, JsonSaxHandler &handler)
+{
+    begin = data;
+    cursor = data;
+    end = data + size;
+    containers.clear();
+    error.clear();
+
+    enum class State
+    {
+        Value,
+        Key,
+        AfterValue
+    };
+    State state = State::Value;
+
+    const char *text;
+    size_t length;
+    double number;
+    while (true)
+    {
+        SkipWhitespace();
+        switch (state)
+        {
+        case State::Value:
+            if (cursor == end)
+                return Fail("unexpected end of input");
+
+            switch (*cursor)
+            {
+            case '{':
+                cursor++;
+                if (!handler.StartObject())
+                    return false;
+                containers.push_back('{');
+                SkipWhitespace();
+                if (cursor < end && *cursor == '}')
+                {
+                    cursor++;
+                    containers.pop_back();
+                    if (!handler.EndObject())
+                        return false;
+                    state = State::AfterValue;
+                }
+                else
+                {
+                    state = State::Key;
+                }
+                break;
+
+            case '[':
+                cursor++;
+                if (!handler.StartArray())
+                    return false;
+                containers.push_back('[');
+                SkipWhitespace();
+                if (cursor < end && *cursor == ']')
+                {
+                    cursor++;
+                    containers.pop_back();
+                    if (!handler.EndArray())
+                        return false;
+                    state = State::AfterValue;
+                }
+                break;
+
+            case '"':
+                if (!ParseString(text, length) || !handler.String(text, length))
+                    return false;
+                state = State::AfterValue;
+                break;
+
+            case 't':
+                if (!ParseLiteral("true", 4) || !handler.Bool(true))
+                    return false;
+                state = State::AfterValue;
+                break;
+
+            case 'f':
+                if (!ParseLiteral("false", 5) || !handler.Bool(false))
+                    return false;
+                state = State::AfterValue;
+                break;
+
+            case 'n':
+                if (!ParseLiteral("null", 4) || !handler.Null())
+                    return false;
+                state = State::AfterValue;
+                break;
+
+            default:
+                if (*cursor != '-' && !IsDigit(*cursor))
+                    return Fail("unexpected character");
+                if (!ParseNumber(number) || !handler.Number(number))
+                    return false;
+                state = State::AfterValue;
+                break;
+            }
+            break;
+
+        case State::Key:
+            if (cursor == end || *cursor != '"')
+                return Fail("expected a string key");
+            if (!ParseString(text, length) || !handler.Key(text, length))
+                return false;
+
+            SkipWhitespace();
+            if (cursor == end || *cursor != ':')
+                return Fail("expected ':' after a key");
+            cursor++;
+            state = State::Value;
+            break;
+
+        case State::AfterValue:
+            // The document is a single value
+            if (containers.empty())
+            {
+                if (cursor != end)
+                    return Fail("unexpected data after the document");
+                return true;
+            }
+
+            if (cursor == end)
+                return Fail("unexpected end of input");
+
+            if (*cursor == ',')
+            {
+                cursor++;
+                state = containers.back() == '{' ? State::Key : State::Value;
+            }
+            else if (*cursor == '}' && containers.back() == '{')
+            {
+                cursor++;
+                containers.pop_back();
+                if (!handler.EndObject())
+                    return false;
+            }
+            else if (*cursor == ']' && containers.back() == '[')
+            {
+                cursor++;
+                containers.pop_back();
+                if (!handler.EndArray())
+                    return false;
+            }
+            else
+            {
+                return Fail("expected ',' or a closing bracket");
+            }
+            break;
+        }
+    }
+}
+
+const std::string &JsonSaxParser::GetError() const
+{
+    return error;
+}
+
+size_t JsonSaxParser::GetErrorLine() const
+{
+    // The cursor stays where parsing stopped
+    return 1 + static_cast<size_t>(std::count(begin, cursor, '\n'));
+}
+
+void JsonSaxParser::SkipWhitespace()
+{
+    while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t'))
+    {
+        cursor++;
+    }
+}
+
+bool JsonSaxParser::ParseString(const char *&outValue, size_t &outLength)
+{
+    // Skip the opening quote
+    cursor++;
+    const char *start = cursor;
+
+    // Most strings have no escapes and are passed straight from the input
+    while (cursor < end && *cursor != '"' && *cursor != '\\')
+    {
+        if (static_cast<unsigned char>(*cursor) < 0x20)
+            return Fail("control character in string");
+        cursor++;
+    }
+    if (cursor == end)
+        return Fail("unterminated string");
+
+    if (*cursor == '"')
+    {
+        outValue = start;
+        outLength = static_cast<size_t>(cursor - start);
+        cursor++;
+        return true;
+    }
+
+    // Decode the rest into the scratch buffer
+    scratch.assign(start, cursor);
+    while (true)
+    {
+        if (cursor == end)
+            return Fail("unterminated string");
+
+        char c = *cursor++;
+        if (c == '"')
+            break;
+        if (static_cast<unsigned char>(c) < 0x20)
+            return Fail("control character in string");
+        if (c != '\\')
+        {
+            scratch.push_back(c);
+            continue;
+        }
+
+        if (cursor == end)
+            return Fail("unterminated string");
+
+        switch (*cursor++)
+        {
+        case '"':
+            scratch.push_back('"');
+            break;
+        case '\\':
+            scratch.push_back('\\');
+            break;
+        case '/':
+            scratch.push_back('/');
+            break;
+        case 'b':
+            scratch.push_back('\b');
+            break;
+        case 'f':
+            scratch.push_back('\f');
+            break;
+        case 'n':
+            scratch.push_back('\n');
+            break;
+        case 'r':
+            scratch.push_back('\r');
+            break;
+        case 't':
+            scratch.push_back('\t');
+            break;
+        case 'u':
+        {
+            uint32_t codePoint = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                int digit = cursor < end ? HexValue(*cursor) : -1;
+                if (digit < 0)
+                    return Fail("invalid unicode escape");
+                codePoint = (codePoint << 4) | static_cast<uint32_t>(digit);
+                cursor++;
+            }
+
+            // Characters outside the basic plane come as a surrogate pair
+            if (codePoint >= 0xD800 && codePoint < 0xDC00)
+            {
+                uint32_t low = 0;
+                if (end - cursor < 6 || cursor[0] != '\\' || cursor[1] != 'u')
+                    return Fail("unpaired surrogate in unicode escape");
+                cursor += 2;
+                for (int i = 0; i < 4; i++)
+                {
+                    int digit = HexValue(*cursor);
+                    if (digit < 0)
+                        return Fail("invalid unicode escape");
+                    low = (low << 4) | static_cast<uint32_t>(digit);
+                    cursor++;
+                }
+                if (low < 0xDC00 || low >= 0xE000)
+                    return Fail("unpaired surrogate in unicode escape");
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            AppendUtf8(scratch, codePoint);
+            break;
+        }
+        default:
+            return Fail("invalid escape in string");
+        }
+    }
+
+    outValue = scratch.data();
+    outLength = scratch.size();
+    return true;
+}
+
+bool JsonSaxParser::ParseNumber(double &outValue)
+{
+    bool negative = false;
+    if (*cursor == '-')
+    {
+        negative = true;
+        cursor++;
+    }
+    if (cursor == end || !IsDigit(*cursor))
+        return Fail("invalid number");
+
+    // Up to 19 significant digits are kept in an integer, the rest only move the exponent
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    if (*cursor == '0')
+    {
+        cursor++;
+    }
+    else
+    {
+        while (cursor < end && IsDigit(*cursor))
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                digits++;
+            }
+            else
+            {
+                exponent++;
+            }
+            cursor++;
+        }
+    }
+
+    if (cursor < end && *cursor == '.')
+    {
+        cursor++;
+        if (cursor == end || !IsDigit(*cursor))
+            return Fail("invalid number");
+
+        while (cursor < end && IsDigit(*cursor))
+        {
+            // Leading zeros of the fraction aren't significant
+            if (digits < 19 && (mantissa != 0 || *cursor != '0'))
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                digits++;
+                exponent--;
+            }
+            else if (mantissa == 0)
+            {
+                exponent--;
+            }
+            cursor++;
+        }
+    }
+
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        cursor++;
+        bool negativeExponent = false;
+        if (cursor < end && (*cursor == '+' || *cursor == '-'))
+        {
+            negativeExponent = *cursor == '-';
+            cursor++;
+        }
+        if (cursor == end || !IsDigit(*cursor))
+            return Fail("invalid number");
+
+        int explicitExponent = 0;
+        while (cursor < end && IsDigit(*cursor))
+        {
+            if (explicitExponent < 10000)
+                explicitExponent = explicitExponent * 10 + (*cursor - '0');
+            cursor++;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (exponent >= 0 && exponent <= 22)
+        value *= ExactPowersOfTen[exponent];
+    else if (exponent < 0 && exponent >= -22)
+        value /= ExactPowersOfTen[-exponent];
+    else if (mantissa != 0)
+        value *= std::pow(10.0, exponent);
+
+    outValue = negative ? -value : value;
+    return true;
+}
+
+bool JsonSaxParser::ParseLiteral(const char *literal, size_t length)
+{
+    if (static_cast<size_t>(end - cursor) < length || !std::equal(literal, literal + length, cursor))
+        return Fail("invalid literal");
+
+    cursor += length;
+    return true;
+}
+
+bool JsonSaxParser::Fail(const char *message)
+{
+    error = message;
+    return false;
+}
@@ -1,164 +1,404 @@
 #include "Node.h"
 #include <algorithm>
+#include <cmath>
+#include <unordered_map>
 #include <imgui.h>
-#include "DocumentationManager.h"
+#include "NodeChangeBus.h"
+#include "NodeReflection.h"
+#include "NodeTypeRegistry.h"
+#include "RenderQueue.h"
 
-Node::Node(const std::string &nodeName, NodeType nodeType) : name(nodeName), type(nodeType)
+namespace
 {
-    // Register base node documentation if not already done
-    static bool documentationInitialized = false;
-    if (!documentationInitialized)
+    // Number of live nodes caching their subtree, lets the editor skip cache lookups when zero
+    int &RenderCacheCount()
     {
-        documentationInitialized = true;
-        InitializeDocumentation();
+        static int renderCacheCount = 0;
+        return renderCacheCount;
     }
+
+    // Live nodes by instance id, for lookups that must not hold pointers across frames
+    std::unordered_map<uint32_t, Node *> &InstanceRegistry()
+    {
+        static std::unordered_map<uint32_t, Node *> instances;
+        return instances;
+    }
+
+    uint32_t &HierarchyVersion()
+    {
+        static uint32_t hierarchyVersion = 0;
+        return hierarchyVersion;
+    }
+
+    const float DegreesToRadians = 3.14159265f / 180.0f;
+}
+
+Node::Node(const StringAtom &nodeName, NodeType nodeType) : name(nodeName), type(nodeType)
+{
+    static uint32_t nextInstanceId = 1;
+    instanceId = nextInstanceId++;
+    InstanceRegistry().emplace(instanceId, this);
 }
 
 Node::~Node()
 {
+    // Detach children that are still referenced elsewhere
+    for (auto &child : children)
+    {
+        child->parent = nullptr;
+        if (child.use_count() > 1)
+        {
+            child->MarkTransformDirty();
+        }
+    }
+
     // Clean up children
     children.clear();
+
+    if (cacheAsBitmap)
+    {
+        RenderCacheCount()--;
+    }
+
+    InstanceRegistry().erase(instanceId);
+    NodeChangeBus::RecordDestroyed(this);
+    HierarchyVersion()++;
 }
 
-void Node::Update(float deltaTime)
+const StringAtom &Node::GetName() const
 {
-    // Base implementation does nothing
-    // Update all children
-    for (auto &child : children)
+    return name;
+}
+
+void Node::SetName(const StringAtom &newName)
+{
+    if (name == newName)
+        return;
+
+    name = newName;
+    MarkChanged(NodeChangeName);
+}
+
+void Node::MarkChanged(uint8_t changes)
+{
+    // Only the first change in a frame costs an event, the rest merge into it
+    if ((pendingChanges & changes) != changes)
     {
-        child->Update(deltaTime);
+        NodeChangeBus::Record(this, changes);
     }
 }
 
-void Node::Render()
+uint8_t Node::GetPendingChanges() const
 {
-    // Base implementation does nothing
-    // Render all children
-    for (auto &child : children)
+    return pendingChanges;
+}
+
+void Node::MarkVisualDirty()
+{
+    MarkChanged(NodeChangeVisual);
+    InvalidateRenderCache();
+}
+
+void Node::MarkTransformDirty()
+{
+    // The event makes the bus recompute the subtree, descendants are refreshed with it
+    MarkChanged(NodeChangeTransform);
+    if (transformDirty)
+        return;
+
+    transformDirty = true;
+
+    // Moving a cache root only offsets its cached drawing, anything inside it needs a redraw
+    if (parent)
     {
-        child->Render();
+        parent->InvalidateRenderCache();
     }
 }
 
-void Node::RenderInspectorProperties()
+void Node::SetCacheAsBitmap(bool enabled)
 {
-    // Base implementation just shows transform properties
-    ImGui::Text("Transform");
+    if (cacheAsBitmap == enabled)
+        return;
+
+    cacheAsBitmap = enabled;
+    RenderCacheCount() += enabled ? 1 : -1;
 
-    // Position
-    ImGui::Text("Position");
-    ImGui::SameLine(100);
-    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
-    ImGui::InputFloat3("##Position", transform.position);
-    ImGui::PopItemWidth();
+    // Enclosing caches now draw this subtree differently
+    InvalidateRenderCache();
+}
 
-    // Rotation
-    ImGui::Text("Rotation");
-    ImGui::SameLine(100);
-    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
-    ImGui::InputFloat3("##Rotation", transform.rotation);
-    ImGui::PopItemWidth();
+bool Node::IsCacheAsBitmap() const
+{
+    return cacheAsBitmap;
+}
 
-    // Scale
-    ImGui::Text("Scale");
-    ImGui::SameLine(100);
-    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
-    ImGui::InputFloat3("##Scale", transform.scale);
-    ImGui::PopItemWidth();
+void Node::InvalidateRenderCache()
+{
+    // Bump every cache this node is drawn into
+    for (Node *node = this; node; node = node->parent)
+    {
+        if (node->cacheAsBitmap)
+        {
+            node->renderCacheVersion++;
+        }
+    }
 }
 
-std::vector<NodeType> Node::GetAvailableNodeTypes()
+uint32_t Node::GetRenderCacheVersion() const
 {
-    // Return all available node types
-    std::vector<NodeType> types;
+    return renderCacheVersion;
+}
 
-    // Add all node types except Root
-    for (int i = 0; i <= static_cast<int>(NodeType::Panel); i++)
+Node *Node::GetRenderCacheRoot()
+{
+    // The outermost cache wins, nested caches are drawn into it
+    Node *cacheRoot = nullptr;
+    for (Node *node = this; node; node = node->parent)
     {
-        NodeType type = static_cast<NodeType>(i);
-        if (type != NodeType::Root) // Skip Root type as it's special
+        if (node->cacheAsBitmap)
         {
-            types.push_back(type);
+            cacheRoot = node;
         }
     }
+    return cacheRoot;
+}
 
-    return types;
+bool Node::HasRenderCaches()
+{
+    return RenderCacheCount() > 0;
 }
 
-void Node::AddChild(std::shared_ptr<Node> child)
+bool Node::IsTransformDirty() const
 {
-    children.push_back(child);
+    return transformDirty;
 }
 
-void Node::RemoveChild(std::shared_ptr<Node> child)
+void Node::UpdateWorldTransform()
 {
-    auto it = std::find(children.begin(), children.end(), child);
-    if (it != children.end())
+    static const Transform identity;
+    ComposeTransforms(parent ? parent->worldTransform : identity, transform, worldTransform);
+    transformDirty = false;
+}
+
+void Node::ComposeTransforms(const Transform &parentWorld, const Transform &local, Transform &outWorld)
+{
+    // Scale and rotate the local offset into the parent's space
+    float radians = parentWorld.rotation[2] * DegreesToRadians;
+    float cosR = cosf(radians);
+    float sinR = sinf(radians);
+    float localX = local.position[0] * parentWorld.scale[0];
+    float localY = local.position[1] * parentWorld.scale[1];
+
+    outWorld.position[0] = parentWorld.position[0] + localX * cosR - localY * sinR;
+    outWorld.position[1] = parentWorld.position[1] + localX * sinR + localY * cosR;
+    outWorld.position[2] = parentWorld.position[2] + local.position[2] * parentWorld.scale[2];
+
+    for (int i = 0; i < 3; i++)
     {
-        children.erase(it);
+        outWorld.rotation[i] = parentWorld.rotation[i] + local.rotation[i];
+        outWorld.scale[i] = parentWorld.scale[i] * local.scale[i];
+    }
+}
+
+void Node::WorldOffsetToLocal(float worldX, float worldY, float &outLocalX, float &outLocalY) const
+{
+    if (!parent)
+    {
+        outLocalX = worldX;
+        outLocalY = worldY;
+        return;
+    }
+
+    // Undo the parent's rotation, then its scale, the reverse of ComposeTransforms
+    const Transform &parentWorld = parent->worldTransform;
+    float radians = parentWorld.rotation[2] * DegreesToRadians;
+    float cosR = cosf(radians);
+    float sinR = sinf(radians);
+    float rotatedX = worldX * cosR + worldY * sinR;
+    float rotatedY = -worldX * sinR + worldY * cosR;
+
+    // A zero scale collapses the axis, no local offset reaches it
+    outLocalX = parentWorld.scale[0] != 0.0f ? rotatedX / parentWorld.scale[0] : 0.0f;
+    outLocalY = parentWorld.scale[1] != 0.0f ? rotatedY / parentWorld.scale[1] : 0.0f;
+}
+
+uint32_t Node::GetInstanceId() const
+{
+    return instanceId;
+}
+
+Node *Node::FindByInstanceId(uint32_t id)
+{
+    auto it = InstanceRegistry().find(id);
+    return it != InstanceRegistry().end() ? it->second : nullptr;
+}
+
+uint32_t Node::GetHierarchyVersion()
+{
+    return HierarchyVersion();
+}
+
+bool Node::GetProperty(NodeProperty property, std::vector<uint8_t> &outValue) const
+{
+    return NodeReflection::GetProperty(*this, property, outValue);
+}
+
+bool Node::SetProperty(NodeProperty property, const uint8_t *value, size_t size)
+{
+    return NodeReflection::SetProperty(*this, property, value, size);
+}
+
+void Node::CopyProperties(const Node &source)
+{
+    NodeReflection::Copy(*this, source);
+}
+
+void Node::DiffProperties(const Node &other, std::vector<NodeProperty> &outChanged) const
+{
+    NodeReflection::Diff(*this, other, outChanged);
+}
+
+const std::vector<PropertyInfo> &Node::GetPropertyInfos() const
+{
+    return NodeReflection::GetPropertyInfos<Node>();
+}
+
+void Node::GetLocalBounds(float outMin[2], float outMax[2]) const
+{
+    // Nodes without visuals are represented by a small marker around their origin
+    outMin[0] = -10.0f;
+    outMin[1] = -10.0f;
+    outMax[0] = 10.0f;
+    outMax[1] = 10.0f;
+}
+
+void Node::GetWorldBounds(float outMin[2], float outMax[2]) const
+{
+    float localMin[2], localMax[2];
+    GetLocalBounds(localMin, localMax);
+
+    float radians = worldTransform.rotation[2] * DegreesToRadians;
+    float cosR = cosf(radians);
+    float sinR = sinf(radians);
+
+    // Transform the four corners and take their axis-aligned bounds
+    outMin[0] = outMin[1] = INFINITY;
+    outMax[0] = outMax[1] = -INFINITY;
+    for (int corner = 0; corner < 4; corner++)
+    {
+        float x = ((corner & 1) ? localMax[0] : localMin[0]) * worldTransform.scale[0];
+        float y = ((corner & 2) ? localMax[1] : localMin[1]) * worldTransform.scale[1];
+        float worldX = worldTransform.position[0] + x * cosR - y * sinR;
+        float worldY = worldTransform.position[1] + x * sinR + y * cosR;
+        outMin[0] = std::min(outMin[0], worldX);
+        outMin[1] = std::min(outMin[1], worldY);
+        outMax[0] = std::max(outMax[0], worldX);
+        outMax[1] = std::max(outMax[1], worldY);
     }
 }
 
-std::string Node::GetTypeName() const
+void Node::GetWorldBounds3D(float outMin[3], float outMax[3]) const
 {
-    return "Node";
+    GetWorldBounds(outMin, outMax);
+
+    // Depth uses the same marker extent as the planar bounds
+    float halfDepth = 10.0f * fabsf(worldTransform.scale[2]);
+    outMin[2] = worldTransform.position[2] - halfDepth;
+    outMax[2] = worldTransform.position[2] + halfDepth;
 }
 
-void Node::RegisterMethod(const std::string &nodeType, const MethodDoc &methodDoc)
+bool Node::IsInTree(const Node *root) const
 {
-    // Use DocumentationManager to register the method
-    auto &nodeDocs = DocumentationManager::GetNodeDocumentation();
-    nodeDocs[nodeType].push_back(methodDoc);
+    for (const Node *node = this; node; node = node->parent)
+    {
+        if (node == root)
+            return true;
+    }
+    return false;
 }
 
-void Node::RegisterNodeDescription(const std::string &nodeType, const std::string &description)
+void Node::Update(float deltaTime)
 {
-    // Use DocumentationManager to register the node description
-    DocumentationManager::RegisterNodeDescription(nodeType, description);
+    // Base implementation does nothing
+    // Update all children
+    for (auto &child : children)
+    {
+        child->Update(deltaTime);
+    }
 }
 
-void Node::InitializeDocumentation()
+void Node::Render()
+{
+    // Base implementation does nothing
+    // Render all children
+    for (auto &child : children)
+    {
+        child->Render();
+    }
+}
+
+void Node::SubmitDraw(const Transform &world, RenderQueue &opaqueQueue, RenderQueue &transparentQueue)
+{
+    // Base implementation draws nothing
+}
+
+void Node::SubmitDrawCalls(RenderQueue &opaqueQueue, RenderQueue &transparentQueue)
+{
+    SubmitDraw(worldTransform, opaqueQueue, transparentQueue);
+
+    // Submit all children
+    for (auto &child : children)
+    {
+        child->SubmitDrawCalls(opaqueQueue, transparentQueue);
+    }
+}
+
+void Node::RenderInspectorProperties()
 {
-    // Register node description
-    RegisterNodeDescription("Node", "Base class for all nodes in the scene hierarchy.");
+    // Base implementation just shows transform properties
+    NodeReflection::RenderInspector(*this);
+}
 
-    // Register Update method
-    RegisterMethod("Node", {"Update",
-                            "Updates the node state based on the elapsed time.",
-                            "void",
-                            "None",
-                            {{"deltaTime", "Time elapsed since the last frame in seconds"}},
-                            {"node->Update(deltaTime);"}});
+const std::vector<NodeType> &Node::GetAvailableNodeTypes()
+{
+    // Every registered type except Root
+    return NodeTypeRegistry::GetCreatableTypes();
+}
 
-    // Register Render method
-    RegisterMethod("Node", {"Render",
-                            "Renders the node to the screen.",
-                            "void",
-                            "None",
-                            {},
-                            {"node->Render();"}});
+void Node::AddChild(std::shared_ptr<Node> child)
+{
+    // Reparent if the child already belongs to another node
+    if (child->parent && child->parent != this)
+    {
+        child->parent->RemoveChild(child);
+    }
 
-    // Register AddChild method
-    RegisterMethod("Node", {"AddChild",
-                            "Adds a child node to this node.",
-                            "void",
-                            "None",
-                            {{"child", "Shared pointer to the child node to add"}},
-                            {"auto childNode = std::make_shared<Node2D>(\"Child\");\nparentNode->AddChild(childNode);"}});
+    children.push_back(child);
+    child->parent = this;
+    child->MarkTransformDirty();
+    child->MarkChanged(NodeChangeStructure);
+    MarkChanged(NodeChangeStructure);
+    InvalidateRenderCache();
+    HierarchyVersion()++;
+}
 
-    // Register RemoveChild method
-    RegisterMethod("Node", {"RemoveChild",
-                            "Removes a child node from this node.",
-                            "void",
-                            "None",
-                            {{"child", "Shared pointer to the child node to remove"}},
-                            {"parentNode->RemoveChild(childNode);"}});
+void Node::RemoveChild(std::shared_ptr<Node> child)
+{
+    auto it = std::find(children.begin(), children.end(), child);
+    if (it != children.end())
+    {
+        children.erase(it);
+        child->parent = nullptr;
+        child->MarkTransformDirty();
+        child->MarkChanged(NodeChangeStructure);
+        MarkChanged(NodeChangeStructure);
+        InvalidateRenderCache();
+        HierarchyVersion()++;
+    }
+}
 
-    // Register GetTypeName method
-    RegisterMethod("Node", {"GetTypeName",
-                            "Returns the type name of the node.",
-                            "std::string",
-                            "The type name as a string",
-                            {},
-                            {"std::string typeName = node->GetTypeName();"}});
+const StringAtom &Node::GetTypeName() const
+{
+    static const StringAtom typeName("Node");
+    return typeName;
 }
\ No newline at end of file
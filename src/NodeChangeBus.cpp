@@ -0,0 +1,135 @@
+#include "NodeChangeBus.h"
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    struct Subscription
+    {
+        uint32_t id;
+        uint8_t changeMask;
+        NodeChangeBus::Listener listener;
+    };
+
+    std::vector<Subscription> &Subscriptions()
+    {
+        static std::vector<Subscription> subscriptions;
+        return subscriptions;
+    }
+
+    // Events recorded since the last flush, one per changed node
+    std::vector<NodeChangeEvent> &PendingEvents()
+    {
+        static std::vector<NodeChangeEvent> pendingEvents;
+        return pendingEvents;
+    }
+
+    // Batch being delivered, kept to reuse its storage
+    std::vector<NodeChangeEvent> &DeliveredEvents()
+    {
+        static std::vector<NodeChangeEvent> deliveredEvents;
+        return deliveredEvents;
+    }
+}
+
+uint32_t NodeChangeBus::Subscribe(uint8_t changeMask, Listener listener)
+{
+    static uint32_t nextId = 1;
+    Subscriptions().push_back({nextId, changeMask, std::move(listener)});
+    return nextId++;
+}
+
+void NodeChangeBus::Unsubscribe(uint32_t subscription)
+{
+    auto &subscriptions = Subscriptions();
+    subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                       [subscription](const Subscription &entry)
+                                       { return entry.id == subscription; }),
+                        subscriptions.end());
+}
+
+void NodeChangeBus::Flush()
+{
+    auto &events = DeliveredEvents();
+    events.clear();
+    std::swap(events, PendingEvents());
+    if (events.empty())
+        return;
+
+    // World transforms are current before anyone sees the batch
+    RefreshWorldTransforms(events);
+
+    // Nodes start recording afresh before anyone sees the batch, so changes made by listeners land in the next one
+    uint8_t batchChanges = 0;
+    for (const NodeChangeEvent &event : events)
+    {
+        if (event.node)
+        {
+            event.node->pendingChanges = 0;
+            event.node->changeSlot = 0;
+        }
+        batchChanges |= event.changes;
+    }
+
+    for (const Subscription &subscription : Subscriptions())
+    {
+        if (subscription.changeMask & batchChanges)
+        {
+            subscription.listener(events);
+        }
+    }
+}
+
+bool NodeChangeBus::HasPendingChanges()
+{
+    return !PendingEvents().empty();
+}
+
+void NodeChangeBus::Record(Node *node, uint8_t changes)
+{
+    AddChange(PendingEvents(), node, changes);
+}
+
+void NodeChangeBus::RecordDestroyed(Node *node)
+{
+    // The event outlives the node, only its id is left to identify it
+    Record(node, NodeChangeDestroyed);
+    PendingEvents()[node->changeSlot - 1].node = nullptr;
+}
+
+void NodeChangeBus::AddChange(std::vector<NodeChangeEvent> &events, Node *node, uint8_t changes)
+{
+    if (node->changeSlot == 0)
+    {
+        events.push_back({node, node, node->GetInstanceId(), 0});
+        node->changeSlot = static_cast<uint32_t>(events.size());
+    }
+    events[node->changeSlot - 1].changes |= changes;
+    node->pendingChanges |= changes;
+}
+
+void NodeChangeBus::RefreshWorldTransforms(std::vector<NodeChangeEvent> &events)
+{
+    // Only the recorded events are roots, the events appended for their descendants are refreshed with them
+    const size_t recordedCount = events.size();
+    for (size_t i = 0; i < recordedCount; ++i)
+    {
+        // A subtree already refreshed with a moved ancestor is clean
+        Node *node = events[i].node;
+        if (node && node->transformDirty)
+        {
+            RefreshSubtree(node, events);
+        }
+    }
+}
+
+void NodeChangeBus::RefreshSubtree(Node *node, std::vector<NodeChangeEvent> &events)
+{
+    node->UpdateWorldTransform();
+    for (auto &child : node->children)
+    {
+        // Slots still index this batch, it was only swapped out of the pending list
+        AddChange(events, child.get(), NodeChangeTransform);
+        RefreshSubtree(child.get(), events);
+    }
+}
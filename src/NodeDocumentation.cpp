@@ -0,0 +1,17 @@
+#include "NodeDocumentation.h"
+#include "NodeDocumentationTables.h"
+#include <algorithm>
+#include <iterator>
+
+DocSpan<NodeDoc> NodeDocumentation::GetNodes()
+{
+    return {NodeDocumentationTables::Nodes, static_cast<uint32_t>(std::size(NodeDocumentationTables::Nodes))};
+}
+
+const NodeDoc *NodeDocumentation::Find(std::string_view nodeType)
+{
+    DocSpan<NodeDoc> nodes = GetNodes();
+    auto it = std::lower_bound(nodes.begin(), nodes.end(), nodeType, [](const NodeDoc &node, std::string_view name)
+                               { return std::string_view(node.nodeType) < name; });
+    return it != nodes.end() && it->nodeType == nodeType ? it : nullptr;
+}
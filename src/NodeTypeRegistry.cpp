@@ -0,0 +1,95 @@
+#include "NodeTypeRegistry.h"
+#include <array>
+#include <cstring>
+#include <utility>
+#include "../nodes/Node2D/Node2D.h"
+#include "../nodes/Sprite/Sprite.h"
+#include "../nodes/Camera2D/Camera2D.h"
+#include "../nodes/Light2D/Light2D.h"
+#include "../nodes/Label/Label.h"
+
+// Types without a class of their own are plain nodes
+
+template <>
+struct NodeTypeRegistration<NodeType::Root>
+{
+    static constexpr NodeTypeInfo Info = {"Root", "Scene", "\xef\x81\x80", false, // fa-sitemap
+                                          &CreateRegisteredNode<Node>};
+};
+
+template <>
+struct NodeTypeRegistration<NodeType::CharacterBody2D>
+{
+    static constexpr NodeTypeInfo Info = {"CharacterBody2D", "CharacterBody2D", "\xef\x86\x8e", true, // fa-user
+                                          &CreateRegisteredNode<Node>};
+};
+
+template <>
+struct NodeTypeRegistration<NodeType::Button>
+{
+    static constexpr NodeTypeInfo Info = {"Button", "Button", "\xef\x81\x95", true, // fa-hand-pointer-o
+                                          &CreateRegisteredNode<Node>};
+};
+
+template <>
+struct NodeTypeRegistration<NodeType::Panel>
+{
+    static constexpr NodeTypeInfo Info = {"Panel", "Panel", "\xef\x84\xa6", true, // fa-window-maximize
+                                          &CreateRegisteredNode<Node>};
+};
+
+namespace
+{
+    constexpr size_t NodeTypeCount = static_cast<size_t>(NodeType::Count);
+
+    // One entry per NodeType, a missing registration is a compile error here
+    template <size_t... Index>
+    constexpr std::array<NodeTypeInfo, NodeTypeCount> MakeNodeTypeTable(std::index_sequence<Index...>)
+    {
+        return {{NodeTypeRegistration<static_cast<NodeType>(Index)>::Info...}};
+    }
+
+    constexpr std::array<NodeTypeInfo, NodeTypeCount> NodeTypeTable = MakeNodeTypeTable(std::make_index_sequence<NodeTypeCount>());
+
+    constexpr NodeTypeInfo UnknownNodeType = {"Unknown", "Node", "\xef\x81\x90", false, // fa-question-circle
+                                              &CreateRegisteredNode<Node>};
+}
+
+const NodeTypeInfo &NodeTypeRegistry::Get(NodeType type)
+{
+    const size_t index = static_cast<size_t>(type);
+    return index < NodeTypeCount ? NodeTypeTable[index] : UnknownNodeType;
+}
+
+const std::vector<NodeType> &NodeTypeRegistry::GetCreatableTypes()
+{
+    static const std::vector<NodeType> creatableTypes = []
+    {
+        std::vector<NodeType> types;
+        for (size_t i = 0; i < NodeTypeCount; i++)
+        {
+            if (NodeTypeTable[i].creatable)
+                types.push_back(static_cast<NodeType>(i));
+        }
+        return types;
+    }();
+    return creatableTypes;
+}
+
+std::shared_ptr<Node> NodeTypeRegistry::Create(NodeType type, const StringAtom &name, bool is3D)
+{
+    return Get(type).create(name, type, is3D);
+}
+
+bool NodeTypeRegistry::FindByName(const char *name, size_t length, NodeType &outType)
+{
+    for (size_t i = 0; i < NodeTypeCount; i++)
+    {
+        if (std::strncmp(NodeTypeTable[i].name, name, length) == 0 && NodeTypeTable[i].name[length] == '\0')
+        {
+            outType = static_cast<NodeType>(i);
+            return true;
+        }
+    }
+    return false;
+}
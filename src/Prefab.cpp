@@ -0,0 +1,162 @@
+#include "Prefab.h"
+#include <algorithm>
+#include "SceneFile.h"
+#include "../nodes/PrefabInstance/PrefabInstance.h"
+
+namespace
+{
+    void AddPrefab(const Prefab *prefab, std::vector<const Prefab *> &outPrefabs)
+    {
+        if (std::find(outPrefabs.begin(), outPrefabs.end(), prefab) != outPrefabs.end())
+            return;
+
+        // Prefabs the template instances come first, so a loader can build them in list order
+        Prefab::CollectPrefabs(prefab->GetRoot().get(), outPrefabs);
+        outPrefabs.push_back(prefab);
+    }
+}
+
+std::shared_ptr<const Prefab> Prefab::Create(const Node *source)
+{
+    if (!source)
+        return nullptr;
+
+    return Adopt(CloneTree(source));
+}
+
+std::shared_ptr<const Prefab> Prefab::Adopt(std::shared_ptr<Node> root)
+{
+    if (!root || root->parent)
+        return nullptr;
+
+    // Instances place the template with their own transform
+    root->transform = Node::Transform();
+
+    std::shared_ptr<Prefab> prefab(new Prefab());
+    prefab->root = root;
+
+    // Parents come before their children, so each world transform is built on an up to date parent
+    std::vector<std::pair<Node *, uint32_t>> stack = {{root.get(), NoParent}};
+    while (!stack.empty())
+    {
+        Node *node = stack.back().first;
+        const uint32_t parentIndex = stack.back().second;
+        stack.pop_back();
+        node->UpdateWorldTransform();
+
+        const uint32_t index = static_cast<uint32_t>(prefab->nodes.size());
+        prefab->nodes.push_back(node);
+        prefab->parents.push_back(parentIndex);
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+        {
+            stack.push_back({it->get(), index});
+        }
+    }
+
+    float nodeMin[2], nodeMax[2];
+    root->GetWorldBounds(prefab->boundsMin, prefab->boundsMax);
+    for (Node *node : prefab->nodes)
+    {
+        node->GetWorldBounds(nodeMin, nodeMax);
+        prefab->boundsMin[0] = std::min(prefab->boundsMin[0], nodeMin[0]);
+        prefab->boundsMin[1] = std::min(prefab->boundsMin[1], nodeMin[1]);
+        prefab->boundsMax[0] = std::max(prefab->boundsMax[0], nodeMax[0]);
+        prefab->boundsMax[1] = std::max(prefab->boundsMax[1], nodeMax[1]);
+    }
+    return prefab;
+}
+
+std::shared_ptr<Node> Prefab::CloneTree(const Node *source)
+{
+    std::shared_ptr<Node> root = CloneNode(source);
+    if (!root)
+        return nullptr;
+
+    // Walk both trees together, children are attached directly since the copy isn't in a scene yet
+    std::vector<std::pair<const Node *, Node *>> stack = {{source, root.get()}};
+    while (!stack.empty())
+    {
+        const Node *original = stack.back().first;
+        Node *copy = stack.back().second;
+        stack.pop_back();
+
+        copy->children.reserve(original->children.size());
+        for (const auto &child : original->children)
+        {
+            std::shared_ptr<Node> childCopy = CloneNode(child.get());
+            if (!childCopy)
+                continue;
+
+            childCopy->parent = copy;
+            copy->children.push_back(childCopy);
+            stack.push_back({child.get(), childCopy.get()});
+        }
+    }
+
+    root->MarkTransformDirty();
+    return root;
+}
+
+std::shared_ptr<Node> Prefab::CloneNode(const Node *source)
+{
+    // An instance needs its prefab to be constructed, its overrides come with CopyProperties
+    std::shared_ptr<Node> clone;
+    if (const PrefabInstance *instance = dynamic_cast<const PrefabInstance *>(source))
+        clone = std::make_shared<PrefabInstance>(source->name, instance->GetPrefab());
+    else
+        clone = SceneFile::CreateNode(SceneFile::GetNodeClass(source), source->name, source->type);
+    if (!clone)
+        return nullptr;
+
+    clone->expanded = source->expanded;
+    clone->CopyProperties(*source);
+    return clone;
+}
+
+void Prefab::CollectPrefabs(const Node *root, std::vector<const Prefab *> &outPrefabs)
+{
+    std::vector<const Node *> stack = {root};
+    while (!stack.empty())
+    {
+        const Node *node = stack.back();
+        stack.pop_back();
+
+        const PrefabInstance *instance = dynamic_cast<const PrefabInstance *>(node);
+        if (instance && instance->GetPrefab())
+        {
+            AddPrefab(instance->GetPrefab().get(), outPrefabs);
+        }
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+}
+
+const StringAtom &Prefab::GetName() const
+{
+    return root->name;
+}
+
+const std::shared_ptr<Node> &Prefab::GetRoot() const
+{
+    return root;
+}
+
+const std::vector<Node *> &Prefab::GetNodes() const
+{
+    return nodes;
+}
+
+const std::vector<uint32_t> &Prefab::GetParents() const
+{
+    return parents;
+}
+
+void Prefab::GetLocalBounds(float outMin[2], float outMax[2]) const
+{
+    outMin[0] = boundsMin[0];
+    outMin[1] = boundsMin[1];
+    outMax[0] = boundsMax[0];
+    outMax[1] = boundsMax[1];
+}
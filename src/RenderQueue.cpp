@@ -0,0 +1,203 @@
+#include "RenderQueue.h"
+#include <cstring>
+
+namespace
+{
+    // Radix sort digit size. 11 bits gives 6 passes over a 64-bit key with
+    // histograms small enough (6 x 2048 counters) to stay in L1/L2.
+    constexpr int RadixBits = 11;
+    constexpr int RadixBuckets = 1 << RadixBits;
+    constexpr int RadixPasses = (64 + RadixBits - 1) / RadixBits;
+
+    // Map a float to an unsigned integer with the same ordering
+    uint32_t OrderedFloatBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    // Keep the most significant bits of the ordered depth
+    uint64_t QuantizeDepth(float depth, int bits)
+    {
+        return static_cast<uint64_t>(OrderedFloatBits(depth) >> (32 - bits));
+    }
+
+    // Bias a signed z-index so that negative values sort first
+    uint64_t BiasZIndex(int16_t zIndex)
+    {
+        return static_cast<uint64_t>(static_cast<uint16_t>(zIndex) ^ 0x8000u);
+    }
+}
+
+RenderQueue::RenderQueue(SortMode mode) : sortMode(mode)
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+    // Nothing to clean up
+}
+
+void RenderQueue::Clear()
+{
+    // Keep the capacity so next frame's submissions don't allocate
+    items.clear();
+    currentOrigin = NoOrigin;
+}
+
+void RenderQueue::Reserve(size_t count)
+{
+    items.reserve(count);
+    scratch.reserve(count);
+}
+
+void RenderQueue::Submit(const DrawState &state, Node *node)
+{
+    items.push_back({MakeKey(state), node, currentOrigin});
+}
+
+void RenderQueue::Submit(uint64_t sortKey, Node *node)
+{
+    items.push_back({sortKey, node, currentOrigin});
+}
+
+void RenderQueue::SetOrigin(uint32_t origin)
+{
+    currentOrigin = origin;
+}
+
+void RenderQueue::Sort()
+{
+    const size_t count = items.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    // Only radix over the bit range that actually differs between keys.
+    // Typical frames share the layer, pipeline or low depth bits, which
+    // removes whole passes.
+    uint64_t differingBits = 0;
+    const uint64_t firstKey = items[0].sortKey;
+    for (const RenderItem &item : items)
+    {
+        differingBits |= item.sortKey ^ firstKey;
+    }
+    if (differingBits == 0)
+    {
+        return;
+    }
+
+    int lowestBit = 0;
+    while (!((differingBits >> lowestBit) & 1u))
+    {
+        lowestBit++;
+    }
+    int highestBit = 63;
+    while (!((differingBits >> highestBit) & 1u))
+    {
+        highestBit--;
+    }
+    const int passCount = (highestBit - lowestBit + RadixBits) / RadixBits;
+
+    // Build all digit histograms in a single read over the keys
+    static thread_local uint32_t histograms[RadixPasses][RadixBuckets];
+    std::memset(histograms, 0, sizeof(histograms[0]) * passCount);
+    for (const RenderItem &item : items)
+    {
+        uint64_t key = item.sortKey >> lowestBit;
+        for (int pass = 0; pass < passCount; pass++)
+        {
+            histograms[pass][(key >> (pass * RadixBits)) & (RadixBuckets - 1)]++;
+        }
+    }
+
+    scratch.resize(count);
+    RenderItem *source = items.data();
+    RenderItem *destination = scratch.data();
+
+    for (int pass = 0; pass < passCount; pass++)
+    {
+        uint32_t *histogram = histograms[pass];
+        const int shift = lowestBit + pass * RadixBits;
+
+        // Skip digits shared by every key
+        const uint32_t firstDigit = static_cast<uint32_t>((source[0].sortKey >> shift) & (RadixBuckets - 1));
+        if (histogram[firstDigit] == count)
+        {
+            continue;
+        }
+
+        // Exclusive prefix sum turns counts into output offsets
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < RadixBuckets; bucket++)
+        {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        // Stable scatter into the other buffer
+        for (size_t i = 0; i < count; i++)
+        {
+            const RenderItem &item = source[i];
+            destination[histogram[(item.sortKey >> shift) & (RadixBuckets - 1)]++] = item;
+        }
+
+        RenderItem *swap = source;
+        source = destination;
+        destination = swap;
+    }
+
+    // An odd number of scatter passes leaves the result in the scratch buffer
+    if (source != items.data())
+    {
+        items.swap(scratch);
+    }
+}
+
+const std::vector<RenderItem> &RenderQueue::GetItems() const
+{
+    return items;
+}
+
+size_t RenderQueue::GetSize() const
+{
+    return items.size();
+}
+
+RenderQueue::SortMode RenderQueue::GetSortMode() const
+{
+    return sortMode;
+}
+
+void RenderQueue::SetSortMode(SortMode mode)
+{
+    sortMode = mode;
+}
+
+uint64_t RenderQueue::MakeKey(const DrawState &state) const
+{
+    return sortMode == SortMode::Opaque ? MakeOpaqueKey(state) : MakeTransparentKey(state);
+}
+
+uint64_t RenderQueue::MakeOpaqueKey(const DrawState &state)
+{
+    // layer:8 | zIndex:16 | pipeline:8 | texture:16 | depth:16
+    return (static_cast<uint64_t>(state.layer) << 56) |
+           (BiasZIndex(state.zIndex) << 40) |
+           (static_cast<uint64_t>(state.pipeline) << 32) |
+           (static_cast<uint64_t>(state.texture) << 16) |
+           QuantizeDepth(state.depth, 16);
+}
+
+uint64_t RenderQueue::MakeTransparentKey(const DrawState &state)
+{
+    // layer:8 | zIndex:16 | depth:20 | pipeline:4 | texture:16
+    return (static_cast<uint64_t>(state.layer) << 56) |
+           (BiasZIndex(state.zIndex) << 40) |
+           (QuantizeDepth(state.depth, 20) << 20) |
+           (static_cast<uint64_t>(state.pipeline & (TransparentPipelineCount - 1)) << 16) |
+           static_cast<uint64_t>(state.texture);
+}
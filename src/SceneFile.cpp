@@ -0,0 +1,636 @@
+#include "SceneFile.h"
+#include "MappedFile.h"
+#include "../nodes/Node2D/Node2D.h"
+#include "../nodes/Sprite/Sprite.h"
+#include "../nodes/Camera2D/Camera2D.h"
+#include "../nodes/Camera3D/Camera3D.h"
+#include "../nodes/Light2D/Light2D.h"
+#include "../nodes/Label/Label.h"
+#include "../nodes/PrefabInstance/PrefabInstance.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    const char SceneMagic[8] = {'E', 'G', 'E', 'S', 'C', 'E', 'N', 'E'};
+
+    // Every section starts on this boundary so the records inside can be read in place
+    constexpr uint64_t SectionAlignment = 16;
+
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static_assert(sizeof(Node::Transform) == sizeof(float) * 9, "Node::Transform is copied as nine floats");
+    static_assert(sizeof(SceneFile::Header) % SectionAlignment == 0, "Header must keep the node table aligned");
+    static_assert(sizeof(SceneFile::NodeRecord) % 8 == 0, "Node records must stay 8-byte aligned");
+    static_assert(sizeof(SceneFile::OverrideRecord) % 8 == 0 && sizeof(SceneFile::PrefabRecord) % 8 == 0, "Lists must stay 8-byte aligned");
+
+    // The record holds the name, transform and cache flag, every other property goes to the property list
+    bool IsStoredInRecord(NodeProperty property)
+    {
+        switch (property)
+        {
+        case NodeProperty::Name:
+        case NodeProperty::Position:
+        case NodeProperty::Rotation:
+        case NodeProperty::Scale:
+        case NodeProperty::CacheAsBitmap:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Builds the sections of a scene file in memory
+    class SceneWriter
+    {
+    public:
+        SceneFile::StringRef AddString(const std::string &value)
+        {
+            // Texture and font paths repeat across many nodes, each is stored once
+            auto it = stringOffsets.find(value);
+            if (it == stringOffsets.end())
+            {
+                it = stringOffsets.emplace(value, static_cast<uint32_t>(strings.size())).first;
+                strings.insert(strings.end(), value.begin(), value.end());
+                strings.push_back('\0');
+            }
+            return {it->second, static_cast<uint32_t>(value.size())};
+        }
+
+        SceneFile::StringRef AddString(const StringAtom &value)
+        {
+            // Interned names are matched by id instead of by text
+            auto it = atomOffsets.find(value);
+            if (it == atomOffsets.end())
+            {
+                it = atomOffsets.emplace(value, static_cast<uint32_t>(strings.size())).first;
+                strings.insert(strings.end(), value.c_str(), value.c_str() + value.GetLength() + 1);
+            }
+            return {it->second, static_cast<uint32_t>(value.GetLength())};
+        }
+
+        // Values share the string table, so a texture path or colour used by many nodes is stored once
+        SceneFile::StringRef AddValue(const uint8_t *value, size_t size)
+        {
+            return AddString(std::string(reinterpret_cast<const char *>(value), size));
+        }
+
+        // Lists are padded so the next one stays aligned, returns the list's offset in the payload section
+        uint32_t AddPayload(const void *data, size_t size)
+        {
+            const uint32_t offset = static_cast<uint32_t>(payloads.size());
+            payloads.resize(payloads.size() + AlignUp(size, 8), 0);
+            if (size > 0)
+                std::memcpy(payloads.data() + offset, data, size);
+            return offset;
+        }
+
+        // Write the tree under root depth-first, after the records already written
+        void AddTree(const Node *root)
+        {
+            // Every parent is written before its children and siblings keep their order
+            std::vector<std::pair<const Node *, uint32_t>> stack;
+            stack.push_back({root, SceneFile::NoParent});
+            while (!stack.empty())
+            {
+                const Node *node = stack.back().first;
+                const uint32_t parentIndex = stack.back().second;
+                stack.pop_back();
+
+                SceneFile::NodeRecord record = {};
+                record.parent = parentIndex;
+                record.childCount = static_cast<uint32_t>(node->children.size());
+                record.type = static_cast<uint16_t>(node->type);
+                record.name = AddString(node->name);
+                std::memcpy(record.position, &node->transform, sizeof(Node::Transform));
+                if (node->expanded)
+                    record.flags |= SceneFile::FlagExpanded;
+                if (node->IsCacheAsBitmap())
+                    record.flags |= SceneFile::FlagCacheAsBitmap;
+
+                const SceneFile::NodeClass nodeClass = SceneFile::GetNodeClass(node);
+                record.nodeClass = static_cast<uint16_t>(nodeClass);
+
+                // Everything the record doesn't hold, straight from the class's reflected fields
+                properties.clear();
+                for (const PropertyInfo &info : node->GetPropertyInfos())
+                {
+                    if (IsStoredInRecord(info.property))
+                        continue;
+
+                    value.clear();
+                    node->GetProperty(info.property, value);
+                    properties.push_back({static_cast<uint32_t>(info.property), AddValue(value.data(), value.size())});
+                }
+                record.payloadSize = static_cast<uint32_t>(properties.size() * sizeof(SceneFile::PropertyRecord));
+                record.payloadOffset = AddPayload(properties.data(), record.payloadSize);
+
+                // An instance refers to its prefab, only the values it changes are written
+                if (nodeClass == SceneFile::NodeClass::PrefabInstance)
+                {
+                    const PrefabInstance *instance = static_cast<const PrefabInstance *>(node);
+                    record.prefab = prefabIndices.at(instance->GetPrefab().get());
+                    overrides.clear();
+                    for (const PrefabOverride &entry : instance->GetOverrides())
+                    {
+                        overrides.push_back({entry.nodeIndex, static_cast<uint32_t>(entry.property), AddValue(instance->GetOverrideValue(entry), entry.size)});
+                    }
+                    record.overrideCount = static_cast<uint32_t>(overrides.size());
+                    record.overrideOffset = AddPayload(overrides.data(), overrides.size() * sizeof(SceneFile::OverrideRecord));
+                }
+
+                const uint32_t index = static_cast<uint32_t>(records.size());
+                records.push_back(record);
+
+                // Pushed in reverse so the first child is written first
+                for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+                {
+                    stack.push_back({it->get(), index});
+                }
+            }
+        }
+
+        std::vector<SceneFile::NodeRecord> records;
+        std::vector<uint8_t> payloads;
+        std::vector<char> strings;
+        std::unordered_map<const Prefab *, uint32_t> prefabIndices;
+
+    private:
+        std::vector<SceneFile::PropertyRecord> properties;
+        std::vector<SceneFile::OverrideRecord> overrides;
+        std::vector<uint8_t> value;
+        std::unordered_map<std::string, uint32_t> stringOffsets;
+        std::unordered_map<StringAtom, uint32_t> atomOffsets;
+    };
+
+    // Views into a mapped scene file, bounds checked before any record is trusted
+    struct SceneView
+    {
+        const uint8_t *payloads;
+        uint64_t payloadSize;
+        const char *strings;
+        uint64_t stringTableSize;
+
+        bool GetString(const SceneFile::StringRef &ref, std::string &outValue) const
+        {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > stringTableSize)
+                return false;
+
+            outValue.assign(strings + ref.offset, ref.length);
+            return true;
+        }
+
+        // Names repeat across loads, so they are looked up in the atom table without a temporary string
+        bool GetAtom(const SceneFile::StringRef &ref, StringAtom &outValue) const
+        {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > stringTableSize)
+                return false;
+
+            outValue = std::string_view(strings + ref.offset, ref.length);
+            return true;
+        }
+
+        bool GetValue(const SceneFile::StringRef &ref, const uint8_t *&outValue) const
+        {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > stringTableSize)
+                return false;
+
+            outValue = reinterpret_cast<const uint8_t *>(strings + ref.offset);
+            return true;
+        }
+
+        const SceneFile::PropertyRecord *GetPropertyList(const SceneFile::NodeRecord &record, uint32_t &outCount) const
+        {
+            if (record.payloadSize % sizeof(SceneFile::PropertyRecord) != 0 || record.payloadOffset % 8 != 0 ||
+                static_cast<uint64_t>(record.payloadOffset) + record.payloadSize > payloadSize)
+                return nullptr;
+
+            outCount = record.payloadSize / sizeof(SceneFile::PropertyRecord);
+            return reinterpret_cast<const SceneFile::PropertyRecord *>(payloads + record.payloadOffset);
+        }
+
+        const SceneFile::OverrideRecord *GetOverrideList(const SceneFile::NodeRecord &record) const
+        {
+            if (record.overrideOffset % 8 != 0 ||
+                static_cast<uint64_t>(record.overrideOffset) + static_cast<uint64_t>(record.overrideCount) * sizeof(SceneFile::OverrideRecord) > payloadSize)
+                return nullptr;
+
+            return reinterpret_cast<const SceneFile::OverrideRecord *>(payloads + record.overrideOffset);
+        }
+    };
+
+    // A tree's root comes first and every parent before its children, instances refer to earlier prefabs only
+    bool IsValidTree(const SceneFile::NodeRecord *records, uint32_t first, uint32_t count, uint32_t prefabLimit, uint32_t &outBadIndex)
+    {
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            const SceneFile::NodeRecord &record = records[i];
+            const bool validParent = i == first ? record.parent == SceneFile::NoParent : record.parent >= first && record.parent < i;
+            const bool validPrefab = record.nodeClass != static_cast<uint16_t>(SceneFile::NodeClass::PrefabInstance) || record.prefab < prefabLimit;
+            if (!validParent || !validPrefab || record.type >= static_cast<uint16_t>(NodeType::Count) || record.childCount > count)
+            {
+                outBadIndex = i;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void WritePadding(std::ofstream &file, uint64_t count)
+    {
+        static const char zeros[SectionAlignment] = {};
+        file.write(zeros, static_cast<std::streamsize>(count));
+    }
+
+    // Construct a node from its record, null if the record doesn't describe a valid node
+    std::shared_ptr<Node> CreateNodeFromRecord(const SceneFile::NodeRecord &record, const SceneView &view,
+                                               const std::vector<std::shared_ptr<const Prefab>> &prefabs)
+    {
+        StringAtom name;
+        if (!view.GetAtom(record.name, name))
+            return nullptr;
+
+        // The prefab index was checked against the prefabs built before this record when the file was opened
+        const SceneFile::NodeClass nodeClass = static_cast<SceneFile::NodeClass>(record.nodeClass);
+        std::shared_ptr<Node> node;
+        if (nodeClass == SceneFile::NodeClass::PrefabInstance)
+            node = std::make_shared<PrefabInstance>(name, prefabs[record.prefab]);
+        else
+            node = SceneFile::CreateNode(nodeClass, name, static_cast<NodeType>(record.type));
+        if (!node)
+            return nullptr;
+
+        // Properties a newer build wrote and this one doesn't know are skipped
+        uint32_t propertyCount = 0;
+        const SceneFile::PropertyRecord *properties = view.GetPropertyList(record, propertyCount);
+        if (!properties)
+            return nullptr;
+
+        for (uint32_t i = 0; i < propertyCount; i++)
+        {
+            const uint8_t *value;
+            if (!view.GetValue(properties[i].value, value))
+                return nullptr;
+
+            node->SetProperty(static_cast<NodeProperty>(properties[i].property), value, properties[i].value.length);
+        }
+
+        // The transform is laid out exactly like the record's, copy it in one go
+        std::memcpy(&node->transform, record.position, sizeof(Node::Transform));
+        node->expanded = (record.flags & SceneFile::FlagExpanded) != 0;
+        if (record.flags & SceneFile::FlagCacheAsBitmap)
+        {
+            node->SetCacheAsBitmap(true);
+        }
+
+        if (nodeClass == SceneFile::NodeClass::PrefabInstance)
+        {
+            const SceneFile::OverrideRecord *overrides = view.GetOverrideList(record);
+            if (!overrides)
+                return nullptr;
+
+            // Like properties, overrides of properties this build doesn't know are skipped
+            PrefabInstance *instance = static_cast<PrefabInstance *>(node.get());
+            for (uint32_t i = 0; i < record.overrideCount; i++)
+            {
+                const uint8_t *value;
+                if (!view.GetValue(overrides[i].value, value))
+                    return nullptr;
+
+                instance->SetOverride(overrides[i].nodeIndex, static_cast<NodeProperty>(overrides[i].property), value, overrides[i].value.length);
+            }
+        }
+        return node;
+    }
+}
+
+// Indexed by NodeClass
+static const char *const NodeClassNames[] = {"Node", "Node2D", "Sprite", "Light2D", "Label", "Camera2D", "Camera3D", "PrefabInstance"};
+static_assert(sizeof(NodeClassNames) / sizeof(NodeClassNames[0]) == static_cast<size_t>(SceneFile::NodeClass::Count), "Every node class needs a name");
+
+const char *SceneFile::GetNodeClassName(NodeClass nodeClass)
+{
+    return nodeClass < NodeClass::Count ? NodeClassNames[static_cast<size_t>(nodeClass)] : "";
+}
+
+bool SceneFile::FindNodeClass(const char *name, size_t length, NodeClass &outClass)
+{
+    for (size_t i = 0; i < static_cast<size_t>(NodeClass::Count); i++)
+    {
+        if (std::strlen(NodeClassNames[i]) == length && std::memcmp(NodeClassNames[i], name, length) == 0)
+        {
+            outClass = static_cast<NodeClass>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Construct a node of the given class with its default properties
+std::shared_ptr<Node> SceneFile::CreateNode(NodeClass nodeClass, const StringAtom &name, NodeType type)
+{
+    switch (nodeClass)
+    {
+    case NodeClass::Node:
+        return std::make_shared<Node>(name, type);
+    case NodeClass::Node2D:
+        return std::make_shared<Node2D>(name, type);
+    case NodeClass::Sprite:
+        return std::make_shared<Sprite>(name, type);
+    case NodeClass::Light2D:
+        return std::make_shared<Light2D>(name);
+    case NodeClass::Label:
+        return std::make_shared<Label>(name);
+    case NodeClass::Camera2D:
+        return std::make_shared<Camera2D>(name);
+    case NodeClass::Camera3D:
+        return std::make_shared<Camera3D>(name);
+    case NodeClass::PrefabInstance:
+        // Needs its prefab, which the class alone doesn't name
+        return nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+SceneFile::NodeClass SceneFile::GetNodeClass(const Node *node)
+{
+    // Most derived classes first, an instance without a prefab is saved as the plain node it is
+    if (const PrefabInstance *instance = dynamic_cast<const PrefabInstance *>(node))
+        return instance->GetPrefab() ? NodeClass::PrefabInstance : NodeClass::Node2D;
+    if (dynamic_cast<const Label *>(node))
+        return NodeClass::Label;
+    if (dynamic_cast<const Sprite *>(node))
+        return NodeClass::Sprite;
+    if (dynamic_cast<const Light2D *>(node))
+        return NodeClass::Light2D;
+    if (dynamic_cast<const Camera2D *>(node))
+        return NodeClass::Camera2D;
+    if (dynamic_cast<const Camera3D *>(node))
+        return NodeClass::Camera3D;
+    if (dynamic_cast<const Node2D *>(node))
+        return NodeClass::Node2D;
+    return NodeClass::Node;
+}
+
+bool SceneFile::Save(const Node *root, const std::string &path)
+{
+    if (!root)
+        return false;
+
+    // Every prefab the scene instances, each after the prefabs its own template instances
+    std::vector<const Prefab *> prefabs;
+    Prefab::CollectPrefabs(root, prefabs);
+
+    SceneWriter writer;
+    for (uint32_t i = 0; i < prefabs.size(); i++)
+    {
+        writer.prefabIndices.emplace(prefabs[i], i);
+    }
+
+    // The scene's tree comes first, then each prefab's template
+    writer.AddTree(root);
+    const uint32_t sceneNodeCount = static_cast<uint32_t>(writer.records.size());
+    std::vector<PrefabRecord> prefabRecords;
+    for (const Prefab *prefab : prefabs)
+    {
+        const uint32_t firstNode = static_cast<uint32_t>(writer.records.size());
+        writer.AddTree(prefab->GetRoot().get());
+        prefabRecords.push_back({firstNode, static_cast<uint32_t>(writer.records.size()) - firstNode});
+    }
+
+    // Lay the sections out one after the other
+    Header header = {};
+    std::memcpy(header.magic, SceneMagic, sizeof(header.magic));
+    header.version = Version;
+    header.nodeCount = sceneNodeCount;
+    header.prefabNodeCount = static_cast<uint32_t>(writer.records.size()) - sceneNodeCount;
+    header.nodeTableOffset = sizeof(Header);
+    const uint64_t nodeTableSize = writer.records.size() * sizeof(NodeRecord);
+    header.payloadOffset = AlignUp(header.nodeTableOffset + nodeTableSize, SectionAlignment);
+    header.payloadSize = writer.payloads.size();
+    header.prefabTableOffset = AlignUp(header.payloadOffset + header.payloadSize, SectionAlignment);
+    header.prefabCount = static_cast<uint32_t>(prefabRecords.size());
+    const uint64_t prefabTableSize = prefabRecords.size() * sizeof(PrefabRecord);
+    header.stringTableOffset = AlignUp(header.prefabTableOffset + prefabTableSize, SectionAlignment);
+    header.stringTableSize = writer.strings.size();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "Failed to open scene file for writing: " << path << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char *>(writer.records.data()), static_cast<std::streamsize>(nodeTableSize));
+    WritePadding(file, header.payloadOffset - (header.nodeTableOffset + nodeTableSize));
+    file.write(reinterpret_cast<const char *>(writer.payloads.data()), static_cast<std::streamsize>(header.payloadSize));
+    WritePadding(file, header.prefabTableOffset - (header.payloadOffset + header.payloadSize));
+    file.write(reinterpret_cast<const char *>(prefabRecords.data()), static_cast<std::streamsize>(prefabTableSize));
+    WritePadding(file, header.stringTableOffset - (header.prefabTableOffset + prefabTableSize));
+    file.write(writer.strings.data(), static_cast<std::streamsize>(header.stringTableSize));
+
+    if (!file)
+    {
+        std::cerr << "Failed to write scene file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<Node> SceneFile::Load(const std::string &path)
+{
+    MappedFile mapping;
+    if (!mapping.Open(path))
+        return nullptr;
+
+    // Children are attached directly, the whole tree is queued for one transform update at the end
+    Loader loader;
+    if (!loader.Open(mapping.GetData(), mapping.GetSize(), path) || !loader.Build(loader.GetNodeCount()))
+        return nullptr;
+
+    loader.GetRoot()->MarkTransformDirty();
+    return loader.GetRoot();
+}
+
+bool SceneFile::Loader::Open(const uint8_t *data, uint64_t fileSize, const std::string &path)
+{
+    this->path = path;
+    if (fileSize < sizeof(Header))
+    {
+        std::cerr << "Scene file is truncated: " << path << std::endl;
+        return false;
+    }
+
+    const Header &header = *reinterpret_cast<const Header *>(data);
+    if (std::memcmp(header.magic, SceneMagic, sizeof(header.magic)) != 0 || header.version != Version)
+    {
+        std::cerr << "Not a supported scene file: " << path << std::endl;
+        return false;
+    }
+
+    // Every section must lie inside the file and be aligned for in-place reads
+    const uint64_t recordCount = static_cast<uint64_t>(header.nodeCount) + header.prefabNodeCount;
+    const uint64_t nodeTableSize = recordCount * sizeof(NodeRecord);
+    const uint64_t prefabTableSize = static_cast<uint64_t>(header.prefabCount) * sizeof(PrefabRecord);
+    if (header.nodeCount == 0 ||
+        header.nodeTableOffset % SectionAlignment != 0 || header.nodeTableOffset > fileSize || nodeTableSize > fileSize - header.nodeTableOffset ||
+        header.payloadOffset % SectionAlignment != 0 || header.payloadOffset > fileSize || header.payloadSize > fileSize - header.payloadOffset ||
+        header.prefabTableOffset % SectionAlignment != 0 || header.prefabTableOffset > fileSize || prefabTableSize > fileSize - header.prefabTableOffset ||
+        header.stringTableOffset > fileSize || header.stringTableSize > fileSize - header.stringTableOffset)
+    {
+        std::cerr << "Scene file is corrupt: " << path << std::endl;
+        return false;
+    }
+
+    // The trees' shape is checked up front so building can't fail half way on a bad parent
+    records = reinterpret_cast<const NodeRecord *>(data + header.nodeTableOffset);
+    prefabRecords = reinterpret_cast<const PrefabRecord *>(data + header.prefabTableOffset);
+    uint32_t badIndex;
+    if (!IsValidTree(records, 0, header.nodeCount, header.prefabCount, badIndex))
+    {
+        std::cerr << "Scene file has an invalid node record at index " << badIndex << ": " << path << std::endl;
+        return false;
+    }
+    for (uint32_t i = 0; i < header.prefabCount; i++)
+    {
+        const PrefabRecord &prefab = prefabRecords[i];
+        if (prefab.firstNode < header.nodeCount || prefab.firstNode >= recordCount || prefab.nodeCount == 0 || prefab.nodeCount > recordCount - prefab.firstNode)
+        {
+            std::cerr << "Scene file has an invalid prefab record at index " << i << ": " << path << std::endl;
+            return false;
+        }
+        if (!IsValidTree(records, prefab.firstNode, prefab.nodeCount, i, badIndex))
+        {
+            std::cerr << "Scene file has an invalid node record at index " << badIndex << ": " << path << std::endl;
+            return false;
+        }
+    }
+
+    prefabCount = header.prefabCount;
+    prefabs.clear();
+    nodeCount = header.nodeCount;
+    builtCount = 0;
+    payloads = data + header.payloadOffset;
+    payloadSize = header.payloadSize;
+    strings = reinterpret_cast<const char *>(data + header.stringTableOffset);
+    stringTableSize = header.stringTableSize;
+    nodes.assign(nodeCount, nullptr);
+    root.reset();
+    return true;
+}
+
+bool SceneFile::Loader::Build(uint32_t maxNodes)
+{
+    SceneView view;
+    view.payloads = payloads;
+    view.payloadSize = payloadSize;
+    view.strings = strings;
+    view.stringTableSize = stringTableSize;
+
+    // Instances refer to the prefabs, so they are built before the first scene node
+    if (prefabs.size() < prefabCount && !BuildPrefabs())
+        return false;
+
+    const uint32_t batchStart = builtCount;
+    const uint32_t batchEnd = builtCount + std::min(maxNodes, nodeCount - builtCount);
+    for (uint32_t i = batchStart; i < batchEnd; i++)
+    {
+        const NodeRecord &record = records[i];
+        std::shared_ptr<Node> node = CreateNodeFromRecord(record, view, prefabs);
+        if (!node)
+        {
+            std::cerr << "Scene file has an invalid node record at index " << i << ": " << path << std::endl;
+            return false;
+        }
+        node->children.reserve(record.childCount);
+        nodes[i] = node.get();
+
+        if (i == 0)
+        {
+            root = node;
+        }
+        else if (record.parent < batchStart)
+        {
+            // The parent may already be in a live tree, where the new node has to be announced
+            nodes[record.parent]->AddChild(std::move(node));
+        }
+        else
+        {
+            // Built in this batch, so it reaches the tree together with its batch's topmost node
+            Node *parent = nodes[record.parent];
+            node->parent = parent;
+            parent->children.push_back(std::move(node));
+        }
+    }
+
+    builtCount = batchEnd;
+    return true;
+}
+
+bool SceneFile::Loader::BuildPrefabs()
+{
+    SceneView view;
+    view.payloads = payloads;
+    view.payloadSize = payloadSize;
+    view.strings = strings;
+    view.stringTableSize = stringTableSize;
+
+    // Each template is built in one go and attached directly, it never becomes part of the scene
+    std::vector<Node *> templateNodes;
+    for (uint32_t prefabIndex = 0; prefabIndex < prefabCount; prefabIndex++)
+    {
+        const PrefabRecord &prefab = prefabRecords[prefabIndex];
+        templateNodes.assign(prefab.nodeCount, nullptr);
+        std::shared_ptr<Node> templateRoot;
+        for (uint32_t i = 0; i < prefab.nodeCount; i++)
+        {
+            const NodeRecord &record = records[prefab.firstNode + i];
+            std::shared_ptr<Node> node = CreateNodeFromRecord(record, view, prefabs);
+            if (!node)
+            {
+                std::cerr << "Scene file has an invalid node record at index " << prefab.firstNode + i << ": " << path << std::endl;
+                return false;
+            }
+            node->children.reserve(record.childCount);
+            templateNodes[i] = node.get();
+
+            if (i == 0)
+            {
+                templateRoot = std::move(node);
+            }
+            else
+            {
+                Node *parent = templateNodes[record.parent - prefab.firstNode];
+                node->parent = parent;
+                parent->children.push_back(std::move(node));
+            }
+        }
+        prefabs.push_back(Prefab::Adopt(std::move(templateRoot)));
+    }
+    return true;
+}
+
+bool SceneFile::Loader::IsComplete() const
+{
+    return nodeCount > 0 && builtCount == nodeCount;
+}
+
+const std::shared_ptr<Node> &SceneFile::Loader::GetRoot() const
+{
+    return root;
+}
+
+uint32_t SceneFile::Loader::GetNodeCount() const
+{
+    return nodeCount;
+}
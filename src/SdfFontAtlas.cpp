@@ -0,0 +1,279 @@
+#include "SdfFontAtlas.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+// ImGui compiles its copy of stb_truetype as static, so this translation unit gets its own
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imstb_truetype.h"
+
+namespace
+{
+    // Atlas width in pixels, height grows to fit the glyphs
+    constexpr int AtlasWidth = 512;
+
+    // Distance field value on the glyph outline and the falloff per pixel
+    constexpr unsigned char OnEdgeValue = 128;
+    constexpr float PixelDistanceScale = 128.0f / SdfFontAtlas::Padding;
+
+    struct CachedAtlas
+    {
+        std::weak_ptr<SdfFontAtlas> atlas;
+        bool failed = false; // Load failed, every label using the font would otherwise read it again
+    };
+
+    std::map<std::string, CachedAtlas> &LoadedAtlases()
+    {
+        static std::map<std::string, CachedAtlas> atlases;
+        return atlases;
+    }
+}
+
+SdfFontAtlas::SdfFontAtlas()
+{
+}
+
+SdfFontAtlas::~SdfFontAtlas()
+{
+    // Nothing to clean up
+}
+
+std::shared_ptr<SdfFontAtlas> SdfFontAtlas::Get(const std::string &fontPath)
+{
+    CachedAtlas &cached = LoadedAtlases()[fontPath];
+    if (cached.failed)
+    {
+        return nullptr;
+    }
+    if (std::shared_ptr<SdfFontAtlas> atlas = cached.atlas.lock())
+    {
+        return atlas;
+    }
+
+    std::shared_ptr<SdfFontAtlas> atlas(new SdfFontAtlas());
+    if (!atlas->Load(fontPath))
+    {
+        cached.failed = true;
+        return nullptr;
+    }
+
+    // Atlas ids start at 1 so 0 stays "no texture"
+    static uint16_t nextAtlasId = 1;
+    atlas->atlasId = nextAtlasId++;
+    cached.atlas = atlas;
+    return atlas;
+}
+
+void SdfFontAtlas::ForgetFailure(const std::string &fontPath)
+{
+    auto it = LoadedAtlases().find(fontPath);
+    if (it != LoadedAtlases().end() && it->second.failed)
+    {
+        LoadedAtlases().erase(it);
+    }
+}
+
+bool SdfFontAtlas::Load(const std::string &fontPath)
+{
+    this->fontPath = fontPath;
+
+    std::ifstream file(fontPath, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Failed to open font file: " << fontPath << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> fontData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    stbtt_fontinfo fontInfo;
+    if (fontData.empty() || !stbtt_InitFont(&fontInfo, fontData.data(), stbtt_GetFontOffsetForIndex(fontData.data(), 0)))
+    {
+        std::cerr << "Failed to parse font file: " << fontPath << std::endl;
+        return false;
+    }
+
+    float scale = stbtt_ScaleForPixelHeight(&fontInfo, BasePixelHeight);
+    int fontAscent, fontDescent, fontLineGap;
+    stbtt_GetFontVMetrics(&fontInfo, &fontAscent, &fontDescent, &fontLineGap);
+    ascent = fontAscent * scale;
+    lineHeight = (fontAscent - fontDescent + fontLineGap) * scale;
+
+    // Rasterize every glyph's distance field
+    struct GlyphBitmap
+    {
+        unsigned char *data = nullptr;
+        int width = 0, height = 0;
+        int atlasX = 0, atlasY = 0;
+    };
+    GlyphBitmap bitmaps[LastCodepoint - FirstCodepoint + 1];
+
+    for (int codepoint = FirstCodepoint; codepoint <= LastCodepoint; codepoint++)
+    {
+        Glyph &glyph = glyphs[codepoint - FirstCodepoint];
+        GlyphBitmap &bitmap = bitmaps[codepoint - FirstCodepoint];
+
+        int advance, leftSideBearing;
+        stbtt_GetCodepointHMetrics(&fontInfo, codepoint, &advance, &leftSideBearing);
+        glyph.advance = advance * scale;
+
+        int offsetX = 0, offsetY = 0;
+        bitmap.data = stbtt_GetCodepointSDF(&fontInfo, scale, codepoint, Padding, OnEdgeValue, PixelDistanceScale,
+                                            &bitmap.width, &bitmap.height, &offsetX, &offsetY);
+        glyph.offsetX = static_cast<float>(offsetX);
+        glyph.offsetY = static_cast<float>(offsetY) + ascent;
+        glyph.width = static_cast<float>(bitmap.width);
+        glyph.height = static_cast<float>(bitmap.height);
+    }
+
+    // Shelf-pack the glyphs into rows
+    int penX = 0, penY = 0, rowHeight = 0;
+    for (GlyphBitmap &bitmap : bitmaps)
+    {
+        if (!bitmap.data)
+            continue;
+
+        if (penX + bitmap.width > AtlasWidth)
+        {
+            penX = 0;
+            penY += rowHeight;
+            rowHeight = 0;
+        }
+        bitmap.atlasX = penX;
+        bitmap.atlasY = penY;
+        penX += bitmap.width;
+        rowHeight = std::max(rowHeight, bitmap.height);
+    }
+
+    // Round the height up to a power of two for the GPU upload
+    width = AtlasWidth;
+    height = 1;
+    while (height < penY + rowHeight)
+    {
+        height <<= 1;
+    }
+    pixels.assign(static_cast<size_t>(width) * height, 0);
+
+    // Copy the distance fields in and compute texture coordinates
+    for (int index = 0; index <= LastCodepoint - FirstCodepoint; index++)
+    {
+        GlyphBitmap &bitmap = bitmaps[index];
+        if (!bitmap.data)
+            continue;
+
+        for (int row = 0; row < bitmap.height; row++)
+        {
+            std::memcpy(&pixels[static_cast<size_t>(bitmap.atlasY + row) * width + bitmap.atlasX],
+                        bitmap.data + static_cast<size_t>(row) * bitmap.width, bitmap.width);
+        }
+        stbtt_FreeSDF(bitmap.data, nullptr);
+
+        Glyph &glyph = glyphs[index];
+        glyph.u0 = static_cast<float>(bitmap.atlasX) / width;
+        glyph.v0 = static_cast<float>(bitmap.atlasY) / height;
+        glyph.u1 = static_cast<float>(bitmap.atlasX + bitmap.width) / width;
+        glyph.v1 = static_cast<float>(bitmap.atlasY + bitmap.height) / height;
+    }
+
+    // Precompute kerning so layout never touches the font data again
+    const int glyphCount = LastCodepoint - FirstCodepoint + 1;
+    kerning.assign(static_cast<size_t>(glyphCount) * glyphCount, 0.0f);
+    for (int left = 0; left < glyphCount; left++)
+    {
+        for (int right = 0; right < glyphCount; right++)
+        {
+            kerning[left * glyphCount + right] = stbtt_GetCodepointKernAdvance(&fontInfo, left + FirstCodepoint, right + FirstCodepoint) * scale;
+        }
+    }
+
+    return true;
+}
+
+void SdfFontAtlas::LayoutText(const std::string &text, float fontSize, std::vector<GlyphQuad> &outQuads,
+                              float outMin[2], float outMax[2]) const
+{
+    const int glyphCount = LastCodepoint - FirstCodepoint + 1;
+    const float scale = fontSize / BasePixelHeight;
+
+    outQuads.clear();
+    outMin[0] = outMin[1] = 0.0f;
+    outMax[0] = outMax[1] = 0.0f;
+
+    float penX = 0.0f, penY = 0.0f;
+    int previous = -1;
+    for (char character : text)
+    {
+        if (character == '\n')
+        {
+            penX = 0.0f;
+            penY += lineHeight;
+            previous = -1;
+            continue;
+        }
+
+        // Unsupported characters fall back to '?'
+        int codepoint = static_cast<unsigned char>(character);
+        if (codepoint < FirstCodepoint || codepoint > LastCodepoint)
+        {
+            codepoint = '?';
+        }
+        int index = codepoint - FirstCodepoint;
+
+        if (previous >= 0)
+        {
+            penX += kerning[previous * glyphCount + index];
+        }
+        previous = index;
+
+        const Glyph &glyph = glyphs[index];
+        if (glyph.width > 0.0f)
+        {
+            GlyphQuad quad;
+            quad.x0 = (penX + glyph.offsetX) * scale;
+            quad.y0 = (penY + glyph.offsetY) * scale;
+            quad.x1 = quad.x0 + glyph.width * scale;
+            quad.y1 = quad.y0 + glyph.height * scale;
+            quad.u0 = glyph.u0;
+            quad.v0 = glyph.v0;
+            quad.u1 = glyph.u1;
+            quad.v1 = glyph.v1;
+            outQuads.push_back(quad);
+        }
+
+        penX += glyph.advance;
+        outMax[0] = std::max(outMax[0], penX * scale);
+    }
+    outMax[1] = (penY + lineHeight) * scale;
+}
+
+const std::vector<uint8_t> &SdfFontAtlas::GetPixels() const
+{
+    return pixels;
+}
+
+int SdfFontAtlas::GetWidth() const
+{
+    return width;
+}
+
+int SdfFontAtlas::GetHeight() const
+{
+    return height;
+}
+
+uint16_t SdfFontAtlas::GetAtlasId() const
+{
+    return atlasId;
+}
+
+const std::string &SdfFontAtlas::GetFontPath() const
+{
+    return fontPath;
+}
+
+float SdfFontAtlas::GetLineHeight(float fontSize) const
+{
+    return lineHeight * fontSize / BasePixelHeight;
+}
@@ -0,0 +1,111 @@
+#include "SelectionSet.h"
+#include "NodeChangeBus.h"
+#include <algorithm>
+
+SelectionSet::SelectionSet()
+{
+    changeSubscription = NodeChangeBus::Subscribe(NodeChangeDestroyed,
+                                                  [this](const std::vector<NodeChangeEvent> &events)
+                                                  {
+                                                      for (const NodeChangeEvent &event : events)
+                                                      {
+                                                          if (event.changes & NodeChangeDestroyed)
+                                                          {
+                                                              Remove(event.instanceId);
+                                                          }
+                                                      }
+                                                  });
+}
+
+SelectionSet::~SelectionSet()
+{
+    NodeChangeBus::Unsubscribe(changeSubscription);
+}
+
+bool SelectionSet::Add(uint32_t id)
+{
+    if (id == 0 || Contains(id))
+        return false;
+
+    size_t word = id / 64;
+    if (word >= bits.size())
+    {
+        bits.resize(word + 1, 0);
+    }
+    bits[word] |= 1ull << (id % 64);
+    ids.push_back(id);
+    primary = id;
+    version++;
+    return true;
+}
+
+bool SelectionSet::Remove(uint32_t id)
+{
+    if (!Contains(id))
+        return false;
+
+    bits[id / 64] &= ~(1ull << (id % 64));
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+
+    // The primary falls back to the most recent remaining id
+    if (primary == id)
+    {
+        primary = ids.empty() ? 0 : ids.back();
+    }
+    version++;
+    return true;
+}
+
+void SelectionSet::Toggle(uint32_t id)
+{
+    if (!Remove(id))
+    {
+        Add(id);
+    }
+}
+
+void SelectionSet::Clear()
+{
+    if (ids.empty())
+        return;
+
+    // Only the words holding selected ids need clearing
+    for (uint32_t id : ids)
+    {
+        bits[id / 64] = 0;
+    }
+    ids.clear();
+    primary = 0;
+    version++;
+}
+
+bool SelectionSet::Contains(uint32_t id) const
+{
+    size_t word = id / 64;
+    return word < bits.size() && (bits[word] >> (id % 64)) & 1;
+}
+
+bool SelectionSet::IsEmpty() const
+{
+    return ids.empty();
+}
+
+size_t SelectionSet::GetSize() const
+{
+    return ids.size();
+}
+
+const std::vector<uint32_t> &SelectionSet::GetIds() const
+{
+    return ids;
+}
+
+uint32_t SelectionSet::GetPrimary() const
+{
+    return primary;
+}
+
+uint32_t SelectionSet::GetVersion() const
+{
+    return version;
+}
@@ -0,0 +1,208 @@
+#include "SpatialGrid2D.h"
+#include <cmath>
+
+SpatialGrid2D::SpatialGrid2D(float cellSize) : cellSize(cellSize), inverseCellSize(1.0f / cellSize)
+{
+}
+
+SpatialGrid2D::~SpatialGrid2D()
+{
+    // Nothing to clean up
+}
+
+uint64_t SpatialGrid2D::PackCell(int32_t cellX, int32_t cellY)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+}
+
+bool SpatialGrid2D::ComputeCellKey(const float boundsMin[2], const float boundsMax[2], uint64_t &outCellKey) const
+{
+    // Nodes that overhang more than half a cell go to the oversized list
+    float halfWidth = (boundsMax[0] - boundsMin[0]) * 0.5f;
+    float halfHeight = (boundsMax[1] - boundsMin[1]) * 0.5f;
+    if (halfWidth > cellSize * 0.5f || halfHeight > cellSize * 0.5f)
+    {
+        return false;
+    }
+
+    float centerX = (boundsMin[0] + boundsMax[0]) * 0.5f;
+    float centerY = (boundsMin[1] + boundsMax[1]) * 0.5f;
+    outCellKey = PackCell(static_cast<int32_t>(floorf(centerX * inverseCellSize)),
+                          static_cast<int32_t>(floorf(centerY * inverseCellSize)));
+    return true;
+}
+
+std::vector<uint32_t> &SpatialGrid2D::GetCellEntries(const Entry &entry)
+{
+    if (entry.oversized)
+    {
+        return oversizedEntries;
+    }
+    return cells[entry.cellKey];
+}
+
+void SpatialGrid2D::Link(uint32_t entryIndex, bool oversized, uint64_t cellKey)
+{
+    Entry &entry = entries[entryIndex];
+    entry.oversized = oversized;
+    entry.cellKey = cellKey;
+    std::vector<uint32_t> &cellEntries = GetCellEntries(entry);
+    entry.slotInCell = static_cast<uint32_t>(cellEntries.size());
+    cellEntries.push_back(entryIndex);
+}
+
+void SpatialGrid2D::Unlink(uint32_t entryIndex)
+{
+    Entry &entry = entries[entryIndex];
+    std::vector<uint32_t> &cellEntries = GetCellEntries(entry);
+
+    // Swap-remove from the cell and patch the moved entry's slot
+    uint32_t movedIndex = cellEntries.back();
+    cellEntries[entry.slotInCell] = movedIndex;
+    entries[movedIndex].slotInCell = entry.slotInCell;
+    cellEntries.pop_back();
+
+    if (cellEntries.empty() && !entry.oversized)
+    {
+        cells.erase(entry.cellKey);
+    }
+}
+
+void SpatialGrid2D::Update(Node *node, const float boundsMin[2], const float boundsMax[2])
+{
+    uint64_t cellKey = 0;
+    const bool oversized = !ComputeCellKey(boundsMin, boundsMax, cellKey);
+
+    auto it = entryLookup.find(node);
+    if (it == entryLookup.end())
+    {
+        // New node - take a free slot or append one
+        uint32_t entryIndex;
+        if (!freeEntries.empty())
+        {
+            entryIndex = freeEntries.back();
+            freeEntries.pop_back();
+        }
+        else
+        {
+            entryIndex = static_cast<uint32_t>(entries.size());
+            entries.emplace_back();
+        }
+
+        Entry &entry = entries[entryIndex];
+        entry.node = node;
+        entry.boundsMin[0] = boundsMin[0];
+        entry.boundsMin[1] = boundsMin[1];
+        entry.boundsMax[0] = boundsMax[0];
+        entry.boundsMax[1] = boundsMax[1];
+        entryLookup.emplace(node, entryIndex);
+        Link(entryIndex, oversized, cellKey);
+        return;
+    }
+
+    uint32_t entryIndex = it->second;
+    Entry &entry = entries[entryIndex];
+    entry.boundsMin[0] = boundsMin[0];
+    entry.boundsMin[1] = boundsMin[1];
+    entry.boundsMax[0] = boundsMax[0];
+    entry.boundsMax[1] = boundsMax[1];
+
+    // Moving within the same loose cell only touches the bounds
+    if (entry.oversized != oversized || entry.cellKey != cellKey)
+    {
+        Unlink(entryIndex);
+        Link(entryIndex, oversized, cellKey);
+    }
+}
+
+void SpatialGrid2D::Remove(Node *node)
+{
+    auto it = entryLookup.find(node);
+    if (it == entryLookup.end())
+        return;
+
+    uint32_t entryIndex = it->second;
+    Unlink(entryIndex);
+    entries[entryIndex].node = nullptr;
+    freeEntries.push_back(entryIndex);
+    entryLookup.erase(it);
+}
+
+void SpatialGrid2D::Clear()
+{
+    entries.clear();
+    freeEntries.clear();
+    entryLookup.clear();
+    cells.clear();
+    oversizedEntries.clear();
+}
+
+void SpatialGrid2D::QueryCell(const std::vector<uint32_t> &cellEntries, const float boundsMin[2], const float boundsMax[2],
+                              std::vector<Node *> &outNodes) const
+{
+    for (uint32_t entryIndex : cellEntries)
+    {
+        const Entry &entry = entries[entryIndex];
+        if (entry.boundsMax[0] >= boundsMin[0] && entry.boundsMin[0] <= boundsMax[0] &&
+            entry.boundsMax[1] >= boundsMin[1] && entry.boundsMin[1] <= boundsMax[1])
+        {
+            outNodes.push_back(entry.node);
+        }
+    }
+}
+
+void SpatialGrid2D::Query(const float boundsMin[2], const float boundsMax[2], std::vector<Node *> &outNodes) const
+{
+    // Expand by the loose overhang so nodes centred just outside are found
+    float overhang = cellSize * 0.5f;
+    int32_t minCellX = static_cast<int32_t>(floorf((boundsMin[0] - overhang) * inverseCellSize));
+    int32_t minCellY = static_cast<int32_t>(floorf((boundsMin[1] - overhang) * inverseCellSize));
+    int32_t maxCellX = static_cast<int32_t>(floorf((boundsMax[0] + overhang) * inverseCellSize));
+    int32_t maxCellY = static_cast<int32_t>(floorf((boundsMax[1] + overhang) * inverseCellSize));
+
+    // When zoomed far out, walking the occupied cells is cheaper than the range
+    double rangeCells = (static_cast<double>(maxCellX) - minCellX + 1.0) * (static_cast<double>(maxCellY) - minCellY + 1.0);
+    if (rangeCells > static_cast<double>(cells.size()))
+    {
+        for (const auto &cell : cells)
+        {
+            int32_t cellX = static_cast<int32_t>(static_cast<uint32_t>(cell.first >> 32));
+            int32_t cellY = static_cast<int32_t>(static_cast<uint32_t>(cell.first));
+            if (cellX >= minCellX && cellX <= maxCellX && cellY >= minCellY && cellY <= maxCellY)
+            {
+                QueryCell(cell.second, boundsMin, boundsMax, outNodes);
+            }
+        }
+    }
+    else
+    {
+        for (int32_t cellY = minCellY; cellY <= maxCellY; cellY++)
+        {
+            for (int32_t cellX = minCellX; cellX <= maxCellX; cellX++)
+            {
+                auto it = cells.find(PackCell(cellX, cellY));
+                if (it != cells.end())
+                {
+                    QueryCell(it->second, boundsMin, boundsMax, outNodes);
+                }
+            }
+        }
+    }
+
+    QueryCell(oversizedEntries, boundsMin, boundsMax, outNodes);
+}
+
+bool SpatialGrid2D::Contains(const Node *node) const
+{
+    return entryLookup.find(node) != entryLookup.end();
+}
+
+size_t SpatialGrid2D::GetSize() const
+{
+    return entryLookup.size();
+}
+
+float SpatialGrid2D::GetCellSize() const
+{
+    return cellSize;
+}
@@ -0,0 +1,201 @@
+#include "StringAtom.h"
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const size_t TextBlockSize = 64 * 1024;
+
+    // Packed strings take whole slots of this many bytes, so freed slots fit strings of similar length
+    const size_t SlotGranularity = 8;
+
+    struct AtomEntry
+    {
+        const char *text;
+        uint32_t length;
+        uint32_t references; // Atoms holding this id, 0 for a free entry
+    };
+
+    // Text is packed into fixed blocks that never move, so entries and lookup keys can point into them.
+    // Released text goes on a free list by slot size and released ids are handed out again.
+    struct AtomTable
+    {
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char *currentBlock = nullptr;
+        size_t blockUsed = TextBlockSize;
+        size_t textBytes = 0;
+        std::vector<AtomEntry> entries;
+        std::unordered_map<std::string_view, uint32_t> lookup;
+        std::vector<uint32_t> freeIds;
+        std::vector<std::vector<char *>> freeSlots; // Indexed by slot size / SlotGranularity
+
+        AtomTable()
+        {
+            entries.push_back({"", 0, 0});
+            lookup.emplace(std::string_view(), 0);
+        }
+
+        uint32_t Intern(std::string_view text)
+        {
+            auto it = lookup.find(text);
+            if (it != lookup.end())
+            {
+                entries[it->second].references++;
+                return it->second;
+            }
+
+            char *storage = AllocateText(text.size() + 1);
+            std::copy(text.begin(), text.end(), storage);
+            storage[text.size()] = '\0';
+
+            uint32_t id;
+            if (!freeIds.empty())
+            {
+                id = freeIds.back();
+                freeIds.pop_back();
+            }
+            else
+            {
+                id = static_cast<uint32_t>(entries.size());
+                entries.emplace_back();
+            }
+            entries[id] = {storage, static_cast<uint32_t>(text.size()), 1};
+            lookup.emplace(std::string_view(storage, text.size()), id);
+            return id;
+        }
+
+        void Remove(uint32_t id)
+        {
+            AtomEntry &entry = entries[id];
+            lookup.erase(std::string_view(entry.text, entry.length));
+            FreeText(const_cast<char *>(entry.text), entry.length + 1);
+            entry = {"", 0, 0};
+            freeIds.push_back(id);
+        }
+
+        char *AllocateText(size_t size)
+        {
+            // Long strings get an allocation of their own, the current block keeps filling
+            if (size > TextBlockSize / 4)
+            {
+                textBytes += size;
+                return new char[size];
+            }
+
+            const size_t slotSize = (size + SlotGranularity - 1) / SlotGranularity * SlotGranularity;
+            const size_t slotClass = slotSize / SlotGranularity;
+            if (slotClass < freeSlots.size() && !freeSlots[slotClass].empty())
+            {
+                char *storage = freeSlots[slotClass].back();
+                freeSlots[slotClass].pop_back();
+                return storage;
+            }
+
+            if (blockUsed + slotSize > TextBlockSize)
+            {
+                blocks.emplace_back(new char[TextBlockSize]);
+                currentBlock = blocks.back().get();
+                blockUsed = 0;
+                textBytes += TextBlockSize;
+            }
+            char *storage = currentBlock + blockUsed;
+            blockUsed += slotSize;
+            return storage;
+        }
+
+        void FreeText(char *storage, size_t size)
+        {
+            if (size > TextBlockSize / 4)
+            {
+                textBytes -= size;
+                delete[] storage;
+                return;
+            }
+
+            const size_t slotClass = (size + SlotGranularity - 1) / SlotGranularity;
+            if (slotClass >= freeSlots.size())
+            {
+                freeSlots.resize(slotClass + 1);
+            }
+            freeSlots[slotClass].push_back(storage);
+        }
+    };
+
+    AtomTable &Table()
+    {
+        // Never destroyed, atoms in other statics may be released after it would have been
+        static AtomTable *table = new AtomTable();
+        return *table;
+    }
+}
+
+StringAtom::StringAtom(const char *text) : StringAtom(std::string_view(text ? text : ""))
+{
+}
+
+StringAtom::StringAtom(const std::string &text) : StringAtom(std::string_view(text))
+{
+}
+
+StringAtom::StringAtom(std::string_view text) : id(text.empty() ? 0 : Table().Intern(text))
+{
+}
+
+StringAtom StringAtom::Find(std::string_view text)
+{
+    StringAtom atom;
+    auto &lookup = Table().lookup;
+    auto it = lookup.find(text);
+    if (it != lookup.end())
+    {
+        atom.id = it->second;
+        Retain(atom.id);
+    }
+    return atom;
+}
+
+void StringAtom::AddReference(uint32_t id)
+{
+    Table().entries[id].references++;
+}
+
+void StringAtom::RemoveReference(uint32_t id)
+{
+    AtomTable &table = Table();
+    if (--table.entries[id].references == 0)
+    {
+        table.Remove(id);
+    }
+}
+
+const char *StringAtom::c_str() const
+{
+    return Table().entries[id].text;
+}
+
+std::string_view StringAtom::GetView() const
+{
+    const AtomEntry &entry = Table().entries[id];
+    return std::string_view(entry.text, entry.length);
+}
+
+size_t StringAtom::GetLength() const
+{
+    return Table().entries[id].length;
+}
+
+size_t StringAtom::GetAtomCount()
+{
+    const AtomTable &table = Table();
+    return table.entries.size() - table.freeIds.size();
+}
+
+size_t StringAtom::GetMemoryUsage()
+{
+    const AtomTable &table = Table();
+    return table.textBytes + table.entries.capacity() * sizeof(AtomEntry) + table.freeIds.capacity() * sizeof(uint32_t) +
+           table.lookup.size() * (sizeof(std::string_view) + sizeof(uint32_t) + sizeof(void *)) +
+           table.lookup.bucket_count() * sizeof(void *);
+}
@@ -0,0 +1,167 @@
+#include "SubtreeRenderCache.h"
+
+SubtreeRenderCache::SubtreeRenderCache(size_t budgetBytes) : budgetBytes(budgetBytes)
+{
+}
+
+SubtreeRenderCache::~SubtreeRenderCache()
+{
+    // Nothing to clean up
+}
+
+size_t SubtreeRenderCache::GetEntryBytes(const Entry &entry)
+{
+    return entry.vertices.size() * sizeof(ImDrawVert) + entry.indices.size() * sizeof(ImDrawIdx);
+}
+
+bool SubtreeRenderCache::KeysMatch(const CacheKey &a, const CacheKey &b)
+{
+    return a.version == b.version && a.zoom == b.zoom && a.rotation == b.rotation &&
+           a.scale[0] == b.scale[0] && a.scale[1] == b.scale[1];
+}
+
+bool SubtreeRenderCache::Draw(ImDrawList *drawList, const Node *root, const CacheKey &key, ImVec2 origin)
+{
+    auto it = entries.find(root);
+    if (it == entries.end() || !KeysMatch(it->second.key, key))
+    {
+        return false;
+    }
+    if (!it->second.movable && (origin.x != it->second.origin.x || origin.y != it->second.origin.y))
+    {
+        return false;
+    }
+
+    Entry &entry = it->second;
+    entry.lastUsedFrame = frame;
+    if (entry.indices.empty())
+    {
+        return true;
+    }
+
+    // Copy the recorded geometry, offset to where the root is now.
+    // PrimReserve may start a new vertex range, so the index base is read after it.
+    const float offsetX = origin.x - entry.origin.x;
+    const float offsetY = origin.y - entry.origin.y;
+    drawList->PrimReserve(static_cast<int>(entry.indices.size()), static_cast<int>(entry.vertices.size()));
+    const ImDrawIdx indexBase = static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx);
+    for (const ImDrawVert &vertex : entry.vertices)
+    {
+        drawList->PrimWriteVtx(ImVec2(vertex.pos.x + offsetX, vertex.pos.y + offsetY), vertex.uv, vertex.col);
+    }
+    for (ImDrawIdx index : entry.indices)
+    {
+        drawList->PrimWriteIdx(static_cast<ImDrawIdx>(indexBase + index));
+    }
+    return true;
+}
+
+void SubtreeRenderCache::BeginRecord(ImDrawList *drawList)
+{
+    recordVertexStart = drawList->VtxBuffer.Size;
+    recordIndexStart = drawList->IdxBuffer.Size;
+    recordCommandCount = drawList->CmdBuffer.Size;
+    recordVertexBase = drawList->_VtxCurrentIdx;
+}
+
+void SubtreeRenderCache::EndRecord(ImDrawList *drawList, const Node *root, const CacheKey &key, ImVec2 origin, bool movable)
+{
+    // The recording is only replayable if it stayed in a single draw command
+    // (same texture, clip rect and vertex offset) and fits 16-bit indices
+    const int vertexCount = drawList->VtxBuffer.Size - recordVertexStart;
+    const int indexCount = drawList->IdxBuffer.Size - recordIndexStart;
+    const bool replayable = drawList->CmdBuffer.Size == recordCommandCount &&
+                            (sizeof(ImDrawIdx) > 2 || vertexCount < (1 << 16));
+
+    Remove(root);
+    if (!replayable)
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.origin = origin;
+    entry.movable = movable;
+    entry.lastUsedFrame = frame;
+    entry.vertices.assign(drawList->VtxBuffer.Data + recordVertexStart, drawList->VtxBuffer.Data + recordVertexStart + vertexCount);
+    entry.indices.resize(indexCount);
+    for (int i = 0; i < indexCount; i++)
+    {
+        entry.indices[i] = static_cast<ImDrawIdx>(drawList->IdxBuffer.Data[recordIndexStart + i] - recordVertexBase);
+    }
+
+    // Subtrees too large for the whole budget are drawn live instead
+    size_t entryBytes = GetEntryBytes(entry);
+    if (entryBytes > budgetBytes)
+    {
+        return;
+    }
+
+    memoryUsage += entryBytes;
+    entries.emplace(root, std::move(entry));
+    EvictToBudget(root);
+}
+
+void SubtreeRenderCache::EvictToBudget(const Node *keep)
+{
+    while (memoryUsage > budgetBytes)
+    {
+        // Drop the least recently used recording
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->first != keep && (oldest == entries.end() || it->second.lastUsedFrame < oldest->second.lastUsedFrame))
+            {
+                oldest = it;
+            }
+        }
+        if (oldest == entries.end())
+            break;
+
+        memoryUsage -= GetEntryBytes(oldest->second);
+        entries.erase(oldest);
+    }
+}
+
+void SubtreeRenderCache::Remove(const Node *root)
+{
+    auto it = entries.find(root);
+    if (it == entries.end())
+        return;
+
+    memoryUsage -= GetEntryBytes(it->second);
+    entries.erase(it);
+}
+
+void SubtreeRenderCache::Clear()
+{
+    entries.clear();
+    memoryUsage = 0;
+}
+
+void SubtreeRenderCache::NextFrame()
+{
+    frame++;
+}
+
+void SubtreeRenderCache::SetBudget(size_t budgetBytes)
+{
+    this->budgetBytes = budgetBytes;
+    EvictToBudget(nullptr);
+}
+
+size_t SubtreeRenderCache::GetBudget() const
+{
+    return budgetBytes;
+}
+
+size_t SubtreeRenderCache::GetMemoryUsage() const
+{
+    return memoryUsage;
+}
+
+size_t SubtreeRenderCache::GetEntryCount() const
+{
+    return entries.size();
+}
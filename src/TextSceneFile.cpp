@@ -0,0 +1,816 @@
+#include "TextSceneFile.h"
+#include "SceneFile.h"
+#include "MappedFile.h"
+#include "JsonSaxParser.h"
+#include "NodeTypeRegistry.h"
+#include "../nodes/PrefabInstance/PrefabInstance.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Keys of the document, and the parts of a node that aren't reflected properties
+    enum class Field
+    {
+        Unknown,
+        Format,
+        Root,
+        Class,
+        Type,
+        Expanded,
+        Children,
+        Prefabs,
+        Prefab,
+        Overrides,
+        OverrideNode,
+        Property // One of the node's reflected properties, named by PropertyKeys
+    };
+
+    struct FieldName
+    {
+        const char *name;
+        Field field;
+    };
+
+    const FieldName FieldNames[] = {
+        {"format", Field::Format},
+        {"root", Field::Root},
+        {"class", Field::Class},
+        {"type", Field::Type},
+        {"expanded", Field::Expanded},
+        {"children", Field::Children},
+        {"prefabs", Field::Prefabs},
+        {"prefab", Field::Prefab},
+        {"overrides", Field::Overrides},
+        {"node", Field::OverrideNode},
+    };
+
+    // Indexed by NodeProperty
+    const char *const PropertyKeys[] = {"name", "cacheAsBitmap", "position", "rotation", "scale", "color", "texture",
+                                        "text", "font", "fontSize", "layer", "zIndex", "ySort", "energy", "radius",
+                                        "zoom", "active", "fov", "nearClip", "farClip"};
+    static_assert(sizeof(PropertyKeys) / sizeof(PropertyKeys[0]) == static_cast<size_t>(NodeProperty::Count), "Every property needs a key");
+
+    bool KeyEquals(const char *name, const char *key, size_t length)
+    {
+        return std::strncmp(name, key, length) == 0 && name[length] == '\0';
+    }
+
+    Field FindField(const char *key, size_t length, NodeProperty &outProperty)
+    {
+        for (const FieldName &entry : FieldNames)
+        {
+            if (KeyEquals(entry.name, key, length))
+                return entry.field;
+        }
+        for (size_t i = 0; i < static_cast<size_t>(NodeProperty::Count); i++)
+        {
+            if (KeyEquals(PropertyKeys[i], key, length))
+            {
+                outProperty = static_cast<NodeProperty>(i);
+                return Field::Property;
+            }
+        }
+        return Field::Unknown;
+    }
+
+    // False if the node's class has no such property
+    bool FindPropertyKind(const Node *node, NodeProperty property, PropertyKind &outKind)
+    {
+        for (const PropertyInfo &info : node->GetPropertyInfos())
+        {
+            if (info.property == property)
+            {
+                outKind = info.kind;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Number of floats in a vector property, 0 for the other kinds
+    int GetComponentCount(PropertyKind kind)
+    {
+        if (kind == PropertyKind::Float3)
+            return 3;
+        if (kind == PropertyKind::Float4)
+            return 4;
+        return 0;
+    }
+
+    // Builds nodes as the parser reports them, one frame per open object or array
+    class SceneBuilder : public JsonSaxHandler
+    {
+    public:
+        std::shared_ptr<Node> root;
+        std::string error;
+
+        bool StartObject() override
+        {
+            if (frames.empty())
+            {
+                frames.push_back({FrameKind::Document});
+                return true;
+            }
+
+            // A node is the document's root, a prefab's template root or an element of a children array
+            Frame &top = frames.back();
+            if ((top.kind == FrameKind::Document && top.field == Field::Root && !root) || top.kind == FrameKind::Children || top.kind == FrameKind::Prefabs)
+            {
+                Frame frame = {FrameKind::Node};
+                frame.parent = top.kind == FrameKind::Children ? top.node : nullptr;
+                frame.prefabRoot = top.kind == FrameKind::Prefabs;
+                frames.push_back(frame);
+                return true;
+            }
+
+            // Each element of an overrides array changes one template node of the instance
+            if (top.kind == FrameKind::Overrides)
+            {
+                Frame frame = {FrameKind::Override};
+                frame.instance = top.instance;
+                frames.push_back(frame);
+                return true;
+            }
+
+            frames.push_back({FrameKind::Skip});
+            return true;
+        }
+
+        bool EndObject() override
+        {
+            const Frame &frame = frames.back();
+            if (frame.kind == FrameKind::Node && !frame.node)
+                return Error(frame.needsPrefab ? "prefab instance has no prefab" : "node has no class");
+            if (frame.kind == FrameKind::Override && !frame.node)
+                return Error("override has no node");
+
+            // A template is complete once its root object closes
+            if (frame.kind == FrameKind::Node && frame.prefabRoot)
+                prefabs.push_back(Prefab::Adopt(std::move(templateRoot)));
+
+            frames.pop_back();
+            return true;
+        }
+
+        bool StartArray() override
+        {
+            if (frames.empty())
+                return Error("a scene must be an object");
+
+            Frame &top = frames.back();
+            if (top.kind == FrameKind::Document && top.field == Field::Prefabs)
+            {
+                frames.push_back({FrameKind::Prefabs});
+                return true;
+            }
+
+            if (top.kind == FrameKind::Node || top.kind == FrameKind::Override)
+            {
+                PropertyKind kind;
+                if (top.field == Field::Property && FindPropertyKind(top.node, top.property, kind) && GetComponentCount(kind) > 0)
+                {
+                    vectorCount = 0;
+                    Frame frame = top;
+                    frame.kind = FrameKind::Vector;
+                    frames.push_back(frame);
+                    return true;
+                }
+
+                if (top.kind == FrameKind::Node && top.field == Field::Children)
+                {
+                    if (!top.node)
+                        return Error("\"class\" must be the first key of a node");
+                    frames.push_back({FrameKind::Children, Field::Children, top.property, top.node});
+                    return true;
+                }
+
+                PrefabInstance *instance = dynamic_cast<PrefabInstance *>(top.node);
+                if (top.kind == FrameKind::Node && top.field == Field::Overrides && instance)
+                {
+                    Frame frame = {FrameKind::Overrides};
+                    frame.instance = instance;
+                    frames.push_back(frame);
+                    return true;
+                }
+            }
+
+            frames.push_back({FrameKind::Skip});
+            return true;
+        }
+
+        bool EndArray() override
+        {
+            Frame frame = frames.back();
+            frames.pop_back();
+            return frame.kind != FrameKind::Vector || ApplyVector(frame);
+        }
+
+        bool Key(const char *key, size_t length) override
+        {
+            Frame &top = frames.back();
+            if (top.kind != FrameKind::Node && top.kind != FrameKind::Override && top.kind != FrameKind::Document)
+                return true;
+
+            top.field = FindField(key, length, top.property);
+            if (top.kind == FrameKind::Override)
+            {
+                // Only the template node's index and its properties mean something in an override
+                if (top.field != Field::OverrideNode && top.field != Field::Property)
+                    top.field = Field::Unknown;
+                if (!top.node && top.field != Field::OverrideNode)
+                    return Error("\"node\" must be the first key of an override");
+                return true;
+            }
+
+            if (top.kind == FrameKind::Node && !top.node)
+            {
+                if (top.needsPrefab && top.field != Field::Prefab)
+                    return Error("\"prefab\" must follow \"class\" in a prefab instance");
+                if (!top.needsPrefab && top.field != Field::Class)
+                    return Error("\"class\" must be the first key of a node");
+            }
+            return true;
+        }
+
+        bool String(const char *value, size_t length) override
+        {
+            if (frames.empty())
+                return Error("a scene must be an object");
+
+            Frame &top = frames.back();
+            if (top.kind != FrameKind::Node && top.kind != FrameKind::Override)
+                return top.kind != FrameKind::Document || top.field != Field::Root || Error("\"root\" must be an object");
+
+            switch (top.field)
+            {
+            case Field::Class:
+                return CreateNode(top, value, length);
+
+            case Field::Type:
+                if (!NodeTypeRegistry::FindByName(value, length, top.node->type))
+                    return Error("unknown node type \"" + std::string(value, length) + "\"");
+                return true;
+
+            case Field::Property:
+            {
+                // Strings and atoms are encoded as their text
+                PropertyKind kind;
+                if (FindPropertyKind(top.node, top.property, kind) && (kind == PropertyKind::String || kind == PropertyKind::Atom))
+                    Apply(top, top.property, reinterpret_cast<const uint8_t *>(value), length);
+                return true;
+            }
+
+            default:
+                return true;
+            }
+        }
+
+        bool Number(double value) override
+        {
+            if (frames.empty())
+                return Error("a scene must be an object");
+
+            Frame &top = frames.back();
+            if (top.kind == FrameKind::Vector)
+            {
+                if (vectorCount == 4)
+                    return Error("too many components");
+                vector[vectorCount++] = static_cast<float>(value);
+                return true;
+            }
+
+            if (top.kind == FrameKind::Document && top.field == Field::Format && value != TextSceneFile::Version)
+                return Error("unsupported format version");
+
+            if (top.kind == FrameKind::Node && top.field == Field::Prefab && top.needsPrefab)
+                return CreateInstance(top, value);
+            if (top.kind == FrameKind::Override && top.field == Field::OverrideNode)
+                return FindOverrideNode(top, value);
+
+            PropertyKind kind;
+            if ((top.kind != FrameKind::Node && top.kind != FrameKind::Override) || top.field != Field::Property || !FindPropertyKind(top.node, top.property, kind))
+                return true;
+
+            if (kind == PropertyKind::Int)
+                SetValue(top, top.property, static_cast<int>(value));
+            else if (kind == PropertyKind::Float)
+                SetValue(top, top.property, static_cast<float>(value));
+            return true;
+        }
+
+        bool Bool(bool value) override
+        {
+            if (frames.empty())
+                return Error("a scene must be an object");
+
+            Frame &top = frames.back();
+            if (top.kind != FrameKind::Node && top.kind != FrameKind::Override)
+                return true;
+
+            PropertyKind kind;
+            if (top.field == Field::Expanded)
+                top.node->expanded = value;
+            else if (top.field == Field::Property && FindPropertyKind(top.node, top.property, kind) && kind == PropertyKind::Bool)
+                SetValue(top, top.property, value);
+            return true;
+        }
+
+        bool Null() override
+        {
+            return !frames.empty() || Error("a scene must be an object");
+        }
+
+    private:
+        enum class FrameKind
+        {
+            Document,
+            Prefabs,
+            Node,
+            Children,
+            Overrides,
+            Override,
+            Vector,
+            Skip
+        };
+
+        struct Frame
+        {
+            FrameKind kind;
+            Field field = Field::Unknown; // Last key read in this object, or what a vector fills
+            NodeProperty property = NodeProperty::Count;
+            Node *node = nullptr;               // Node being read, the parent of a children array, or the template node an override changes
+            Node *parent = nullptr;             // Where a node object attaches once its class is known
+            PrefabInstance *instance = nullptr; // Instance whose overrides are being read
+            uint32_t nodeIndex = 0;             // Template node an override changes
+            bool prefabRoot = false;            // The node is a prefab's template root
+            bool needsPrefab = false;           // A prefab instance waiting for its prefab
+        };
+
+        std::vector<Frame> frames;
+        float vector[4];
+        int vectorCount = 0;
+
+        // Prefabs read so far, instances refer to them by index
+        std::vector<std::shared_ptr<const Prefab>> prefabs;
+        std::shared_ptr<Node> templateRoot;
+
+        bool Error(const std::string &message)
+        {
+            error = message;
+            return false;
+        }
+
+        // A node's properties are set on it, an override's go through its instance
+        static void Apply(const Frame &frame, NodeProperty property, const uint8_t *value, size_t size)
+        {
+            if (frame.instance)
+                frame.instance->SetOverride(frame.nodeIndex, property, value, size);
+            else
+                frame.node->SetProperty(property, value, size);
+        }
+
+        template <typename T>
+        static void SetValue(const Frame &frame, NodeProperty property, const T &value)
+        {
+            Apply(frame, property, reinterpret_cast<const uint8_t *>(&value), sizeof(T));
+        }
+
+        bool CreateNode(Frame &frame, const char *className, size_t length)
+        {
+            SceneFile::NodeClass nodeClass;
+            if (frame.node)
+                return Error("node has more than one class");
+            if (!SceneFile::FindNodeClass(className, length, nodeClass))
+                return Error("unknown node class \"" + std::string(className, length) + "\"");
+
+            // An instance is constructed once its prefab is known, which has to be the next key
+            if (nodeClass == SceneFile::NodeClass::PrefabInstance)
+            {
+                frame.needsPrefab = true;
+                return true;
+            }
+
+            // The type defaults to the class's own and is usually overridden by the "type" key
+            NodeType type = nodeClass == SceneFile::NodeClass::Sprite ? NodeType::Sprite : NodeType::Node2D;
+            Attach(frame, SceneFile::CreateNode(nodeClass, std::string(), type));
+            return true;
+        }
+
+        bool CreateInstance(Frame &frame, double prefabIndex)
+        {
+            if (frame.node)
+                return Error("node has more than one prefab");
+            if (!(prefabIndex >= 0.0 && prefabIndex < prefabs.size()) || prefabIndex != std::floor(prefabIndex))
+                return Error("unknown prefab " + std::to_string(prefabIndex));
+
+            Attach(frame, std::make_shared<PrefabInstance>(std::string(), prefabs[static_cast<size_t>(prefabIndex)]));
+            return true;
+        }
+
+        void Attach(Frame &frame, std::shared_ptr<Node> node)
+        {
+            frame.node = node.get();
+
+            // Children are attached directly, the whole tree is queued for one transform update at the end
+            if (frame.parent)
+            {
+                node->parent = frame.parent;
+                frame.parent->children.push_back(std::move(node));
+            }
+            else if (frame.prefabRoot)
+            {
+                templateRoot = std::move(node);
+            }
+            else
+            {
+                root = std::move(node);
+            }
+        }
+
+        bool FindOverrideNode(Frame &frame, double nodeIndex)
+        {
+            if (frame.node)
+                return Error("override has more than one node");
+            if (!(nodeIndex >= 0.0 && nodeIndex < frame.instance->GetPrefab()->GetNodes().size()) || nodeIndex != std::floor(nodeIndex))
+                return Error("override of a node the prefab doesn't have");
+
+            // Property kinds are looked up on the template node, its class is the same for every instance
+            frame.nodeIndex = static_cast<uint32_t>(nodeIndex);
+            frame.node = frame.instance->GetResolvedNode(frame.nodeIndex);
+            return true;
+        }
+
+        bool ApplyVector(const Frame &frame)
+        {
+            // The last component may be left out and keeps its current value, like z in 2D scenes or a colour's alpha
+            PropertyKind kind;
+            FindPropertyKind(frame.node, frame.property, kind);
+            const int componentCount = GetComponentCount(kind);
+            if (vectorCount < componentCount - 1 || vectorCount > componentCount)
+                return Error("expected " + std::to_string(componentCount - 1) + " or " + std::to_string(componentCount) + " components");
+
+            // An override's current value is the one the instance shows
+            const Node *current = frame.instance ? frame.instance->GetResolvedNode(frame.nodeIndex) : frame.node;
+            float components[4];
+            std::vector<uint8_t> currentValue;
+            current->GetProperty(frame.property, currentValue);
+            std::memcpy(components, currentValue.data(), sizeof(float) * componentCount);
+            std::memcpy(components, vector, sizeof(float) * vectorCount);
+            Apply(frame, frame.property, reinterpret_cast<const uint8_t *>(components), sizeof(float) * componentCount);
+            return true;
+        }
+    };
+
+    // Appends the text form of a scene
+    class SceneTextWriter
+    {
+    public:
+        std::string out;
+
+        void Indent(int depth)
+        {
+            out.append(static_cast<size_t>(depth) * 2, ' ');
+        }
+
+        void Key(int depth, const char *key)
+        {
+            Indent(depth);
+            out += '"';
+            out += key;
+            out += "\": ";
+        }
+
+        void String(std::string_view value)
+        {
+            out += '"';
+            for (char c : value)
+            {
+                switch (c)
+                {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                    break;
+                }
+            }
+            out += '"';
+        }
+
+        void Number(float value)
+        {
+            // Nine significant digits bring every float back unchanged
+            char text[32];
+            snprintf(text, sizeof(text), "%.9g", std::isfinite(value) ? value : 0.0f);
+            out += text;
+        }
+
+        void Vector(const float *values, int count)
+        {
+            out += '[';
+            for (int i = 0; i < count; i++)
+            {
+                if (i > 0)
+                    out += ", ";
+                Number(values[i]);
+            }
+            out += ']';
+        }
+
+        // One property per line, the first one without a leading comma
+        void Property(int depth, const char *key)
+        {
+            if (!firstProperty)
+                out += ",\n";
+            firstProperty = false;
+            Key(depth, key);
+        }
+
+        // Open a node object and write its properties, depth is the indentation of its braces
+        void BeginNode(const Node *node, int depth)
+        {
+            out += "{\n";
+            firstProperty = true;
+
+            const SceneFile::NodeClass nodeClass = SceneFile::GetNodeClass(node);
+            Property(depth + 1, "class");
+            String(SceneFile::GetNodeClassName(nodeClass));
+
+            // An instance is constructed from its prefab, so the prefab follows the class
+            const PrefabInstance *instance = nodeClass == SceneFile::NodeClass::PrefabInstance ? static_cast<const PrefabInstance *>(node) : nullptr;
+            if (instance)
+            {
+                Property(depth + 1, "prefab");
+                out += std::to_string(prefabIndices.at(instance->GetPrefab().get()));
+            }
+
+            Property(depth + 1, "type");
+            String(NodeTypeRegistry::Get(node->type).name);
+            if (node->expanded)
+            {
+                Property(depth + 1, "expanded");
+                out += "true";
+            }
+
+            // Every reflected property of the node's class, in field order
+            for (const PropertyInfo &info : node->GetPropertyInfos())
+            {
+                value.clear();
+                node->GetProperty(info.property, value);
+                Property(depth + 1, PropertyKeys[static_cast<size_t>(info.property)]);
+                Value(info.kind, value);
+            }
+
+            if (instance && !instance->GetOverrides().empty())
+            {
+                Overrides(instance, depth + 1);
+            }
+        }
+
+        // One line per changed template node, its index first and then the values it changes
+        void Overrides(const PrefabInstance *instance, int depth)
+        {
+            Property(depth, "overrides");
+            out += "[\n";
+
+            const std::vector<PrefabOverride> &overrides = instance->GetOverrides();
+            const std::vector<Node *> &templateNodes = instance->GetPrefab()->GetNodes();
+            for (size_t i = 0; i < overrides.size(); i++)
+            {
+                const PrefabOverride &entry = overrides[i];
+                if (i == 0 || overrides[i - 1].nodeIndex != entry.nodeIndex)
+                {
+                    if (i > 0)
+                        out += "},\n";
+                    Indent(depth + 1);
+                    out += "{\"node\": " + std::to_string(entry.nodeIndex);
+                }
+
+                PropertyKind kind;
+                FindPropertyKind(templateNodes[entry.nodeIndex], entry.property, kind);
+                out += ", ";
+                String(PropertyKeys[static_cast<size_t>(entry.property)]);
+                out += ": ";
+                value.assign(instance->GetOverrideValue(entry), instance->GetOverrideValue(entry) + entry.size);
+                Value(kind, value);
+            }
+            out += "}\n";
+            Indent(depth);
+            out += ']';
+        }
+
+        // Write a node object and everything under it, depth is the indentation of its braces
+        void Tree(const Node *root, int depth)
+        {
+            BeginNode(root, depth);
+
+            // Depth-first with an explicit stack, each entry remembers the next child to write
+            struct Entry
+            {
+                const Node *node;
+                size_t nextChild;
+                int depth;
+            };
+            std::vector<Entry> stack;
+            stack.push_back({root, 0, depth});
+            while (!stack.empty())
+            {
+                Entry &entry = stack.back();
+                const std::vector<std::shared_ptr<Node>> &children = entry.node->children;
+                if (entry.nextChild < children.size())
+                {
+                    // The children array opens before the first child
+                    out += ",\n";
+                    if (entry.nextChild == 0)
+                    {
+                        Key(entry.depth + 1, "children");
+                        out += "[\n";
+                    }
+
+                    const Node *child = children[entry.nextChild++].get();
+                    const int childDepth = entry.depth + 2;
+                    Indent(childDepth);
+                    BeginNode(child, childDepth);
+                    stack.push_back({child, 0, childDepth});
+                    continue;
+                }
+
+                // Close the children array and the node object
+                if (!children.empty())
+                {
+                    out += '\n';
+                    Indent(entry.depth + 1);
+                    out += ']';
+                }
+                out += '\n';
+                Indent(entry.depth);
+                out += '}';
+                stack.pop_back();
+            }
+        }
+
+        // Write a value encoded like Node::GetProperty
+        void Value(PropertyKind kind, const std::vector<uint8_t> &bytes)
+        {
+            switch (kind)
+            {
+            case PropertyKind::String:
+            case PropertyKind::Atom:
+                String(std::string_view(reinterpret_cast<const char *>(bytes.data()), bytes.size()));
+                break;
+
+            case PropertyKind::Bool:
+                out += bytes[0] ? "true" : "false";
+                break;
+
+            case PropertyKind::Int:
+            {
+                int integer;
+                std::memcpy(&integer, bytes.data(), sizeof(integer));
+                out += std::to_string(integer);
+                break;
+            }
+
+            case PropertyKind::Float:
+            {
+                float number;
+                std::memcpy(&number, bytes.data(), sizeof(number));
+                Number(number);
+                break;
+            }
+
+            case PropertyKind::Float3:
+            case PropertyKind::Float4:
+            {
+                float components[4];
+                const int componentCount = GetComponentCount(kind);
+                std::memcpy(components, bytes.data(), sizeof(float) * componentCount);
+                Vector(components, componentCount);
+                break;
+            }
+            }
+        }
+
+        std::unordered_map<const Prefab *, uint32_t> prefabIndices;
+
+    private:
+        bool firstProperty = true;
+        std::vector<uint8_t> value;
+    };
+}
+
+bool TextSceneFile::Save(const Node *root, const std::string &path)
+{
+    if (!root)
+        return false;
+
+    // Prefabs come ahead of the scene, an instance can only refer to one the parser has already read
+    std::vector<const Prefab *> prefabs;
+    Prefab::CollectPrefabs(root, prefabs);
+
+    SceneTextWriter writer;
+    writer.out += "{\n  \"format\": " + std::to_string(Version) + ",\n";
+    if (!prefabs.empty())
+    {
+        writer.Key(1, "prefabs");
+        writer.out += "[\n";
+        for (uint32_t i = 0; i < prefabs.size(); i++)
+        {
+            writer.prefabIndices.emplace(prefabs[i], i);
+            if (i > 0)
+                writer.out += ",\n";
+            writer.Indent(2);
+            writer.Tree(prefabs[i]->GetRoot().get(), 2);
+        }
+        writer.out += "\n  ],\n";
+    }
+    writer.Key(1, "root");
+    writer.Tree(root, 1);
+    writer.out += "\n}\n";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "Failed to open scene file for writing: " << path << std::endl;
+        return false;
+    }
+
+    file.write(writer.out.data(), static_cast<std::streamsize>(writer.out.size()));
+    if (!file)
+    {
+        std::cerr << "Failed to write scene file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<Node> TextSceneFile::Load(const std::string &path)
+{
+    // The parser reads the mapped file in place
+    MappedFile mapping;
+    if (!mapping.Open(path))
+        return nullptr;
+
+    return Parse(reinterpret_cast<const char *>(mapping.GetData()), mapping.GetSize(), path);
+}
+
+std::shared_ptr<Node> TextSceneFile::Parse(const char *data, size_t size, const std::string &path)
+{
+    SceneBuilder builder;
+    JsonSaxParser parser;
+    if (!parser.Parse(data, size, builder))
+    {
+        const std::string &message = parser.GetError().empty() ? builder.error : parser.GetError();
+        std::cerr << "Failed to parse scene " << path << ":" << parser.GetErrorLine() << ": " << message << std::endl;
+        return nullptr;
+    }
+    if (!builder.root)
+    {
+        std::cerr << "Scene file has no root node: " << path << std::endl;
+        return nullptr;
+    }
+
+    builder.root->MarkTransformDirty();
+    return builder.root;
+}
+
+bool TextSceneFile::ConvertToBinary(const std::string &textPath, const std::string &binaryPath)
+{
+    std::shared_ptr<Node> root = Load(textPath);
+    return root && SceneFile::Save(root.get(), binaryPath);
+}
+
+bool TextSceneFile::IsTextScenePath(const std::string &path)
+{
+    const std::string extension = ".json";
+    return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
@@ -0,0 +1,162 @@
+#include "TiledLightCuller.h"
+#include <algorithm>
+#include <cmath>
+
+TiledLightCuller::TiledLightCuller(float tileSize) : tileSize(tileSize)
+{
+}
+
+TiledLightCuller::~TiledLightCuller()
+{
+    // Nothing to clean up
+}
+
+void TiledLightCuller::Begin(float viewportWidth, float viewportHeight)
+{
+    this->viewportWidth = std::max(viewportWidth, 0.0f);
+    this->viewportHeight = std::max(viewportHeight, 0.0f);
+    tileCountX = static_cast<int>(ceilf(this->viewportWidth / tileSize));
+    tileCountY = static_cast<int>(ceilf(this->viewportHeight / tileSize));
+
+    // Keep the capacity so next frame's lights don't allocate
+    lights.clear();
+    tileLightIndices.clear();
+    tileOffsets.assign(static_cast<size_t>(tileCountX) * tileCountY + 1, 0);
+}
+
+void TiledLightCuller::AddLight(const Light &light)
+{
+    if (light.radius > 0.0f && light.energy > 0.0f)
+    {
+        lights.push_back(light);
+    }
+}
+
+bool TiledLightCuller::GetTileRange(const Light &light, int &minX, int &minY, int &maxX, int &maxY) const
+{
+    minX = std::max(static_cast<int>(floorf((light.position[0] - light.radius) / tileSize)), 0);
+    minY = std::max(static_cast<int>(floorf((light.position[1] - light.radius) / tileSize)), 0);
+    maxX = std::min(static_cast<int>(floorf((light.position[0] + light.radius) / tileSize)), tileCountX - 1);
+    maxY = std::min(static_cast<int>(floorf((light.position[1] + light.radius) / tileSize)), tileCountY - 1);
+    return minX <= maxX && minY <= maxY;
+}
+
+bool TiledLightCuller::OverlapsTile(const Light &light, int tileX, int tileY) const
+{
+    // Distance from the light to the closest point of the tile
+    float tileMinX = tileX * tileSize;
+    float tileMinY = tileY * tileSize;
+    float dx = light.position[0] - std::clamp(light.position[0], tileMinX, tileMinX + tileSize);
+    float dy = light.position[1] - std::clamp(light.position[1], tileMinY, tileMinY + tileSize);
+    return dx * dx + dy * dy <= light.radius * light.radius;
+}
+
+void TiledLightCuller::Cull()
+{
+    if (tileCountX == 0 || tileCountY == 0)
+    {
+        return;
+    }
+
+    // Count lights per tile. The circle test trims the corners of the square range.
+    int minX, minY, maxX, maxY;
+    for (const Light &light : lights)
+    {
+        if (!GetTileRange(light, minX, minY, maxX, maxY))
+            continue;
+
+        for (int tileY = minY; tileY <= maxY; tileY++)
+        {
+            for (int tileX = minX; tileX <= maxX; tileX++)
+            {
+                if (OverlapsTile(light, tileX, tileY))
+                {
+                    tileOffsets[tileY * tileCountX + tileX + 1]++;
+                }
+            }
+        }
+    }
+
+    // Prefix sum turns counts into offsets
+    const size_t tileCount = static_cast<size_t>(tileCountX) * tileCountY;
+    for (size_t tile = 0; tile < tileCount; tile++)
+    {
+        tileOffsets[tile + 1] += tileOffsets[tile];
+    }
+
+    // Scatter light indices, reusing the offsets as write cursors and shifting them back afterwards
+    tileLightIndices.resize(tileOffsets[tileCount]);
+    for (uint32_t lightIndex = 0; lightIndex < lights.size(); lightIndex++)
+    {
+        const Light &light = lights[lightIndex];
+        if (!GetTileRange(light, minX, minY, maxX, maxY))
+            continue;
+
+        for (int tileY = minY; tileY <= maxY; tileY++)
+        {
+            for (int tileX = minX; tileX <= maxX; tileX++)
+            {
+                if (OverlapsTile(light, tileX, tileY))
+                {
+                    tileLightIndices[tileOffsets[tileY * tileCountX + tileX]++] = lightIndex;
+                }
+            }
+        }
+    }
+    for (size_t tile = tileCount; tile > 0; tile--)
+    {
+        tileOffsets[tile] = tileOffsets[tile - 1];
+    }
+    tileOffsets[0] = 0;
+}
+
+int TiledLightCuller::GetTileCountX() const
+{
+    return tileCountX;
+}
+
+int TiledLightCuller::GetTileCountY() const
+{
+    return tileCountY;
+}
+
+float TiledLightCuller::GetTileSize() const
+{
+    return tileSize;
+}
+
+size_t TiledLightCuller::GetLightCount() const
+{
+    return lights.size();
+}
+
+const uint32_t *TiledLightCuller::GetTileLights(int tileX, int tileY, uint32_t &outCount) const
+{
+    size_t tile = static_cast<size_t>(tileY) * tileCountX + tileX;
+    outCount = tileOffsets[tile + 1] - tileOffsets[tile];
+    return tileLightIndices.data() + tileOffsets[tile];
+}
+
+void TiledLightCuller::EvaluateTile(int tileX, int tileY, float x, float y, float outColor[3]) const
+{
+    outColor[0] = outColor[1] = outColor[2] = 0.0f;
+
+    uint32_t lightCount;
+    const uint32_t *tileLights = GetTileLights(tileX, tileY, lightCount);
+    for (uint32_t i = 0; i < lightCount; i++)
+    {
+        const Light &light = lights[tileLights[i]];
+        float dx = x - light.position[0];
+        float dy = y - light.position[1];
+        float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared >= light.radius * light.radius)
+            continue;
+
+        // Smooth quadratic falloff reaching zero at the radius
+        float falloff = 1.0f - sqrtf(distanceSquared) / light.radius;
+        float intensity = light.energy * falloff * falloff;
+        outColor[0] += light.color[0] * intensity;
+        outColor[1] += light.color[1] * intensity;
+        outColor[2] += light.color[2] * intensity;
+    }
+}
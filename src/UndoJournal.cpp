@@ -0,0 +1,238 @@
+#include "UndoJournal.h"
+#include <algorithm>
+#include <cstring>
+
+void UndoJournal::Recording::Begin(const std::string &label)
+{
+    this->label = label;
+    snapshots.clear();
+    values.clear();
+    active = true;
+}
+
+void UndoJournal::Recording::Track(const Node *node, NodeProperty property)
+{
+    if (!active || !node)
+        return;
+
+    size_t offset = values.size();
+    if (!node->GetProperty(property, values))
+        return;
+
+    snapshots.push_back({node->GetInstanceId(), property, static_cast<uint32_t>(offset),
+                         static_cast<uint32_t>(values.size() - offset)});
+}
+
+void UndoJournal::Recording::TrackAll(const Node *node)
+{
+    for (uint16_t property = 0; property < static_cast<uint16_t>(NodeProperty::Count); property++)
+    {
+        Track(node, static_cast<NodeProperty>(property));
+    }
+}
+
+void UndoJournal::Recording::Cancel()
+{
+    snapshots.clear();
+    values.clear();
+    active = false;
+}
+
+bool UndoJournal::Recording::IsActive() const
+{
+    return active;
+}
+
+UndoJournal::UndoJournal(size_t capacity, size_t memoryBudget) : slots(std::max<size_t>(capacity, 1)), memoryBudget(memoryBudget)
+{
+}
+
+UndoJournal::~UndoJournal()
+{
+    // Nothing to clean up
+}
+
+bool UndoJournal::Commit(Recording &recording)
+{
+    if (!recording.active)
+        return false;
+
+    // A property tracked more than once keeps the value from before the edit began
+    std::stable_sort(recording.snapshots.begin(), recording.snapshots.end(),
+                     [](const Recording::Snapshot &a, const Recording::Snapshot &b)
+                     {
+                         if (a.nodeId != b.nodeId)
+                             return a.nodeId < b.nodeId;
+                         return a.property < b.property;
+                     });
+
+    Entry entry;
+    const Recording::Snapshot *previous = nullptr;
+    for (const Recording::Snapshot &snapshot : recording.snapshots)
+    {
+        if (previous && previous->nodeId == snapshot.nodeId && previous->property == snapshot.property)
+            continue;
+        previous = &snapshot;
+
+        Node *node = Node::FindByInstanceId(snapshot.nodeId);
+        if (!node)
+            continue;
+
+        scratch.clear();
+        node->GetProperty(snapshot.property, scratch);
+
+        // Only properties that actually changed are kept
+        const uint8_t *oldValue = recording.values.data() + snapshot.offset;
+        if (scratch.size() == snapshot.size && std::memcmp(scratch.data(), oldValue, snapshot.size) == 0)
+            continue;
+
+        Delta delta;
+        delta.nodeId = snapshot.nodeId;
+        delta.property = snapshot.property;
+        delta.offset = static_cast<uint32_t>(entry.data.size());
+        delta.oldSize = snapshot.size;
+        delta.newSize = static_cast<uint32_t>(scratch.size());
+        entry.deltas.push_back(delta);
+        entry.data.insert(entry.data.end(), oldValue, oldValue + snapshot.size);
+        entry.data.insert(entry.data.end(), scratch.begin(), scratch.end());
+    }
+
+    bool changed = !entry.deltas.empty();
+    if (changed)
+    {
+        entry.label = recording.label;
+        entry.deltas.shrink_to_fit();
+        entry.data.shrink_to_fit();
+        Push(std::move(entry));
+    }
+
+    recording.Cancel();
+    return changed;
+}
+
+bool UndoJournal::Undo()
+{
+    if (cursor == 0)
+        return false;
+
+    cursor--;
+    Apply(GetEntry(cursor), true);
+    return true;
+}
+
+bool UndoJournal::Redo()
+{
+    if (cursor == count)
+        return false;
+
+    Apply(GetEntry(cursor), false);
+    cursor++;
+    return true;
+}
+
+bool UndoJournal::CanUndo() const
+{
+    return cursor > 0;
+}
+
+bool UndoJournal::CanRedo() const
+{
+    return cursor < count;
+}
+
+const std::string &UndoJournal::GetUndoLabel() const
+{
+    static const std::string empty;
+    return cursor > 0 ? GetEntry(cursor - 1).label : empty;
+}
+
+const std::string &UndoJournal::GetRedoLabel() const
+{
+    static const std::string empty;
+    return cursor < count ? GetEntry(cursor).label : empty;
+}
+
+void UndoJournal::Clear()
+{
+    while (count > 0)
+    {
+        EvictOldest();
+    }
+    head = 0;
+}
+
+size_t UndoJournal::GetMemoryUsage() const
+{
+    return memoryUsage;
+}
+
+size_t UndoJournal::Entry::GetMemoryUsage() const
+{
+    return label.capacity() + deltas.capacity() * sizeof(Delta) + data.capacity();
+}
+
+UndoJournal::Entry &UndoJournal::GetEntry(size_t index)
+{
+    return slots[(head + index) % slots.size()];
+}
+
+const UndoJournal::Entry &UndoJournal::GetEntry(size_t index) const
+{
+    return slots[(head + index) % slots.size()];
+}
+
+void UndoJournal::Push(Entry &&entry)
+{
+    // A new edit discards everything that could have been redone
+    while (count > cursor)
+    {
+        Entry &dropped = GetEntry(count - 1);
+        memoryUsage -= dropped.GetMemoryUsage();
+        dropped = Entry();
+        count--;
+    }
+
+    // Make room, an entry larger than the whole budget is still kept on its own
+    size_t entrySize = entry.GetMemoryUsage();
+    while (count > 0 && (count == slots.size() || memoryUsage + entrySize > memoryBudget))
+    {
+        EvictOldest();
+    }
+
+    Entry &slot = GetEntry(count);
+    slot = std::move(entry);
+    memoryUsage += slot.GetMemoryUsage();
+    count++;
+    cursor = count;
+}
+
+void UndoJournal::EvictOldest()
+{
+    Entry &oldest = GetEntry(0);
+    memoryUsage -= oldest.GetMemoryUsage();
+    oldest = Entry();
+
+    head = (head + 1) % slots.size();
+    count--;
+    if (cursor > 0)
+        cursor--;
+}
+
+void UndoJournal::Apply(const Entry &entry, bool undo)
+{
+    // Undo walks the deltas backwards so the edit is unwound in reverse
+    size_t deltaCount = entry.deltas.size();
+    for (size_t i = 0; i < deltaCount; i++)
+    {
+        const Delta &delta = entry.deltas[undo ? deltaCount - 1 - i : i];
+        Node *node = Node::FindByInstanceId(delta.nodeId);
+        if (!node)
+            continue;
+
+        const uint8_t *value = entry.data.data() + delta.offset;
+        if (undo)
+            node->SetProperty(delta.property, value, delta.oldSize);
+        else
+            node->SetProperty(delta.property, value + delta.oldSize, delta.newSize);
+    }
+}
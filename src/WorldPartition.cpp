@@ -0,0 +1,446 @@
+#include "WorldPartition.h"
+#include "Node.h"
+#include "../nodes/Node2D/Node2D.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    // Built nodes take several times the space of their records, strings and payloads on disk
+    const size_t BuiltBytesPerFileByte = 4;
+
+    // Nodes built between two checks of the frame budget
+    const uint32_t BuildBatchSize = 256;
+
+    std::string GetCellPath(const std::string &directory, int32_t x, int32_t y)
+    {
+        return directory + "/cell_" + std::to_string(x) + "_" + std::to_string(y) + ".scn";
+    }
+
+    bool ParseCellName(const std::string &fileName, int32_t &outX, int32_t &outY)
+    {
+        int x, y;
+        char end;
+        if (std::sscanf(fileName.c_str(), "cell_%d_%d.sc%c", &x, &y, &end) != 3 || end != 'n' ||
+            fileName != "cell_" + std::to_string(x) + "_" + std::to_string(y) + ".scn")
+            return false;
+
+        outX = x;
+        outY = y;
+        return true;
+    }
+}
+
+WorldPartition::WorldPartition()
+{
+}
+
+WorldPartition::~WorldPartition()
+{
+    Close();
+
+    if (worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        readRequested.notify_all();
+        worker.join();
+    }
+}
+
+uint64_t WorldPartition::PackCell(int32_t x, int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+bool WorldPartition::Export(const Node *root, const std::string &directory, float cellSize)
+{
+    if (!root || cellSize <= 0.0f)
+        return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "Failed to create world directory: " << directory << std::endl;
+        return false;
+    }
+
+    // Cells left over from an earlier export would come back as duplicate nodes
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        int32_t x, y;
+        if (ParseCellName(entry.path().filename().string(), x, y))
+        {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+
+    // Group the top-level nodes by the cell their origin falls in
+    std::unordered_map<uint64_t, std::vector<std::shared_ptr<Node>>> cellNodes;
+    for (const auto &child : root->children)
+    {
+        int32_t x = static_cast<int32_t>(std::floor(child->transform.position[0] / cellSize));
+        int32_t y = static_cast<int32_t>(std::floor(child->transform.position[1] / cellSize));
+        cellNodes[PackCell(x, y)].push_back(child);
+    }
+
+    for (auto &cell : cellNodes)
+    {
+        int32_t x = static_cast<int32_t>(cell.first >> 32);
+        int32_t y = static_cast<int32_t>(cell.first & 0xFFFFFFFFu);
+
+        // The cell root only borrows the nodes for writing, they stay attached to their real parent
+        std::shared_ptr<Node2D> cellRoot = std::make_shared<Node2D>("Cell " + std::to_string(x) + " " + std::to_string(y));
+        cellRoot->children = std::move(cell.second);
+        bool saved = SceneFile::Save(cellRoot.get(), GetCellPath(directory, x, y));
+        cellRoot->children.clear();
+        if (!saved)
+        {
+            std::cerr << "Failed to write world cell: " << GetCellPath(directory, x, y) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WorldPartition::Open(const std::string &directory, const Settings &settings)
+{
+    Close();
+
+    std::error_code error;
+    std::filesystem::directory_iterator entries(directory, error);
+    if (error)
+    {
+        std::cerr << "Failed to open world directory: " << directory << std::endl;
+        return false;
+    }
+
+    for (const auto &entry : entries)
+    {
+        int32_t x, y;
+        if (!ParseCellName(entry.path().filename().string(), x, y))
+            continue;
+
+        std::unique_ptr<Cell> cell = std::make_unique<Cell>();
+        cell->x = x;
+        cell->y = y;
+        cell->path = entry.path().string();
+        cell->memory = static_cast<size_t>(entry.file_size(error)) * BuiltBytesPerFileByte;
+        cells[PackCell(x, y)] = std::move(cell);
+    }
+
+    this->directory = directory;
+    this->settings = settings;
+    this->settings.unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+
+    if (!worker.joinable())
+    {
+        worker = std::thread(&WorldPartition::ReadCells, this);
+    }
+    return true;
+}
+
+void WorldPartition::Close()
+{
+    // Let an in-flight read finish, nothing queued is needed any more
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        readQueue.clear();
+        readFinished.wait(lock, [this]
+                          { return currentRead == nullptr; });
+    }
+
+    for (auto &entry : cells)
+    {
+        Cell &cell = *entry.second;
+        if (cell.root && cell.root->parent)
+        {
+            cell.root->parent->RemoveChild(cell.root);
+        }
+    }
+
+    cells.clear();
+    retiredRoots.clear();
+    directory.clear();
+    memoryUsage = 0;
+    loadedCellCount = 0;
+    streaming = false;
+}
+
+bool WorldPartition::IsOpen() const
+{
+    return !directory.empty();
+}
+
+float WorldPartition::GetDistance(const Cell &cell, float focusX, float focusY) const
+{
+    // Distance from the focus to the nearest point of the cell
+    float minX = cell.x * settings.cellSize;
+    float minY = cell.y * settings.cellSize;
+    float dx = std::max({minX - focusX, 0.0f, focusX - (minX + settings.cellSize)});
+    float dy = std::max({minY - focusY, 0.0f, focusY - (minY + settings.cellSize)});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void WorldPartition::Update(Node *worldRoot, float focusX, float focusY)
+{
+    if (!IsOpen() || !worldRoot)
+        return;
+
+    const auto frameStart = std::chrono::steady_clock::now();
+    auto budgetLeft = [&]()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count() < settings.frameBudgetMs;
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Drop cells past the unload radius, and give back what failed reads had reserved
+    for (auto &entry : cells)
+    {
+        Cell &cell = *entry.second;
+        if (cell.state == CellState::Failed && cell.memory > 0)
+        {
+            memoryUsage -= cell.memory;
+            cell.memory = 0;
+            cell.image = std::vector<uint8_t>();
+        }
+        else if (cell.state != CellState::Unloaded && cell.state != CellState::Failed &&
+                 GetDistance(cell, focusX, focusY) > settings.unloadRadius)
+        {
+            Unload(worldRoot, cell);
+        }
+    }
+
+    // Request the missing cells inside the load radius, nearest first
+    wantedCells.clear();
+    const int32_t minX = static_cast<int32_t>(std::floor((focusX - settings.loadRadius) / settings.cellSize));
+    const int32_t maxX = static_cast<int32_t>(std::floor((focusX + settings.loadRadius) / settings.cellSize));
+    const int32_t minY = static_cast<int32_t>(std::floor((focusY - settings.loadRadius) / settings.cellSize));
+    const int32_t maxY = static_cast<int32_t>(std::floor((focusY + settings.loadRadius) / settings.cellSize));
+    for (int32_t y = minY; y <= maxY; y++)
+    {
+        for (int32_t x = minX; x <= maxX; x++)
+        {
+            auto it = cells.find(PackCell(x, y));
+            if (it != cells.end() && it->second->state == CellState::Unloaded &&
+                GetDistance(*it->second, focusX, focusY) <= settings.loadRadius)
+            {
+                wantedCells.push_back(it->second.get());
+            }
+        }
+    }
+    std::sort(wantedCells.begin(), wantedCells.end(), [&](const Cell *a, const Cell *b)
+              { return GetDistance(*a, focusX, focusY) < GetDistance(*b, focusX, focusY); });
+
+    for (Cell *cell : wantedCells)
+    {
+        // Make room by dropping the farthest cells that are only kept by the hysteresis
+        while (memoryUsage + cell->memory > settings.memoryBudget)
+        {
+            Cell *farthest = nullptr;
+            float farthestDistance = settings.loadRadius;
+            for (auto &entry : cells)
+            {
+                Cell &candidate = *entry.second;
+                float distance = GetDistance(candidate, focusX, focusY);
+                if ((candidate.state == CellState::Loaded || candidate.state == CellState::Building || candidate.state == CellState::Read) &&
+                    distance > farthestDistance)
+                {
+                    farthest = &candidate;
+                    farthestDistance = distance;
+                }
+            }
+            if (!farthest)
+                break;
+            Unload(worldRoot, *farthest);
+        }
+
+        // Over budget with only needed cells loaded, the rest waits until the focus moves
+        if (memoryUsage + cell->memory > settings.memoryBudget)
+            break;
+
+        memoryUsage += cell->memory;
+        cell->state = CellState::Reading;
+        readQueue.push_back(cell);
+    }
+    if (!readQueue.empty())
+    {
+        readRequested.notify_one();
+    }
+
+    // Cells the worker has finished are built nearest first
+    buildingCells.clear();
+    for (auto &entry : cells)
+    {
+        if (entry.second->state == CellState::Read || entry.second->state == CellState::Building)
+        {
+            buildingCells.push_back(entry.second.get());
+        }
+    }
+    lock.unlock();
+
+    std::sort(buildingCells.begin(), buildingCells.end(), [&](const Cell *a, const Cell *b)
+              { return GetDistance(*a, focusX, focusY) < GetDistance(*b, focusX, focusY); });
+
+    for (Cell *cell : buildingCells)
+    {
+        cell->state = CellState::Building;
+        while (!cell->loader.IsComplete() && budgetLeft())
+        {
+            if (!cell->loader.Build(BuildBatchSize))
+            {
+                std::cerr << "Failed to build world cell: " << cell->path << std::endl;
+                lock.lock();
+                Unload(worldRoot, *cell);
+                cell->memory = 0;
+                cell->state = CellState::Failed;
+                lock.unlock();
+                break;
+            }
+
+            // The root goes in first, every later batch then lands straight in the live tree
+            if (!cell->root)
+            {
+                cell->root = cell->loader.GetRoot();
+                worldRoot->AddChild(cell->root);
+            }
+        }
+
+        if (cell->state == CellState::Building && cell->loader.IsComplete())
+        {
+            cell->loader = SceneFile::Loader();
+            cell->image = std::vector<uint8_t>();
+            cell->state = CellState::Loaded;
+            loadedCellCount++;
+        }
+
+        if (!budgetLeft())
+            break;
+    }
+
+    // Destroy dropped cells a top-level node at a time
+    while (!retiredRoots.empty() && budgetLeft())
+    {
+        std::shared_ptr<Node> &root = retiredRoots.back();
+        if (root->children.empty())
+        {
+            retiredRoots.pop_back();
+            continue;
+        }
+
+        // Detached first, so anything still holding the node doesn't point into a destroyed parent
+        std::shared_ptr<Node> child = std::move(root->children.back());
+        root->children.pop_back();
+        child->parent = nullptr;
+    }
+
+    lock.lock();
+    streaming = !readQueue.empty() || currentRead || !retiredRoots.empty();
+    for (auto &entry : cells)
+    {
+        CellState state = entry.second->state;
+        streaming = streaming || state == CellState::Read || state == CellState::Building;
+    }
+}
+
+void WorldPartition::Unload(Node *worldRoot, Cell &cell)
+{
+    // A cell the worker is still reading is dropped once the read completes
+    if (cell.state == CellState::Reading)
+    {
+        if (&cell == currentRead)
+            return;
+        readQueue.erase(std::remove(readQueue.begin(), readQueue.end(), &cell), readQueue.end());
+    }
+
+    if (cell.root)
+    {
+        worldRoot->RemoveChild(cell.root);
+        retiredRoots.push_back(std::move(cell.root));
+        cell.root.reset();
+    }
+
+    if (cell.state == CellState::Loaded)
+    {
+        loadedCellCount--;
+    }
+
+    cell.loader = SceneFile::Loader();
+    cell.image = std::vector<uint8_t>();
+    memoryUsage -= cell.memory;
+    cell.state = CellState::Unloaded;
+}
+
+void WorldPartition::ReadCells()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        readRequested.wait(lock, [this]
+                           { return stopping || !readQueue.empty(); });
+        if (stopping)
+            return;
+
+        Cell *cell = readQueue.front();
+        readQueue.pop_front();
+        currentRead = cell;
+        const std::string path = cell->path;
+        lock.unlock();
+
+        // Read and check the whole image here so the main thread only has to build nodes
+        std::vector<uint8_t> image;
+        SceneFile::Loader loader;
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        bool ok = file.is_open();
+        if (ok)
+        {
+            image.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            ok = static_cast<bool>(file.read(reinterpret_cast<char *>(image.data()), static_cast<std::streamsize>(image.size())));
+        }
+        if (!ok)
+        {
+            std::cerr << "Failed to read world cell: " << path << std::endl;
+        }
+        ok = ok && loader.Open(image.data(), image.size(), path);
+
+        lock.lock();
+
+        // Moving the vector keeps its buffer, so the loader's views stay valid
+        cell->image = std::move(image);
+        cell->loader = std::move(loader);
+        cell->state = ok ? CellState::Read : CellState::Failed;
+        currentRead = nullptr;
+        readFinished.notify_all();
+    }
+}
+
+bool WorldPartition::IsStreaming() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return streaming;
+}
+
+size_t WorldPartition::GetCellCount() const
+{
+    return cells.size();
+}
+
+size_t WorldPartition::GetLoadedCellCount() const
+{
+    return loadedCellCount;
+}
+
+size_t WorldPartition::GetMemoryUsage() const
+{
+    return memoryUsage;
+}
@@ -1,12 +1,49 @@
 #include "Engine.h"
+#include "TextSceneFile.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
 
-int main()
+int main(int argc, char **argv)
 {
     Engine engine;
+
+    // Frame pacing is chosen per run: --pacing=editor|game|benchmark and --fps=<target>
+    FramePacer::Mode pacingMode = FramePacer::Mode::Editor;
+    double targetFrameRate = 60.0;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        // --convert-scene <scene.json> <scene.scn> cooks a text scene into the binary format and exits
+        if (argument == "--convert-scene")
+        {
+            if (i + 2 >= argc)
+            {
+                std::cerr << "Usage: --convert-scene <text scene> <binary scene>" << std::endl;
+                return -1;
+            }
+            return TextSceneFile::ConvertToBinary(argv[i + 1], argv[i + 2]) ? 0 : -1;
+        }
+        else if (argument.rfind("--pacing=", 0) == 0)
+        {
+            if (!FramePacer::ParseMode(argument.substr(9), pacingMode))
+            {
+                std::cerr << "Unknown pacing mode: " << argument.substr(9) << std::endl;
+                return -1;
+            }
+        }
+        else if (argument.rfind("--fps=", 0) == 0)
+        {
+            targetFrameRate = std::atof(argument.c_str() + 6);
+        }
+    }
+    engine.SetFramePacing(pacingMode, targetFrameRate);
+
     if (!engine.Init())
     {
         return -1;
     }
     engine.Run();
     return 0;
-}
\ No newline at end of file
+}
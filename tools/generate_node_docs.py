@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+"""Generates the node documentation tables from the doc comments in the node headers.
+
+    generate_node_docs.py OUTPUT HEADER...
+
+A node class and each method it documents carry a /** */ block:
+
+    /**
+     * @brief One line summary
+     *
+     * Paragraph shown as the node's description in the documentation browser.
+     */
+    class Sprite : public Node2D
+    {
+        /**
+         * Sets the color tint of the sprite.
+         * @param r Red component (0.0 to 1.0)
+         * @return What the method returns, "None" if left out
+         * @example sprite->SetColor(1.0f, 0.5f, 0.5f);
+         */
+        void SetColor(float r, float g, float b, float a = 1.0f);
+
+The method name, return type and parameter names come from the declaration,
+so they can't drift from the code, and a @param naming a parameter the
+declaration doesn't have fails the build. Description and @param text may
+wrap onto further lines, @example keeps its lines as they are.
+
+Only classes deriving from Node are documented, a ReflectedNode<Class, Base>
+base counts as Base. The output is a header of
+constexpr tables, included by src/NodeDocumentation.cpp.
+"""
+
+import os
+import re
+import sys
+
+
+class DocError(Exception):
+    pass
+
+
+def parse_comment(lines):
+    """Splits the lines of a /** */ block into description paragraphs and tags."""
+    paragraphs = [[]]
+    tags = []
+    in_tag = False
+    for line in lines:
+        line = re.sub(r'^\s*/\*\*', '', line)
+        line = re.sub(r'\*/\s*$', '', line)
+        line = re.sub(r'^\s*\* ?', '', line).rstrip()
+
+        # A blank line ends a tag's text, except in examples
+        tag = re.match(r'@(\w+)\s*(.*)$', line)
+        if tag:
+            tags.append([tag.group(1), [tag.group(2)] if tag.group(2) else []])
+            in_tag = True
+        elif in_tag and (line.strip() or tags[-1][0] == 'example'):
+            tags[-1][1].append(line)
+        elif line.strip():
+            paragraphs[-1].append(line.strip())
+        else:
+            in_tag = False
+            if paragraphs[-1]:
+                paragraphs.append([])
+
+    paragraphs = [' '.join(paragraph) for paragraph in paragraphs if paragraph]
+    return paragraphs, tags
+
+
+def join_tag(name, lines):
+    # Examples are code and keep their lines, everything else is prose
+    if name == 'example':
+        while lines and not lines[-1].strip():
+            lines.pop()
+        return '\n'.join(lines)
+    return ' '.join(line.strip() for line in lines if line.strip())
+
+
+def split_top_level(text):
+    parts = []
+    depth = 0
+    current = ''
+    for c in text:
+        if c in '<([{':
+            depth += 1
+        elif c in '>)]}':
+            depth -= 1
+        if c == ',' and depth == 0:
+            parts.append(current)
+            current = ''
+        else:
+            current += c
+    if current.strip():
+        parts.append(current)
+    return parts
+
+
+def parse_declaration(declaration, location):
+    """Returns (name, return type, parameter names) of a method declaration."""
+    match = re.match(r'\s*(.*?)\b(\w+)\s*\((.*)\)[^()]*$', declaration, re.S)
+    if not match:
+        raise DocError('%s: documented declaration is not a method: %s' % (location, declaration.strip()))
+
+    qualifiers = r'\b(virtual|static|inline|explicit|constexpr)\b'
+    return_type = ' '.join(re.sub(qualifiers, '', match.group(1)).split()) or 'void'
+
+    params = []
+    for param in split_top_level(match.group(3)):
+        param = re.sub(r'\[[^\]]*\]', '', param.split('=')[0]).strip()
+        if param == 'void':
+            continue
+        names = re.findall(r'\w+', param)
+        if not names:
+            raise DocError('%s: unnamed parameter in %s' % (location, declaration.strip()))
+        params.append(names[-1])
+    return match.group(2), return_type, params
+
+
+def parse_method(comment, declaration, location):
+    paragraphs, tags = parse_comment(comment)
+    name, return_type, param_names = parse_declaration(declaration, location)
+
+    method = {
+        'name': name,
+        'description': ' '.join(paragraphs),
+        'returnType': return_type,
+        'returnDesc': 'None',
+        'params': [],
+        'example': '',
+    }
+
+    param_docs = {}
+    for tag, lines in tags:
+        text = join_tag(tag, lines)
+        if tag == 'param':
+            param_name, _, param_text = text.partition(' ')
+            if param_name not in param_names:
+                raise DocError('%s: %s has no parameter "%s"' % (location, name, param_name))
+            param_docs[param_name] = param_text.strip()
+        elif tag == 'return':
+            method['returnDesc'] = text
+        elif tag == 'example':
+            method['example'] = text
+        else:
+            raise DocError('%s: unknown tag @%s on %s' % (location, tag, name))
+
+    for param_name in param_names:
+        if param_name not in param_docs:
+            raise DocError('%s: parameter "%s" of %s is not documented' % (location, param_name, name))
+        method['params'].append((param_name, param_docs[param_name]))
+    return method
+
+
+def parse_class_comment(comment):
+    # The first paragraph describes the node, falling back to the brief
+    paragraphs, tags = parse_comment(comment)
+    brief = ''.join(join_tag(tag, lines) for tag, lines in tags if tag == 'brief')
+    description = paragraphs[0] if paragraphs else brief
+    if description and description[-1] not in '.!?':
+        description += '.'
+    return description
+
+
+def parse_header(path, classes):
+    with open(path, encoding='utf-8') as header:
+        lines = header.read().split('\n')
+
+    comment = None
+    current = None
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        stripped = line.strip()
+
+        if stripped.startswith('/**'):
+            start = i
+            while '*/' not in lines[i]:
+                i += 1
+            comment = lines[start:i + 1]
+            i += 1
+            continue
+
+        definition = re.match(r'class\s+(\w+)\s*(?::\s*(.*))?$', stripped)
+        if definition and not stripped.endswith(';'):
+            # ReflectedNode<Class, Base> only implements the property interface, the class derives from Base
+            base_list = re.sub(r'ReflectedNode\s*<\s*\w+\s*,\s*(\w+)\s*>', r'\1', definition.group(2) or '')
+            bases = re.findall(r'(?:public|protected|private)?\s*(\w+)', base_list)
+            current = {
+                'name': definition.group(1),
+                'bases': bases,
+                'description': parse_class_comment(comment) if comment else '',
+                'methods': [],
+            }
+            classes[current['name']] = current
+            comment = None
+        elif line.startswith('};'):
+            current = None
+        elif comment and current and stripped and not stripped.startswith('//'):
+            # The declaration can span lines, it ends at its semicolon or body
+            start = i
+            while not re.search(r'[;{]\s*$', lines[i]):
+                i += 1
+            declaration = ' '.join(lines[start:i + 1])
+            declaration = re.sub(r'\s*(;|\{.*)\s*$', '', declaration)
+            declaration = re.sub(r'\)(\s*(const|override|final|noexcept|= *0))*\s*$', ')', declaration)
+            location = '%s:%d' % (path, start + 1)
+            current['methods'].append(parse_method(comment, declaration, location))
+            comment = None
+        elif stripped and not stripped.startswith('//'):
+            comment = None
+        i += 1
+
+
+def derives_from_node(name, classes):
+    while name in classes:
+        if name == 'Node':
+            return True
+        bases = classes[name]['bases']
+        name = bases[0] if bases else None
+    return False
+
+
+def cpp_string(text):
+    out = '"'
+    for byte in text.encode('utf-8'):
+        c = chr(byte)
+        if c == '\\':
+            out += '\\\\'
+        elif c == '"':
+            out += '\\"'
+        elif c == '\n':
+            out += '\\n'
+        elif 32 <= byte < 127:
+            out += c
+        else:
+            out += '\\%03o' % byte
+    return out + '"'
+
+
+def generate(classes):
+    nodes = sorted((c for c in classes.values() if derives_from_node(c['name'], classes) and c['methods']),
+                   key=lambda c: c['name'].encode('utf-8'))
+
+    out = ['// Generated by tools/generate_node_docs.py from the doc comments in the node headers, do not edit',
+           '#pragma once',
+           '',
+           '#include "NodeDocumentation.h"',
+           '',
+           'namespace NodeDocumentationTables',
+           '{']
+
+    for node in nodes:
+        for index, method in enumerate(node['methods']):
+            if method['params']:
+                out.append('    constexpr ParamDoc %sParams%d[] = {' % (node['name'], index))
+                for param_name, param_text in method['params']:
+                    out.append('        {%s, %s},' % (cpp_string(param_name), cpp_string(param_text)))
+                out.append('    };')
+        out.append('    constexpr MethodDoc %sMethods[] = {' % node['name'])
+        for index, method in enumerate(node['methods']):
+            params = '{%sParams%d, %d}' % (node['name'], index, len(method['params'])) if method['params'] else '{nullptr, 0}'
+            out.append('        {%s, %s, %s, %s, %s, %s},' % (
+                cpp_string(method['name']), cpp_string(method['description']), cpp_string(method['returnType']),
+                cpp_string(method['returnDesc']), params, cpp_string(method['example'])))
+        out.append('    };')
+        out.append('')
+
+    out.append('    // Sorted by node type name')
+    out.append('    constexpr NodeDoc Nodes[] = {')
+    for node in nodes:
+        out.append('        {%s, %s, {%sMethods, %d}},' % (cpp_string(node['name']), cpp_string(node['description']),
+                                                         node['name'], len(node['methods'])))
+    out.append('    };')
+    out.append('}')
+    return '\n'.join(out) + '\n'
+
+
+def main(argv):
+    if len(argv) < 3:
+        sys.stderr.write('usage: generate_node_docs.py OUTPUT HEADER...\n')
+        return 1
+
+    classes = {}
+    try:
+        for path in argv[2:]:
+            parse_header(path, classes)
+    except DocError as error:
+        sys.stderr.write('error: %s\n' % error)
+        return 1
+
+    output = generate(classes)
+    directory = os.path.dirname(argv[1])
+    if directory and not os.path.isdir(directory):
+        os.makedirs(directory)
+    with open(argv[1], 'w', encoding='utf-8') as target:
+        target.write(output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))